@@ -65,7 +65,15 @@ typedef unsigned char kciaa_semaphore;
 /** \brief Initialize the CIAA Firmware */
 void ciaak_start(void);
 
-/** \brief Kernel malloc */
+/** \brief Kernel malloc
+ **
+ ** Until the end of ciaak_start the memory is taken from a boot arena and
+ ** shall never be freed. Later allocations are taken from the heap.
+ **
+ ** \param[in] size number of bytes to allocate
+ ** \return pointer to the allocated memory, this function does not return
+ **         if no memory is available
+ **/
 void *ciaak_malloc(size_t size);
 
 /*==================[cplusplus]==============================================*/
@@ -53,14 +53,62 @@
 #include "ciaaDriverDio.h"
 
 #include "ciaaPOSIX_stdlib.h"
+#include "ciaaPOSIX_stdbool.h"
 
 /*==================[macros and definitions]=================================*/
+#ifndef CIAAK_SERIAL_DEVICES
+#if (x86 == ARCH)
+/** \brief count of serial devices registered by the board, 2 uarts and
+ ** 2 aio devices */
+#define CIAAK_SERIAL_DEVICES 4
+#elif ((cortexM4 == ARCH) && (lpc4337 == CPU))
+/** \brief count of serial devices registered by the board, 3 uarts and
+ ** 3 aio devices */
+#define CIAAK_SERIAL_DEVICES 6
+#else
+/** \brief count of serial devices registered by the board */
+#define CIAAK_SERIAL_DEVICES 0
+#endif
+#endif
+
+/** \brief bytes of the boot arena taken by each serial device
+ **
+ ** 2 buffers of 256 bytes plus its device structure, its device node and
+ ** its name.
+ **/
+#define CIAAK_ARENA_DEVICE_SIZE (2 * 256 + 128)
+
+#ifndef CIAAK_ARENA_SIZE
+/** \brief size of the boot arena in bytes
+ **
+ ** May be set to 0 to take all the kernel memory from the heap.
+ **/
+#define CIAAK_ARENA_SIZE (CIAAK_SERIAL_DEVICES * CIAAK_ARENA_DEVICE_SIZE)
+#endif
+
+/** \brief alignment of the arena allocations */
+#define CIAAK_ARENA_ALIGN (sizeof(uint64_t))
 
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
+#if (0 < CIAAK_ARENA_SIZE)
+/** \brief boot arena
+ **
+ ** The memory allocated by the kernel during the initialization is never
+ ** freed, it is taken linearly from this arena without any header.
+ **/
+static uint64_t ciaak_arena[CIAAK_ARENA_SIZE / sizeof(uint64_t)];
+
+/** \brief count of bytes of the boot arena already allocated */
+static size_t ciaak_arenaUsed = 0;
+
+/** \brief indicates that the initialization is over and the boot arena is
+ ** sealed */
+static bool ciaak_arenaSealed = false;
+#endif
 
 /*==================[external data definition]===============================*/
 
@@ -89,17 +137,47 @@ void ciaak_start(void)
    ciaaDriverDio_init();
 
    ciaaDriverAio_init();
+
+#if (0 < CIAAK_ARENA_SIZE)
+   /* the later allocations are taken from the heap */
+   ciaak_arenaSealed = true;
+#endif
 }
 
 void *ciaak_malloc(size_t size)
 {
-   /* try to alloc memory */
-   void* ret = ciaaPOSIX_malloc(size);
+   void* ret = NULL;
+   ciaaPOSIX_stdlib_statsType stats;
+
+#if (0 < CIAAK_ARENA_SIZE)
+   /* ciaak_start is executed before any other task, the boot arena is
+    * used without critical section */
+   if ((false == ciaak_arenaSealed) &&
+         (size <= (sizeof(ciaak_arena) - ciaak_arenaUsed)))
+   {
+      ret = (void *)((uint8_t *)ciaak_arena + ciaak_arenaUsed);
+      ciaak_arenaUsed += (size + CIAAK_ARENA_ALIGN - 1) &
+         ~(CIAAK_ARENA_ALIGN - 1);
+      if (ciaak_arenaUsed > sizeof(ciaak_arena))
+      {
+         ciaak_arenaUsed = sizeof(ciaak_arena);
+      }
+   }
+   else
+#endif
+   {
+      /* try to alloc memory */
+      ret = ciaaPOSIX_malloc(size);
+   }
 
    /* kernel memory shall not failed :( */
    if (NULL == ret)
    {
+      ciaaPOSIX_stdlib_getStats(&stats);
       ciaaPOSIX_printf("Kernel out of memory :( ...\n");
+      ciaaPOSIX_printf("requested: %lu in use: %lu peak: %lu largest free: %lu\n",
+            (unsigned long)size, (unsigned long)stats.used,
+            (unsigned long)stats.peak, (unsigned long)stats.largestFree);
       while(1)
       {
          /* TODO perform an kernel panic or like */
@@ -49,6 +49,7 @@
 
 /*==================[inclusions]=============================================*/
 #include "ciaaDriverFlash.h"
+#include "ciaaPOSIX_ioctl_block.h"
 
 /*==================[macros and definitions]=================================*/
 
@@ -77,6 +78,18 @@ extern int32_t ciaaDriverFlash_ioctl(ciaaDevices_deviceType const * const device
 {
    int32_t ret = -1;
 
+   switch(request)
+   {
+      case ciaaPOSIX_IOCTL_BLOCK_CANCEL:
+         /* read and write are completed synchronously, there is no
+          * pending transfer to be cancelled */
+         ret = 0;
+         break;
+
+      default:
+         break;
+   }
+
    return ret;
 }
 
@@ -235,6 +235,13 @@ extern int32_t ciaaDriverFlash_ioctl(ciaaDevices_deviceType const * const device
             ciaaDriverFlash_blockErase((uint32_t) (flash->position/CIAADRVFLASH_BLOCK_SIZE), (uint32_t) (flash->position/CIAADRVFLASH_BLOCK_SIZE));
             ret = 1;
             break;
+
+         case ciaaPOSIX_IOCTL_BLOCK_CANCEL:
+            /* read and write are completed synchronously, there is no
+             * pending transfer to be cancelled */
+            ret = 0;
+            break;
+
          default:
             break;
       }
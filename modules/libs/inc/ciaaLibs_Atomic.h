@@ -0,0 +1,254 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ * All rights reserved.
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef CIAALIBS_ATOMIC_H
+#define CIAALIBS_ATOMIC_H
+/** \brief Atomic Library header
+ **
+ ** This library provides atomic accesses and memory barriers to share data
+ ** between tasks, ISRs and cores without entering a critical section.
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup Libs CIAA Libraries
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "ciaaPOSIX_stdint.h"
+#include "ciaaPOSIX_stdbool.h"
+
+/*==================[cplusplus]==============================================*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================[macros]=================================================*/
+#if (!defined(__GNUC__))
+#error ciaaLibs_Atomic is only supported for gcc based compilers
+#endif
+
+/** \brief read a variable with acquire semantic
+ **
+ ** Reads the variable pointed by ptr. Loads and stores performed after this
+ ** read can not be moved before it, so all data published by the writer
+ ** before updating this variable can be safely accessed afterwards.
+ **
+ ** \param[in] ptr pointer to the variable to be read
+ ** \return the read value
+ **/
+#define ciaaLibs_atomicLoadAcquire(ptr)            \
+   __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+
+/** \brief write a variable with release semantic
+ **
+ ** Writes val to the variable pointed by ptr. Loads and stores performed
+ ** before this write can not be moved after it, so all data written before
+ ** is visible to a reader which reads this variable with
+ ** ciaaLibs_atomicLoadAcquire.
+ **
+ ** \param[out] ptr pointer to the variable to be written
+ ** \param[in] val value to be written
+ **/
+#define ciaaLibs_atomicStoreRelease(ptr, val)      \
+   __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+
+/** \brief full memory barrier
+ **
+ ** No load nor store can be moved by the compiler or the cpu across this
+ ** barrier (dmb in ARM, mfence in x86 and sync in mips).
+ **/
+#define ciaaLibs_memoryBarrier()                   \
+   __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#if (cortexM0 == ARCH)
+/* ARMv6-M does not provide exclusive load and store instructions, the read
+ * modify write operations are performed with the interrupts disabled */
+
+/** \brief compare and swap
+ **
+ ** If the variable pointed by ptr is equal to *expected it is set to
+ ** desired, in other case the current value is stored in *expected.
+ **
+ ** \param[inout] ptr pointer to the variable to be updated
+ ** \param[inout] expected pointer to the expected value
+ ** \param[in] desired value to be written
+ ** \return true if the variable has been updated, false in other case
+ **/
+#define ciaaLibs_atomicCas(ptr, expected, desired)                   \
+   ({                                                                \
+      uint32_t ciaaLibs_primask = ciaaLibs_atomicEnter();            \
+      bool ciaaLibs_ret = (*(ptr) == *(expected));                   \
+      if (ciaaLibs_ret) {                                            \
+         *(ptr) = (desired);                                         \
+      } else {                                                       \
+         *(expected) = *(ptr);                                       \
+      }                                                              \
+      ciaaLibs_atomicExit(ciaaLibs_primask);                         \
+      ciaaLibs_ret;                                                  \
+   })
+
+/** \brief add a value and return the result
+ **
+ ** \param[inout] ptr pointer to the variable to be updated
+ ** \param[in] val value to be added
+ ** \return the new value of the variable
+ **/
+#define ciaaLibs_atomicAdd(ptr, val)                                 \
+   ({                                                                \
+      uint32_t ciaaLibs_primask = ciaaLibs_atomicEnter();            \
+      __typeof__(*(ptr)) ciaaLibs_ret = (*(ptr) += (val));           \
+      ciaaLibs_atomicExit(ciaaLibs_primask);                         \
+      ciaaLibs_ret;                                                  \
+   })
+
+/** \brief and a value and return the previous value
+ **
+ ** \param[inout] ptr pointer to the variable to be updated
+ ** \param[in] val value to and the variable with
+ ** \return the value of the variable before the update
+ **/
+#define ciaaLibs_atomicFetchAnd(ptr, val)                            \
+   ({                                                                \
+      uint32_t ciaaLibs_primask = ciaaLibs_atomicEnter();            \
+      __typeof__(*(ptr)) ciaaLibs_ret = *(ptr);                      \
+      *(ptr) = ciaaLibs_ret & (val);                                 \
+      ciaaLibs_atomicExit(ciaaLibs_primask);                         \
+      ciaaLibs_ret;                                                  \
+   })
+
+/** \brief or a value and return the previous value
+ **
+ ** \param[inout] ptr pointer to the variable to be updated
+ ** \param[in] val value to or the variable with
+ ** \return the value of the variable before the update
+ **/
+#define ciaaLibs_atomicFetchOr(ptr, val)                             \
+   ({                                                                \
+      uint32_t ciaaLibs_primask = ciaaLibs_atomicEnter();            \
+      __typeof__(*(ptr)) ciaaLibs_ret = *(ptr);                      \
+      *(ptr) = ciaaLibs_ret | (val);                                 \
+      ciaaLibs_atomicExit(ciaaLibs_primask);                         \
+      ciaaLibs_ret;                                                  \
+   })
+#else
+/** \brief compare and swap
+ **
+ ** If the variable pointed by ptr is equal to *expected it is set to
+ ** desired, in other case the current value is stored in *expected.
+ **
+ ** \param[inout] ptr pointer to the variable to be updated
+ ** \param[inout] expected pointer to the expected value
+ ** \param[in] desired value to be written
+ ** \return true if the variable has been updated, false in other case
+ **/
+#define ciaaLibs_atomicCas(ptr, expected, desired)                   \
+   __atomic_compare_exchange_n((ptr), (expected), (desired), false,  \
+         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+
+/** \brief add a value and return the result
+ **
+ ** \param[inout] ptr pointer to the variable to be updated
+ ** \param[in] val value to be added
+ ** \return the new value of the variable
+ **/
+#define ciaaLibs_atomicAdd(ptr, val)                                 \
+   __atomic_add_fetch((ptr), (val), __ATOMIC_ACQ_REL)
+
+/** \brief and a value and return the previous value
+ **
+ ** Sequentially consistent, a load performed after it can not be moved
+ ** before it.
+ **
+ ** \param[inout] ptr pointer to the variable to be updated
+ ** \param[in] val value to and the variable with
+ ** \return the value of the variable before the update
+ **/
+#define ciaaLibs_atomicFetchAnd(ptr, val)                            \
+   __atomic_fetch_and((ptr), (val), __ATOMIC_SEQ_CST)
+
+/** \brief or a value and return the previous value
+ **
+ ** Sequentially consistent, a load performed after it can not be moved
+ ** before it.
+ **
+ ** \param[inout] ptr pointer to the variable to be updated
+ ** \param[in] val value to or the variable with
+ ** \return the value of the variable before the update
+ **/
+#define ciaaLibs_atomicFetchOr(ptr, val)                             \
+   __atomic_fetch_or((ptr), (val), __ATOMIC_SEQ_CST)
+#endif
+
+/*==================[typedef]================================================*/
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+#if (cortexM0 == ARCH)
+/** \brief disable the interrupts
+ **
+ ** \return previous value of the primask register
+ **/
+static inline uint32_t ciaaLibs_atomicEnter(void)
+{
+   uint32_t primask;
+
+   __asm volatile ("mrs %0, primask\n\t"
+                   "cpsid i" : "=r" (primask) : : "memory");
+
+   return primask;
+}
+
+/** \brief restore the interrupts
+ **
+ ** \param[in] primask value returned by ciaaLibs_atomicEnter
+ **/
+static inline void ciaaLibs_atomicExit(uint32_t primask)
+{
+   __asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+}
+#endif
+
+/*==================[cplusplus]==============================================*/
+#ifdef __cplusplus
+}
+#endif
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+#endif /* #ifndef CIAALIBS_ATOMIC_H */
+
@@ -36,6 +36,13 @@
  **
  ** This library provides a circular buffer
  **
+ ** The buffer is lock free for one writer and one reader, which may run in
+ ** different tasks, ISRs or cores. The writer is the only one updating the
+ ** tail and the reader the only one updating the head. Both indexes are
+ ** published with release semantic and read with acquire semantic, so the
+ ** data is always written before the new tail is visible to the reader and
+ ** read before the new head is visible to the writer.
+ **
  **/
 
 /** \addtogroup CIAA_Firmware CIAA Firmware
@@ -47,6 +54,7 @@
 #include "ciaaPOSIX_stdint.h"
 #include "ciaaPOSIX_stdlib.h"
 #include "ciaaLibs_Maths.h"
+#include "ciaaLibs_Atomic.h"
 
 /*==================[cplusplus]==============================================*/
 #ifdef __cplusplus
@@ -54,6 +62,30 @@ extern "C" {
 #endif
 
 /*==================[macros]=================================================*/
+/** \brief get the head of the buffer
+ **
+ ** This function is provided for the circular buffer writter. The head is
+ ** read with acquire semantic, the data before the head has been completely
+ ** read by the reader when the returned value is visible.
+ **
+ ** \param[in] cbuf pointer to the circular buffer
+ ** \returns the head of the circular buffer
+ **/
+#define ciaaLibs_circBufHead(cbuf)                             \
+   ciaaLibs_atomicLoadAcquire(&(cbuf)->head)
+
+/** \brief get the tail of the buffer
+ **
+ ** This function is provided for the circular buffer reader. The tail is
+ ** read with acquire semantic, the data before the tail has been completely
+ ** written by the writer when the returned value is visible.
+ **
+ ** \param[in] cbuf pointer to the circular buffer
+ ** \returns the tail of the circular buffer
+ **/
+#define ciaaLibs_circBufTail(cbuf)                             \
+   ciaaLibs_atomicLoadAcquire(&(cbuf)->tail)
+
 /** \brief get free space on the buffer
  **
  ** This function is provided for the circular buffer writter. The user who
@@ -106,23 +138,29 @@ extern "C" {
 
 /** \brief calculate new tail
  **
- ** This function is provided for the circular buffer writter.
+ ** This function is provided for the circular buffer writter. The new tail
+ ** is published with release semantic, the written data shall be stored in
+ ** the buffer before calling this function.
  **
  ** \param[inout] cbuf pointer to the circular buffer to be updated
  ** \param[in] nbytes count of bytes written
  **/
 #define ciaaLibs_circBufUpdateTail(cbuf, nbytes)                        \
-   ((cbuf)->tail = ( ( (cbuf)->tail + (nbytes) ) & ( (cbuf)->size ) ) )
+   ciaaLibs_atomicStoreRelease(&(cbuf)->tail,                           \
+         ( ( (cbuf)->tail + (nbytes) ) & ( (cbuf)->size ) ) )
 
 /** \brief calculate new head
  **
- ** This function is provided for the circular buffer reader.
+ ** This function is provided for the circular buffer reader. The new head
+ ** is published with release semantic, the data shall be read from the
+ ** buffer before calling this function.
  **
  ** \param[inout] cbuf pointer to the circular buffer to be updated
  ** \param[in] nbytes count of bytes read
  **/
 #define ciaaLibs_circBufUpdateHead(cbuf, nbytes)                        \
-      ((cbuf)->head = ( (cbuf)->head + (nbytes) ) & ((cbuf)->size) )
+   ciaaLibs_atomicStoreRelease(&(cbuf)->head,                           \
+         ( ( (cbuf)->head + (nbytes) ) & ( (cbuf)->size ) ) )
 
 /** \brief get count of bytes stored in the buffer
  **
@@ -181,6 +219,40 @@ extern "C" {
       (cbuf)->tail = 0;                \
    }
 
+/** \brief get count of bytes dropped
+ **
+ ** \param[in] cbuf pointer to the circular buffer
+ ** \returns count of bytes overwritten or discarded by
+ **          ciaaLibs_circBufPutOverwrite since the initialization
+ **/
+#define ciaaLibs_circBufDropped(cbuf)                 \
+   ( (cbuf)->dropped )
+
+/** \brief commit data written in place
+ **
+ ** Publishes nbytes written in the spans returned by
+ ** ciaaLibs_circBufWriteReserve. The bytes shall be committed in the same
+ ** order as they were reserved and nbytes shall not be greater than the
+ ** count of reserved bytes.
+ **
+ ** \param[inout] cbuf pointer to the circular buffer
+ ** \param[in] nbytes count of written bytes
+ **/
+#define ciaaLibs_circBufWriteCommit(cbuf, nbytes)     \
+   ciaaLibs_circBufUpdateTail(cbuf, nbytes)
+
+/** \brief release data read in place
+ **
+ ** Releases nbytes read from the spans returned by
+ ** ciaaLibs_circBufReadReserve, the space can be used by the writer
+ ** afterwards. nbytes shall not be greater than the count of reserved bytes.
+ **
+ ** \param[inout] cbuf pointer to the circular buffer
+ ** \param[in] nbytes count of read bytes
+ **/
+#define ciaaLibs_circBufReadRelease(cbuf, nbytes)     \
+   ciaaLibs_circBufUpdateHead(cbuf, nbytes)
+
 /*==================[typedef]================================================*/
 /** \brief circular buffer type
  **
@@ -193,8 +265,25 @@ typedef struct {
    size_t tail;         /** <= index of the position to write the next byte */
    size_t size;         /** <= size-1 of the buffer (>=8-1 and power of 2-1) */
    uint8_t * buf;       /** <= pointer to the buffer */
+   size_t dropped;      /** <= count of bytes overwritten by
+                             ciaaLibs_circBufPutOverwrite */
+   uint8_t mirrored;    /** <= 1 if the buffer is mapped twice back to back,
+                             see ciaaLibs_circBufNewMirrored */
 } ciaaLibs_CircBufType;
 
+/** \brief contiguous spans of a circular buffer
+ **
+ ** A region of a circular buffer is split in up to two contiguous spans, the
+ ** first one until the end of the buffer and the second one from the
+ ** beginning of the buffer. If the region does not wrap the second span
+ ** has 0 bytes.
+ **
+ **/
+typedef struct {
+   uint8_t * buf[2];    /** <= pointer to the first byte of each span */
+   size_t nbytes[2];    /** <= count of bytes of each span */
+} ciaaLibs_CircBufSpanType;
+
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -211,6 +300,25 @@ typedef struct {
  **/
 extern ciaaLibs_CircBufType * ciaaLibs_circBufNew(size_t nbytes);
 
+/** \brief creates a new mirrored circular buffer
+ **
+ ** Creates a circular buffer whose memory is mapped twice back to back, the
+ ** byte after the end of the buffer is the first byte of the buffer. All
+ ** reads and writes are done with a single contiguous span and no wrapping
+ ** is needed.
+ **
+ ** The mirroring is only available for ARCH x86 on linux and if nbytes is a
+ ** multiple of the page size, in other case a normal buffer is created as
+ ** with ciaaLibs_circBufNew.
+ **
+ ** \param[in] nbytes   size in bytes of the buffer, shall be a power of 2 and
+ **                     at least 8
+ ** \returns a pointer to a circular buffer or NULL if an error occurs
+ **
+ ** \remarks only size-1 bytes can be used within the circular buffer
+ **/
+extern ciaaLibs_CircBufType * ciaaLibs_circBufNewMirrored(size_t nbytes);
+
 /** \brief initialize a circular buffer
  **
  ** Performs the initialization of the buffer without allocating any memory.
@@ -225,7 +333,8 @@ extern int32_t ciaaLibs_circBufInit(ciaaLibs_CircBufType * cbuf, void * buf, siz
 /** \brief release a circular buffer
  **
  ** This function shall only be used for circular buffers created with
- ** ciaaLibs_circBufNew and NOT for those initalized with ciaaLibs_circBufInit.
+ ** ciaaLibs_circBufNew or ciaaLibs_circBufNewMirrored and NOT for those
+ ** initalized with ciaaLibs_circBufInit.
  **
  ** \param[in] circular buffer to be released
  **/
@@ -237,18 +346,141 @@ extern void ciaaLibs_circBufRel(ciaaLibs_CircBufType * cbuf);
  ** \param[in]    data data to be stored in the buffer
  ** \param[in]    nbytes size of the data
  ** returns count of stored bytes
+ **
+ ** \remarks this function may be called concurrently with
+ **          ciaaLibs_circBufGet but not with other ciaaLibs_circBufPut on
+ **          the same buffer.
  **/
 extern size_t ciaaLibs_circBufPut(ciaaLibs_CircBufType * cbuf, void const * data, size_t nybtes);
 
+/** \brief put data to a circular buffer overwriting the oldest data
+ **
+ ** Stores the data always, if not enough space is available the oldest bytes
+ ** in the buffer are dropped. If nbytes is greater than the capacity of the
+ ** buffer only the last size-1 bytes of data are stored. The count of lost
+ ** bytes is added to the dropped counter, see ciaaLibs_circBufDropped.
+ **
+ ** This function is intended for flight recorder like buffers: the writer
+ ** streams continuously into a fixed memory window which is read once the
+ ** writer has been stopped (eg. after an incident).
+ **
+ ** \param[inout] cbuf pointer to the circular buffer
+ ** \param[in]    data data to be stored in the buffer
+ ** \param[in]    nbytes size of the data
+ ** returns count of stored bytes
+ **
+ ** \remarks this function updates the head of the buffer, therefore it shall
+ **          NOT be called concurrently with ciaaLibs_circBufGet or other
+ **          functions of the reader on the same buffer.
+ **/
+extern size_t ciaaLibs_circBufPutOverwrite(ciaaLibs_CircBufType * cbuf, void const * data, size_t nbytes);
+
 /** \brief get data from a circular buffer
  **
  ** \param[inout] cbuf pointer to the circular buffer
  ** \param[in]    pointer to store the read data
  ** \param[in]    nbytes size of the data to be read
  ** \returns count of read bytes
+ **
+ ** \remarks this function may be called concurrently with
+ **          ciaaLibs_circBufPut but not with other ciaaLibs_circBufGet on
+ **          the same buffer.
  **/
 extern size_t ciaaLibs_circBufGet(ciaaLibs_CircBufType * cbuf, void * data, size_t nbytes);
 
+/** \brief reserve space to write in place
+ **
+ ** Provides up to nbytes of free space of the buffer as two contiguous spans
+ ** so the data can be written directly in the buffer (eg. by a driver or a
+ ** DMA) without an intermediate copy. The data is not visible to the reader
+ ** until ciaaLibs_circBufWriteCommit is called.
+ **
+ ** \param[in]  cbuf pointer to the circular buffer
+ ** \param[out] span spans of the reserved space
+ ** \param[in]  nbytes maximal count of bytes to be reserved
+ ** \return count of reserved bytes, may be less than nbytes if not enough
+ **         space is available.
+ **
+ ** \remarks this function shall only be called by the writer.
+ **/
+extern size_t ciaaLibs_circBufWriteReserve(ciaaLibs_CircBufType * cbuf,
+      ciaaLibs_CircBufSpanType * span, size_t nbytes);
+
+/** \brief reserve data to read in place
+ **
+ ** Provides up to nbytes of the data stored in the buffer as two contiguous
+ ** spans so the data can be read directly from the buffer without an
+ ** intermediate copy. The space is not released to the writer until
+ ** ciaaLibs_circBufReadRelease is called.
+ **
+ ** \param[in]  cbuf pointer to the circular buffer
+ ** \param[out] span spans of the reserved data
+ ** \param[in]  nbytes maximal count of bytes to be reserved
+ ** \return count of reserved bytes, may be less than nbytes if not enough
+ **         data is available.
+ **
+ ** \remarks this function shall only be called by the reader.
+ **/
+extern size_t ciaaLibs_circBufReadReserve(ciaaLibs_CircBufType * cbuf,
+      ciaaLibs_CircBufSpanType * span, size_t nbytes);
+
+/** \brief find a byte in a circular buffer
+ **
+ ** Searches the byte c in the data stored in the buffer starting at offset
+ ** bytes from the head without reading the data out of the buffer. The
+ ** search continues across the end of the buffer.
+ **
+ ** \param[in] cbuf pointer to the circular buffer
+ ** \param[in] offset offset from the head to start the search
+ ** \param[in] c byte to be found
+ ** \return offset from the head of the first occurrence of c or -1 if not
+ **         found
+ **
+ ** \remarks this function shall only be called by the reader.
+ **/
+extern int32_t ciaaLibs_circBufFind(ciaaLibs_CircBufType * cbuf, size_t offset, uint8_t c);
+
+/** \brief find a pair of bytes in a circular buffer
+ **
+ ** Searches c0 immediately followed by c1 (eg. CR LF) in the data stored in
+ ** the buffer starting at offset bytes from the head. The pair may be split
+ ** by the end of the buffer.
+ **
+ ** \param[in] cbuf pointer to the circular buffer
+ ** \param[in] offset offset from the head to start the search
+ ** \param[in] c0 first byte of the pair
+ ** \param[in] c1 second byte of the pair
+ ** \return offset from the head of the first byte of the first occurrence of
+ **         the pair or -1 if not found
+ **
+ ** \remarks this function shall only be called by the reader.
+ **/
+extern int32_t ciaaLibs_circBufFindPair(ciaaLibs_CircBufType * cbuf, size_t offset, uint8_t c0, uint8_t c1);
+
+/** \brief copy data from a circular buffer without removing it
+ **
+ ** \param[in] cbuf pointer to the circular buffer
+ ** \param[in] offset offset from the head of the first byte to be copied
+ ** \param[out] data pointer to store the data
+ ** \param[in] nbytes count of bytes to be copied
+ ** \return count of copied bytes, less than nbytes if not enough data is
+ **         available after offset
+ **
+ ** \remarks this function shall only be called by the reader.
+ **/
+extern size_t ciaaLibs_circBufPeek(ciaaLibs_CircBufType * cbuf, size_t offset, void * data, size_t nbytes);
+
+/** \brief remove data from a circular buffer without reading it
+ **
+ ** \param[inout] cbuf pointer to the circular buffer
+ ** \param[in] nbytes count of bytes to be removed
+ ** \return count of removed bytes, less than nbytes if not enough data is
+ **         available
+ **
+ ** \remarks this function shall only be called by the reader.
+ **/
+extern size_t ciaaLibs_circBufSkip(ciaaLibs_CircBufType * cbuf, size_t nbytes);
+
 /*==================[cplusplus]==============================================*/
 #ifdef __cplusplus
 }
@@ -0,0 +1,180 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ * All rights reserved.
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef CIAALIBS_CIRCBUFMP_H
+#define CIAALIBS_CIRCBUFMP_H
+/** \brief Multi Producer Circular Buffer Library header
+ **
+ ** This library provides a circular buffer for many writers and one reader.
+ **
+ ** The writers reserve space by atomically incrementing the reserve index
+ ** and copy the data without blocking each other. After copying, each writer
+ ** adds the count of written bytes to the commit counter. The writer which
+ ** brings the commit counter up to the reserve index publishes the tail, so
+ ** the reader only sees completely written data and in reservation order.
+ **
+ ** No writer waits for another one, therefore the buffer can be used from
+ ** tasks of different priorities and from ISRs. While the writers overlap,
+ ** the publication of the tail is delayed until the last of them commits.
+ **
+ ** All indexes are free running counters, the position in the buffer is
+ ** obtained by masking them with the size.
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup Libs CIAA Libraries
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "ciaaPOSIX_stdint.h"
+#include "ciaaPOSIX_stdlib.h"
+#include "ciaaLibs_Maths.h"
+#include "ciaaLibs_Atomic.h"
+
+/*==================[cplusplus]==============================================*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================[macros]=================================================*/
+/** \brief get count of bytes stored in the buffer
+ **
+ ** This function is provided for the circular buffer reader.
+ **
+ ** \param[in] cbuf pointer to the circular buffer
+ ** \returns the count of published bytes on the buffer
+ **/
+#define ciaaLibs_circBufMpCount(cbuf)                          \
+   ( ciaaLibs_atomicLoadAcquire(&(cbuf)->tail) - (cbuf)->head )
+
+/** \brief checks if the buffer is empty
+ **
+ ** \param[in] cbuf pointer to the circular buffer
+ ** \returns 1 if the buffer is empty, 0 in other case
+ **/
+#define ciaaLibs_circBufMpEmpty(cbuf)                          \
+   ( ciaaLibs_atomicLoadAcquire(&(cbuf)->tail) == (cbuf)->head )
+
+/*==================[typedef]================================================*/
+/** \brief multi producer circular buffer type
+ **
+ ** The indexes are free running, if the buffer is empty head and tail are
+ ** the same and if the buffer is full reserve-head=size+1. A buffer of size
+ ** 64 can handle 64 bytes.
+ **
+ **/
+typedef struct {
+   size_t head;         /** <= index of the next byte to be read */
+   size_t tail;         /** <= index until the data is visible to the reader */
+   size_t reserve;      /** <= index of the next byte to be reserved */
+   size_t commit;       /** <= count of bytes written by the writers */
+   size_t size;         /** <= size-1 of the buffer (>=8-1 and power of 2-1) */
+   uint8_t * buf;       /** <= pointer to the buffer */
+} ciaaLibs_CircBufMpType;
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/** \brief creates a new multi producer circular buffer
+ **
+ ** Allocates the needed memory for a buffer of nbytes size and perform the
+ ** initialization of the buffer.
+ **
+ ** \param[in] nbytes   size in bytes of the buffer, shall be a power of 2 and
+ **                     at least 8
+ ** \returns a pointer to a circular buffer or NULL if an error occurs
+ **/
+extern ciaaLibs_CircBufMpType * ciaaLibs_circBufMpNew(size_t nbytes);
+
+/** \brief initialize a multi producer circular buffer
+ **
+ ** Performs the initialization of the buffer without allocating any memory.
+ **
+ ** \param[out] cbuf circular buffer to be initializated
+ ** \param[in] buf pointer to the buffer
+ ** \param[in] nbytes size of the buffer, shall be a power of 2 and at least 8
+ ** \return 1 if init can be performed -1 in other case
+ **/
+extern int32_t ciaaLibs_circBufMpInit(ciaaLibs_CircBufMpType * cbuf, void * buf, size_t nbytes);
+
+/** \brief release a multi producer circular buffer
+ **
+ ** This function shall only be used for circular buffers created with
+ ** ciaaLibs_circBufMpNew and NOT for those initalized with
+ ** ciaaLibs_circBufMpInit.
+ **
+ ** \param[in] circular buffer to be released
+ **/
+extern void ciaaLibs_circBufMpRel(ciaaLibs_CircBufMpType * cbuf);
+
+/** \brief put data to a multi producer circular buffer
+ **
+ ** The data is only stored if all bytes fit in the buffer, the bytes of a
+ ** call are never interleaved with bytes of other writers.
+ **
+ ** \param[inout] cbuf pointer to the circular buffer
+ ** \param[in]    data data to be stored in the buffer
+ ** \param[in]    nbytes size of the data
+ ** \returns count of stored bytes, nbytes or 0
+ **
+ ** \remarks this function may be called concurrently from many tasks, ISRs
+ **          and with ciaaLibs_circBufMpGet.
+ **/
+extern size_t ciaaLibs_circBufMpPut(ciaaLibs_CircBufMpType * cbuf, void const * data, size_t nbytes);
+
+/** \brief get data from a multi producer circular buffer
+ **
+ ** \param[inout] cbuf pointer to the circular buffer
+ ** \param[in]    pointer to store the read data
+ ** \param[in]    nbytes size of the data to be read
+ ** \returns count of read bytes
+ **
+ ** \remarks this function may be called concurrently with
+ **          ciaaLibs_circBufMpPut but not with other ciaaLibs_circBufMpGet
+ **          on the same buffer.
+ **/
+extern size_t ciaaLibs_circBufMpGet(ciaaLibs_CircBufMpType * cbuf, void * data, size_t nbytes);
+
+/*==================[cplusplus]==============================================*/
+#ifdef __cplusplus
+}
+#endif
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+#endif /* #ifndef CIAALIBS_CIRCBUFMP_H */
+
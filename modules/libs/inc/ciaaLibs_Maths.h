@@ -98,6 +98,65 @@ extern "C" {
 #define ciaaLibs_clearBit(var, bit)   \
    ((var) &= (~( 1 << (bit) )))
 
+#if (defined(__GNUC__))
+/** \brief Count trailing zeros of a 32 bits word
+ **
+ ** Uses the compiler intrinsic, which is translated to a few instructions
+ ** (eg. rbit and clz on cortexM4, bsf on x86).
+ **
+ ** \param[in] value value to be checked, shall not be 0
+ ** \return count of 0 bits below the least significant set bit (0 to 31)
+ **/
+#define ciaaLibs_ctz(value)         \
+   ( (uint8_t)__builtin_ctz((uint32_t)(value)) )
+
+/** \brief Count leading zeros of a 32 bits word
+ **
+ ** Uses the compiler intrinsic, which is translated to a few instructions
+ ** (eg. clz on cortexM4, bsr on x86).
+ **
+ ** \param[in] value value to be checked, shall not be 0
+ ** \return count of 0 bits above the most significant set bit (0 to 31)
+ **/
+#define ciaaLibs_clz(value)         \
+   ( (uint8_t)__builtin_clz((uint32_t)(value)) )
+#else
+/** \brief Count trailing zeros of a 32 bits word
+ **
+ ** \param[in] value value to be checked, shall not be 0
+ ** \return count of 0 bits below the least significant set bit (0 to 31)
+ **/
+#define ciaaLibs_ctz(value)         \
+   ciaaLibs_ctzPortable((uint32_t)(value))
+
+/** \brief Count leading zeros of a 32 bits word
+ **
+ ** \param[in] value value to be checked, shall not be 0
+ ** \return count of 0 bits above the most significant set bit (0 to 31)
+ **/
+#define ciaaLibs_clz(value)         \
+   ciaaLibs_clzPortable((uint32_t)(value))
+#endif
+
+/** \brief Replicate a byte in all bytes of a 32 bits word
+ **
+ ** \param[in] c byte to be replicated
+ ** \return 32 bits word with all bytes equal to c
+ **/
+#define ciaaLibs_byteToWord(c)      \
+   ( (uint32_t)(uint8_t)(c) * 0x01010101U )
+
+/** \brief Check if a 32 bits word has a byte equal to 0
+ **
+ ** Checks the four bytes of the word at once. To look for a byte c the word
+ ** has to be xored with ciaaLibs_byteToWord(c) before.
+ **
+ ** \param[in] word 32 bits word to be checked
+ ** \return != 0 if at least one byte of word is 0, 0 in other case
+ **/
+#define ciaaLibs_hasZeroByte(word)  \
+   ( (uint32_t)( (word) - 0x01010101U ) & ~(word) & 0x80808080U )
+
 /*==================[typedef]================================================*/
 
 /*==================[external data declaration]==============================*/
@@ -116,6 +175,28 @@ extern "C" {
  **/
 extern int8_t ciaaLibs_getFirstNotSetBit(uint32_t value);
 
+/** \brief count trailing zeros of a uint32
+ **
+ ** Portable implementation of ciaaLibs_ctz for compilers without intrinsic,
+ ** performs a binary search in 5 steps.
+ **
+ ** \param[in] value value to be checked
+ ** \return count of 0 bits below the least significant set bit, 32 if value
+ **         is 0
+ **/
+extern uint8_t ciaaLibs_ctzPortable(uint32_t value);
+
+/** \brief count leading zeros of a uint32
+ **
+ ** Portable implementation of ciaaLibs_clz for compilers without intrinsic,
+ ** performs a binary search in 5 steps.
+ **
+ ** \param[in] value value to be checked
+ ** \return count of 0 bits above the most significant set bit, 32 if value
+ **         is 0
+ **/
+extern uint8_t ciaaLibs_clzPortable(uint32_t value);
+
 /*==================[cplusplus]==============================================*/
 #ifdef __cplusplus
 }
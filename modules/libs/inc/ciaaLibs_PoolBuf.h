@@ -54,12 +54,27 @@ extern "C" {
 #endif
 
 /*==================[macros]=================================================*/
+/** \brief count of status words needed for a pool of size elements
+ **
+ ** \param[in] size count of elements of the pool
+ **/
+#define CIAALIBS_POOLSTATUSSIZE(size)     \
+   (((size) + 31) >> 5)
+
+/** \brief count of summary words needed for a pool of size elements
+ **
+ ** \param[in] size count of elements of the pool
+ **/
+#define CIAALIBS_POOLSUMMARYSIZE(size)    \
+   ((CIAALIBS_POOLSTATUSSIZE(size) + 31) >> 5)
+
 /** \brief macro to define the pool declaration variables
  **
- ** This macro genertes the definition of 3 variables called:
+ ** This macro genertes the definition of 4 variables called:
  **  * <name>_buf: array of type type and size size
  **  * <name>_status: array to store the status (free and used of each element
  **                   of the buffer <name>_buf.
+ **  * <name>_summary: array to store which status words are full
  **  * <name>: pool
  **
  ** If you use this macro you do not need to call ciaaLibs_poolBufInit.
@@ -69,14 +84,16 @@ extern "C" {
  ** \param[in] size size of the pool
  **
  **/
-#define CIAALIBS_POOLDECLARE(name, type, size)  \
-   type name ## _buf[(size)];                   \
-   uint32_t name ## _status[(size)/32] = { 0 }; \
-   ciaaLibs_poolBufType name = {                \
-      (size),                                   \
-      sizeof(type),                             \
-      name ## _status,                          \
-      name ## _buf                              \
+#define CIAALIBS_POOLDECLARE(name, type, size)                       \
+   type name ## _buf[(size)];                                        \
+   uint32_t name ## _status[CIAALIBS_POOLSTATUSSIZE(size)] = { 0 };  \
+   uint32_t name ## _summary[CIAALIBS_POOLSUMMARYSIZE(size)] = { 0 };\
+   ciaaLibs_poolBufType name = {                                     \
+      (size),                                                        \
+      sizeof(type),                                                  \
+      name ## _status,                                               \
+      name ## _summary,                                              \
+      (uint8_t *) name ## _buf                                       \
    };
 
 
@@ -86,12 +103,19 @@ extern "C" {
  **/
 typedef struct {
    size_t poolSize;      /** <= count of elements which can be stored in this
-                               pool. Shall be 32 * x */
+                               pool */
    size_t elementSize;   /** <= size of each element */
-   uint32_t * statusPtr; /** <= pointer to an array of size poolSize / 32, each
-                                bit indicataes with 0 that the corresponding
+   uint32_t * statusPtr; /** <= pointer to an array of
+                                CIAALIBS_POOLSTATUSSIZE(poolSize), each bit
+                                indicataes with 0 that the corresponding
                                 pool element is not used, with one that is
                                 beeing used. */
+   uint32_t * summaryPtr;/** <= pointer to an array of
+                                CIAALIBS_POOLSUMMARYSIZE(poolSize), each bit
+                                indicates with 1 that the corresponding word
+                                of statusPtr is full. All 0 is a valid
+                                initial value, so static pools need no
+                                initialization. */
    uint8_t * buf;        /** <= pointer to the buffer. Buffer shall be
                                poolSize * elementSize */
 } ciaaLibs_poolBufType;
@@ -105,31 +129,47 @@ typedef struct {
  **
  ** \param[inout] pbuf pool buffer to be initializated
  ** \param[in] buf pointer to the buffer with size poolSize * elementSize
- ** \param[in] statusPtr pointer to the buffer of poolSize / 32 of type uint32
- ** \param[in] poolSize size of the pool shall be multiple of 32
+ ** \param[in] statusPtr pointer to the buffer of
+ **            CIAALIBS_POOLSTATUSSIZE(poolSize) of type uint32
+ ** \param[in] summaryPtr pointer to the buffer of
+ **            CIAALIBS_POOLSUMMARYSIZE(poolSize) of type uint32
+ ** \param[in] poolSize count of elements of the pool
  ** \param[in] elementSize size of an element in the pool
  ** \return 1 if init can be performed -1 in other case
  **
  **/
 extern int32_t ciaaLibs_poolBufInit(ciaaLibs_poolBufType * pbuf,
-      void * buf, uint32_t * statusPtr, size_t poolSize, size_t elementSize);
+      void * buf, uint32_t * statusPtr, uint32_t * summaryPtr,
+      size_t poolSize, size_t elementSize);
 
 /** \brief get free place on the pool buffer
+ **
+ ** The lowest free element is returned. The summary is used to find the
+ ** first not full status word and the free element on it is found counting
+ ** trailing zeros, so the time does not depend on the fill level for pools
+ ** up to 1024 elements.
+ **
+ ** Each summary word covers 1024 elements and the summary words are
+ ** scanned linearly, larger pools take one more word in the worst case for
+ ** each 1024 elements. Pools used from ISRs should not exceed 1024 elements.
  **
  ** \param[inout] pbuf pointer to the pool buffer
  ** \return a pointer to the element or NULL if not free element is available
  **
- ** \remarks this function is not thread safe, in a multi task environment
- **          ensure that this function is not executed concurrently with the
- **          same pbuf parameter.
+ ** \remarks this function is lock free, it can be called concurrently from
+ **          tasks and ISRs with the same pbuf parameter.
  **/
 extern void * ciaaLibs_poolBufLock(ciaaLibs_poolBufType * pbuf);
 
 /** \brief remove element from a pull buffer
  **
  ** \param[inout] pbuf pointer to the pool buffer
- ** \param[in]    element pointer to the element to be removed from the pool
- ** \returns 1 if success 0 if an error occurs
+ ** \param[in]    data pointer to the element to be removed from the pool
+ ** \returns 1 if success 0 if data is not an element of the pool or it is
+ **          not being used
+ **
+ ** \remarks this function is lock free, it can be called concurrently from
+ **          tasks and ISRs with the same pbuf parameter.
  **/
 extern size_t ciaaLibs_poolBufFree(ciaaLibs_poolBufType * pbuf, void * data);
 
@@ -0,0 +1,177 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ * All rights reserved.
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef CIAALIBS_POOLLIST_H
+#define CIAALIBS_POOLLIST_H
+/** \brief Pool List Library header
+ **
+ ** This library provides a pool of fixed size elements where the free
+ ** elements are linked in a list stored in the elements themselves, so
+ ** lock and free are performed in constant time without any search.
+ **
+ ** Each element has a bit in a status array indicating if it is being used,
+ ** it is used to reject invalid and double frees.
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup Libs CIAA Libraries
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "ciaaPOSIX_stdint.h"
+#include "ciaaPOSIX_stdlib.h"
+#include "ciaaLibs_PoolBuf.h"
+
+/*==================[cplusplus]==============================================*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================[macros]=================================================*/
+/** \brief macro to define the pool list declaration variables
+ **
+ ** This macro genertes the definition of 3 variables called:
+ **  * <name>_buf: array of size size of elements big enough to store a type
+ **                or the link to the next free element
+ **  * <name>_status: array to store the status (free and used of each element
+ **                   of the buffer <name>_buf.
+ **  * <name>: pool list
+ **
+ ** If you use this macro you do not need to call ciaaLibs_poolListInit.
+ **
+ ** \param[in] name name of the pool list
+ ** \param[in] type type of the variable
+ ** \param[in] size size of the pool list
+ **
+ **/
+#define CIAALIBS_POOLLISTDECLARE(name, type, size)                   \
+   union {                                                           \
+      type element;                                                  \
+      void * next;                                                   \
+   } name ## _buf[(size)];                                           \
+   uint32_t name ## _status[CIAALIBS_POOLSTATUSSIZE(size)] = { 0 };  \
+   ciaaLibs_poolListType name = {                                    \
+      (size),                                                        \
+      sizeof(name ## _buf[0]),                                       \
+      name ## _status,                                               \
+      NULL,                                                          \
+      0,                                                             \
+      (uint8_t *) name ## _buf                                       \
+   };
+
+/*==================[typedef]================================================*/
+/** \brief pool list type
+ **
+ **/
+typedef struct {
+   size_t poolSize;      /** <= count of elements which can be stored in this
+                               pool */
+   size_t elementSize;   /** <= size of each element, shall be a multiple of
+                                the size of a pointer */
+   uint32_t * statusPtr; /** <= pointer to an array of
+                                CIAALIBS_POOLSTATUSSIZE(poolSize), each bit
+                                indicataes with 0 that the corresponding
+                                pool element is not used, with one that is
+                                beeing used. */
+   void * head;          /** <= first element of the list of freed elements */
+   size_t unused;        /** <= count of elements at the beginning of the
+                                buffer which have been locked at least once,
+                                the elements after them are free but not
+                                linked in the list */
+   uint8_t * buf;        /** <= pointer to the buffer. Buffer shall be
+                               poolSize * elementSize and aligned to a
+                               pointer */
+} ciaaLibs_poolListType;
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/** \brief initialize a pool list
+ **
+ ** Performs the initialization of the pool list without allocating any memory.
+ **
+ ** \param[inout] plist pool list to be initializated
+ ** \param[in] buf pointer to the buffer with size poolSize * elementSize
+ **            aligned to a pointer
+ ** \param[in] statusPtr pointer to the buffer of
+ **            CIAALIBS_POOLSTATUSSIZE(poolSize) of type uint32
+ ** \param[in] poolSize count of elements of the pool
+ ** \param[in] elementSize size of an element in the pool, shall be a
+ **            multiple of the size of a pointer
+ ** \return 1 if init can be performed -1 in other case
+ **
+ **/
+extern int32_t ciaaLibs_poolListInit(ciaaLibs_poolListType * plist,
+      void * buf, uint32_t * statusPtr, size_t poolSize, size_t elementSize);
+
+/** \brief get free element from the pool list
+ **
+ ** Pops the first element of the list of freed elements, if the list is
+ ** empty the next never used element is returned.
+ **
+ ** \param[inout] plist pointer to the pool list
+ ** \return a pointer to the element or NULL if not free element is available
+ **
+ ** \remarks this function is not thread safe, in a multi task environment
+ **          ensure that this function is not executed concurrently with the
+ **          same plist parameter.
+ **/
+extern void * ciaaLibs_poolListLock(ciaaLibs_poolListType * plist);
+
+/** \brief return an element to the pool list
+ **
+ ** The element is pushed to the list of freed elements.
+ **
+ ** \param[inout] plist pointer to the pool list
+ ** \param[in]    data pointer to the element to be returned to the pool
+ ** \returns 1 if success 0 if data is not an element of the pool or it is
+ **          not being used
+ **
+ ** \remarks this function is not thread safe, in a multi task environment
+ **          ensure that this function is not executed concurrently with the
+ **          same plist parameter.
+ **/
+extern size_t ciaaLibs_poolListFree(ciaaLibs_poolListType * plist, void * data);
+
+/*==================[cplusplus]==============================================*/
+#ifdef __cplusplus
+}
+#endif
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+#endif /* #ifndef CIAALIBS_POOLLIST_H */
+
@@ -0,0 +1,213 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ * All rights reserved.
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef CIAALIBS_RECBUF_H
+#define CIAALIBS_RECBUF_H
+/** \brief Record Buffer Library header
+ **
+ ** This library provides a queue of variable length records stored in a
+ ** circular buffer.
+ **
+ ** Each record is stored with a header of ciaaLibs_RECBUF_HEADER bytes
+ ** containing the length of the record followed by the data. A record is
+ ** written and read at once: the header and the data are published to the
+ ** reader with a single commit, so the reader never sees a partially written
+ ** record. As the underlying circular buffer it is lock free for one writer
+ ** and one reader.
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup Libs CIAA Libraries
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "ciaaPOSIX_stdint.h"
+#include "ciaaPOSIX_stdlib.h"
+#include "ciaaLibs_CircBuf.h"
+
+/*==================[cplusplus]==============================================*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*==================[macros]=================================================*/
+/** \brief size of the header of each record */
+#define ciaaLibs_RECBUF_HEADER         (sizeof(uint16_t))
+
+/** \brief maximal length of a record */
+#define ciaaLibs_RECBUF_MAXLENGTH      (0xFFFF)
+
+/** \brief checks if the record buffer is empty
+ **
+ ** \param[in] rbuf pointer to the record buffer
+ ** \returns 1 if the buffer is empty, 0 in other case
+ **/
+#define ciaaLibs_recBufEmpty(rbuf)                    \
+   ciaaLibs_circBufEmpty(&(rbuf)->cbuf)
+
+/** \brief cleans the record buffer
+ **
+ ** \param[in] rbuf pointer to the record buffer
+ ** \return none
+ **/
+#define ciaaLibs_recBufClean(rbuf)                    \
+   ciaaLibs_circBufClean(&(rbuf)->cbuf)
+
+/** \brief get count of records dropped
+ **
+ ** \param[in] rbuf pointer to the record buffer
+ ** \returns count of records overwritten by ciaaLibs_recBufPutOverwrite
+ **          since the initialization
+ **/
+#define ciaaLibs_recBufDropped(rbuf)                  \
+   ( (rbuf)->dropped )
+
+/*==================[typedef]================================================*/
+/** \brief record buffer type */
+typedef struct {
+   ciaaLibs_CircBufType cbuf; /** <= circular buffer storing the records */
+   size_t dropped;            /** <= count of records overwritten by
+                                   ciaaLibs_recBufPutOverwrite */
+} ciaaLibs_RecBufType;
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/** \brief creates a new record buffer
+ **
+ ** Allocates the needed memory for a buffer of nbytes size and perform the
+ ** initialization of the buffer.
+ **
+ ** \param[in] nbytes   size in bytes of the buffer, shall be a power of 2 and
+ **                     at least 8
+ ** \returns a pointer to a record buffer or NULL if an error occurs
+ **
+ ** \remarks each record uses ciaaLibs_RECBUF_HEADER bytes more than its
+ **          length and only size-1 bytes can be used within the buffer.
+ **/
+extern ciaaLibs_RecBufType * ciaaLibs_recBufNew(size_t nbytes);
+
+/** \brief initialize a record buffer
+ **
+ ** Performs the initialization of the buffer without allocating any memory.
+ **
+ ** \param[out] rbuf record buffer to be initializated
+ ** \param[in] buf pointer to the buffer
+ ** \param[in] nbytes size of the buffer, shall be a power of 2 and at least 8
+ ** \return 1 if init can be performed -1 in other case
+ **/
+extern int32_t ciaaLibs_recBufInit(ciaaLibs_RecBufType * rbuf, void * buf, size_t nbytes);
+
+/** \brief release a record buffer
+ **
+ ** This function shall only be used for record buffers created with
+ ** ciaaLibs_recBufNew and NOT for those initalized with ciaaLibs_recBufInit.
+ **
+ ** \param[in] rbuf record buffer to be released
+ **/
+extern void ciaaLibs_recBufRel(ciaaLibs_RecBufType * rbuf);
+
+/** \brief put a record to a record buffer
+ **
+ ** The record is only stored if the header and all bytes fit in the buffer.
+ **
+ ** \param[inout] rbuf pointer to the record buffer
+ ** \param[in]    data data of the record
+ ** \param[in]    nbytes length of the record, 1 to ciaaLibs_RECBUF_MAXLENGTH
+ ** \returns nbytes if the record has been stored, 0 in other case
+ **
+ ** \remarks this function may be called concurrently with
+ **          ciaaLibs_recBufGet but not with other ciaaLibs_recBufPut on
+ **          the same buffer.
+ **/
+extern size_t ciaaLibs_recBufPut(ciaaLibs_RecBufType * rbuf, void const * data, size_t nbytes);
+
+/** \brief put a record to a record buffer overwriting the oldest records
+ **
+ ** If not enough space is available the oldest records are dropped until the
+ ** new record fits, records are always dropped completely. The count of
+ ** dropped records is added to the dropped counter, see
+ ** ciaaLibs_recBufDropped.
+ **
+ ** \param[inout] rbuf pointer to the record buffer
+ ** \param[in]    data data of the record
+ ** \param[in]    nbytes length of the record, 1 to the size of the buffer
+ **                      minus ciaaLibs_RECBUF_HEADER+1
+ ** \returns nbytes if the record has been stored, 0 in other case
+ **
+ ** \remarks this function removes records, therefore it shall NOT be
+ **          called concurrently with ciaaLibs_recBufGet or other functions
+ **          of the reader on the same buffer.
+ **/
+extern size_t ciaaLibs_recBufPutOverwrite(ciaaLibs_RecBufType * rbuf, void const * data, size_t nbytes);
+
+/** \brief get the length of the next record
+ **
+ ** \param[in] rbuf pointer to the record buffer
+ ** \returns length of the next record or 0 if the buffer is empty
+ **
+ ** \remarks this function shall only be called by the reader.
+ **/
+extern size_t ciaaLibs_recBufPeekNextLength(ciaaLibs_RecBufType * rbuf);
+
+/** \brief get a record from a record buffer
+ **
+ ** Reads the next record if it fits in nbytes. If the record is longer the
+ ** record is not removed from the buffer, ciaaLibs_recBufPeekNextLength can
+ ** be used to get the needed size.
+ **
+ ** \param[inout] rbuf pointer to the record buffer
+ ** \param[out]   data pointer to store the record
+ ** \param[in]    nbytes size of data
+ ** \returns length of the read record or 0 if the buffer is empty or the
+ **          record does not fit in nbytes
+ **
+ ** \remarks this function may be called concurrently with
+ **          ciaaLibs_recBufPut but not with other ciaaLibs_recBufGet on
+ **          the same buffer.
+ **/
+extern size_t ciaaLibs_recBufGet(ciaaLibs_RecBufType * rbuf, void * data, size_t nbytes);
+
+/*==================[cplusplus]==============================================*/
+#ifdef __cplusplus
+}
+#endif
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+#endif /* #ifndef CIAALIBS_RECBUF_H */
+
@@ -42,23 +42,83 @@
  ** @{ */
 
 /*==================[inclusions]=============================================*/
+/* memfd_create is a GNU extension */
+#if (defined(__linux__) && !defined(_GNU_SOURCE))
+#define _GNU_SOURCE
+#endif
+
 #include "ciaaLibs_CircBuf.h"
 #include "ciaaLibs_Maths.h"
 #include "ciaaPOSIX_stdlib.h"
 #include "ciaaPOSIX_stdint.h"
 #include "ciaaPOSIX_string.h"
 
+/* the mirrored buffers are mapped with the linux virtual memory */
+#if ( (x86 == ARCH) && defined(__linux__) )
+#include "sys/mman.h"
+#include "unistd.h"
+#define ciaaLibs_CIRCBUF_MIRROR     1
+#else
+#define ciaaLibs_CIRCBUF_MIRROR     0
+#endif
+
 /*==================[macros and definitions]=================================*/
+/** \brief 32 bits word which may alias the bytes of the buffer */
+typedef uint32_t __attribute__((__may_alias__)) ciaaLibs_circBufWordType;
 
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
+/** \brief find a byte in a contiguous memory area
+ **
+ ** The bytes are checked one at a time until the pointer is aligned and
+ ** then a 32 bits word at a time.
+ **
+ ** \param[in] buf pointer to the memory area
+ ** \param[in] nbytes size of the memory area
+ ** \param[in] c byte to be found
+ ** \return index of the first occurrence of c or nbytes if not found
+ **/
+static size_t ciaaLibs_circBufMemChr(uint8_t const * buf, size_t nbytes, uint8_t c);
 
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static size_t ciaaLibs_circBufMemChr(uint8_t const * buf, size_t nbytes, uint8_t c)
+{
+   size_t ret = 0;
+   uint32_t pattern = ciaaLibs_byteToWord(c);
+   ciaaLibs_circBufWordType const * word;
+
+   /* check byte per byte until the pointer is aligned */
+   while ( (ret < nbytes) && (0 != ((uintptr_t)&buf[ret] & (sizeof(uint32_t) - 1))) &&
+         (c != buf[ret]) )
+   {
+      ret++;
+   }
+
+   /* check a word at a time, stop at the first word containing c */
+   if ( (ret < nbytes) && (c != buf[ret]) )
+   {
+      word = (ciaaLibs_circBufWordType const *) &buf[ret];
+      while ( (ret + sizeof(uint32_t) <= nbytes) &&
+            (0 == ciaaLibs_hasZeroByte(*word ^ pattern)) )
+      {
+         word++;
+         ret += sizeof(uint32_t);
+      }
+
+      /* find the byte within the word or in the last bytes */
+      while ( (ret < nbytes) && (c != buf[ret]) )
+      {
+         ret++;
+      }
+   }
+
+   return ret;
+} /* end ciaaLibs_circBufMemChr */
 
 /*==================[external functions definition]==========================*/
 extern ciaaLibs_CircBufType * ciaaLibs_circBufNew(size_t nbytes)
@@ -83,6 +143,65 @@ extern ciaaLibs_CircBufType * ciaaLibs_circBufNew(size_t nbytes)
    return ret;
 } /* end ciaaLibs_circBufNew */
 
+extern ciaaLibs_CircBufType * ciaaLibs_circBufNewMirrored(size_t nbytes)
+{
+   ciaaLibs_CircBufType * ret = NULL;
+#if (1 == ciaaLibs_CIRCBUF_MIRROR)
+   int fd;
+   uint8_t * buf = MAP_FAILED;
+
+   /* check that size is a power of 2 and a multiple of the page size */
+   if ( (nbytes > 7) && (ciaaLibs_isPowerOfTwo(nbytes)) &&
+        (0 == (nbytes % (size_t)sysconf(_SC_PAGESIZE))) )
+   {
+      fd = memfd_create("ciaaLibs_CircBuf", 0);
+      if ( (0 <= fd) && (0 == ftruncate(fd, nbytes)) )
+      {
+         /* reserve the address space of both mappings and map the file
+          * twice over it */
+         buf = mmap(NULL, 2 * nbytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+         if ( (MAP_FAILED != buf) &&
+              ( (MAP_FAILED == mmap(buf, nbytes, PROT_READ | PROT_WRITE,
+                                    MAP_SHARED | MAP_FIXED, fd, 0)) ||
+                (MAP_FAILED == mmap(&buf[nbytes], nbytes, PROT_READ | PROT_WRITE,
+                                    MAP_SHARED | MAP_FIXED, fd, 0)) ) )
+         {
+            munmap(buf, 2 * nbytes);
+            buf = MAP_FAILED;
+         }
+      }
+
+      /* the mappings keep the file, the descriptor is not needed anymore */
+      if (0 <= fd)
+      {
+         close(fd);
+      }
+
+      if (MAP_FAILED != buf)
+      {
+         ret = (ciaaLibs_CircBufType *) ciaaPOSIX_malloc(sizeof(ciaaLibs_CircBufType));
+         if (NULL != ret)
+         {
+            ciaaLibs_circBufInit(ret, buf, nbytes);
+            ret->mirrored = 1;
+         }
+         else
+         {
+            munmap(buf, 2 * nbytes);
+         }
+      }
+   }
+#endif
+
+   /* use a normal buffer if mirroring is not possible */
+   if (NULL == ret)
+   {
+      ret = ciaaLibs_circBufNew(nbytes);
+   }
+
+   return ret;
+} /* end ciaaLibs_circBufNewMirrored */
+
 extern int32_t ciaaLibs_circBufInit(ciaaLibs_CircBufType * cbuf, void * buf, size_t nbytes)
 {
    int32_t ret = -1;
@@ -95,6 +214,8 @@ extern int32_t ciaaLibs_circBufInit(ciaaLibs_CircBufType * cbuf, void * buf, siz
       cbuf->head = 0;
       cbuf->tail = 0;
       cbuf->buf = buf;
+      cbuf->dropped = 0;
+      cbuf->mirrored = 0;
 
       ret = 1;
    }
@@ -104,6 +225,14 @@ extern int32_t ciaaLibs_circBufInit(ciaaLibs_CircBufType * cbuf, void * buf, siz
 
 extern void ciaaLibs_circBufRel(ciaaLibs_CircBufType * cbuf)
 {
+#if (1 == ciaaLibs_CIRCBUF_MIRROR)
+   /* unmap both mappings of a mirrored buffer */
+   if (1 == cbuf->mirrored)
+   {
+      munmap(cbuf->buf, 2 * (cbuf->size + 1));
+   }
+#endif
+
    /* free reserved memory */
    ciaaPOSIX_free(cbuf);
 } /* end ciaaLibs_circBufRel */
@@ -111,32 +240,25 @@ extern void ciaaLibs_circBufRel(ciaaLibs_CircBufType * cbuf)
 extern size_t ciaaLibs_circBufPut(ciaaLibs_CircBufType * cbuf, void const * data, size_t nbytes)
 {
    size_t ret = 0;
-   size_t rawSpace;
+   ciaaLibs_CircBufSpanType span;
 
-   /* the head of the circular buffer may be changed, therefore it has to be
-    * read only once */
-   size_t head = cbuf->head;
-
-   /* check that is enough place */
-   if (ciaaLibs_circBufSpace(cbuf, head) >= nbytes)
+   /* check that is enough place, the data is only stored if all bytes fit
+    * in the buffer */
+   if (ciaaLibs_circBufWriteReserve(cbuf, &span, nbytes) == nbytes)
    {
-      rawSpace = ciaaLibs_circBufRawSpace(cbuf, head);
+      ciaaPOSIX_memcpy(span.buf[0], data, span.nbytes[0]);
 
       /* check if wrapping is needed */
-      if (rawSpace >= nbytes)
+      if (0 < span.nbytes[1])
       {
-         ciaaPOSIX_memcpy(ciaaLibs_circBufWritePos(cbuf), data, nbytes);
-      }
-      else
-      {
-         ciaaPOSIX_memcpy((void*)(&cbuf->buf[cbuf->tail]), data, rawSpace);
-         ciaaPOSIX_memcpy((void*)(&cbuf->buf[0]),
-               (void*)((intptr_t)data + rawSpace),
-               nbytes-rawSpace);
+         ciaaPOSIX_memcpy(span.buf[1],
+               (void*)((intptr_t)data + span.nbytes[0]),
+               span.nbytes[1]);
       }
 
-      /* calculate new tail position */
-      ciaaLibs_circBufUpdateTail(cbuf, nbytes);
+      /* calculate and publish the new tail position, the data is visible to
+       * the reader after this point */
+      ciaaLibs_circBufWriteCommit(cbuf, nbytes);
 
       /* set return value */
       ret = nbytes;
@@ -145,43 +267,202 @@ extern size_t ciaaLibs_circBufPut(ciaaLibs_CircBufType * cbuf, void const * data
    return ret;
 } /* end ciaaLibs_circBufPut */
 
-extern size_t ciaaLibs_circBufGet(ciaaLibs_CircBufType * cbuf, void * data, size_t nbytes)
+extern size_t ciaaLibs_circBufPutOverwrite(ciaaLibs_CircBufType * cbuf, void const * data, size_t nbytes)
 {
-   size_t rawCount;
+   size_t space;
 
-   /* the tail of the circular buffer my be changed, therefore it has to be
-    * read only once */
-   size_t tail = cbuf->tail;
+   /* only the last size-1 bytes can be stored */
+   if (nbytes > cbuf->size)
+   {
+      cbuf->dropped += nbytes - cbuf->size;
+      data = (void*)((intptr_t)data + nbytes - cbuf->size);
+      nbytes = cbuf->size;
+   }
 
-   /* if the users tries to read to much data, only available data will be
-    * provided */
-   if (nbytes > ciaaLibs_circBufCount(cbuf, tail))
+   /* drop the oldest bytes to make place for the new ones */
+   space = ciaaLibs_circBufSpace(cbuf, cbuf->head);
+   if (space < nbytes)
    {
-      nbytes = ciaaLibs_circBufCount(cbuf, tail);
+      cbuf->dropped += nbytes - space;
+      ciaaLibs_circBufUpdateHead(cbuf, nbytes - space);
    }
 
+   return ciaaLibs_circBufPut(cbuf, data, nbytes);
+} /* end ciaaLibs_circBufPutOverwrite */
+
+extern size_t ciaaLibs_circBufGet(ciaaLibs_CircBufType * cbuf, void * data, size_t nbytes)
+{
+   ciaaLibs_CircBufSpanType span;
+
+   /* if the users tries to read to much data, only available data will be
+    * provided */
+   nbytes = ciaaLibs_circBufReadReserve(cbuf, &span, nbytes);
+
    /* check if data to be read */
    if (nbytes > 0)
    {
-      rawCount = ciaaLibs_circBufRawCount(cbuf, tail);
+      ciaaPOSIX_memcpy(data, span.buf[0], span.nbytes[0]);
 
-      /* check if all data can be read without wrapping */
-      if (nbytes <= rawCount)
+      /* check if wrapping is needed */
+      if (0 < span.nbytes[1])
       {
-         ciaaPOSIX_memcpy(data, ciaaLibs_circBufReadPos(cbuf), nbytes);
+         ciaaPOSIX_memcpy((void*)((intptr_t)data + span.nbytes[0]),
+               span.buf[1],
+               span.nbytes[1]);
+      }
+
+      /* calculates and publish the new head position, the space is visible
+       * to the writer after this point */
+      ciaaLibs_circBufReadRelease(cbuf, nbytes);
+   }
+
+   return nbytes;
+} /* end ciaaLibs_circBufGet */
+
+extern size_t ciaaLibs_circBufWriteReserve(ciaaLibs_CircBufType * cbuf,
+      ciaaLibs_CircBufSpanType * span, size_t nbytes)
+{
+   /* the head of the circular buffer may be changed by the reader, therefore
+    * it has to be read only once and with acquire semantic */
+   size_t head = ciaaLibs_circBufHead(cbuf);
+   size_t rawSpace = ciaaLibs_circBufRawSpace(cbuf, head);
+
+   /* reserve only the available space */
+   nbytes = ciaaLibs_min(nbytes, ciaaLibs_circBufSpace(cbuf, head));
+
+   /* first span from the tail until the end of the buffer or the head, a
+    * mirrored buffer continues after the end */
+   span->buf[0] = ciaaLibs_circBufWritePos(cbuf);
+   span->nbytes[0] = (1 == cbuf->mirrored) ? nbytes : ciaaLibs_min(nbytes, rawSpace);
+
+   /* second span from the beginning of the buffer if wrapping is needed */
+   span->buf[1] = &cbuf->buf[0];
+   span->nbytes[1] = nbytes - span->nbytes[0];
+
+   return nbytes;
+} /* end ciaaLibs_circBufWriteReserve */
+
+extern size_t ciaaLibs_circBufReadReserve(ciaaLibs_CircBufType * cbuf,
+      ciaaLibs_CircBufSpanType * span, size_t nbytes)
+{
+   /* the tail of the circular buffer my be changed by the writer, therefore
+    * it has to be read only once and with acquire semantic */
+   size_t tail = ciaaLibs_circBufTail(cbuf);
+   size_t rawCount = ciaaLibs_circBufRawCount(cbuf, tail);
+
+   /* reserve only the available data */
+   nbytes = ciaaLibs_min(nbytes, ciaaLibs_circBufCount(cbuf, tail));
+
+   /* first span from the head until the end of the buffer or the tail, a
+    * mirrored buffer continues after the end */
+   span->buf[0] = ciaaLibs_circBufReadPos(cbuf);
+   span->nbytes[0] = (1 == cbuf->mirrored) ? nbytes : ciaaLibs_min(nbytes, rawCount);
+
+   /* second span from the beginning of the buffer if wrapping is needed */
+   span->buf[1] = &cbuf->buf[0];
+   span->nbytes[1] = nbytes - span->nbytes[0];
+
+   return nbytes;
+} /* end ciaaLibs_circBufReadReserve */
+
+extern int32_t ciaaLibs_circBufFind(ciaaLibs_CircBufType * cbuf, size_t offset, uint8_t c)
+{
+   int32_t ret = -1;
+   ciaaLibs_CircBufSpanType span;
+   size_t count = ciaaLibs_circBufReadReserve(cbuf, &span, cbuf->size);
+   size_t pos;
+
+   /* search in the first span */
+   if (offset < span.nbytes[0])
+   {
+      pos = ciaaLibs_circBufMemChr(&span.buf[0][offset], span.nbytes[0] - offset, c);
+      if (pos < (span.nbytes[0] - offset))
+      {
+         ret = (int32_t)(offset + pos);
+      }
+      offset = span.nbytes[0];
+   }
+
+   /* search in the second span if not found */
+   if ( (0 > ret) && (offset < count) )
+   {
+      pos = ciaaLibs_circBufMemChr(&span.buf[1][offset - span.nbytes[0]], count - offset, c);
+      if (pos < (count - offset))
+      {
+         ret = (int32_t)(offset + pos);
+      }
+   }
+
+   return ret;
+} /* end ciaaLibs_circBufFind */
+
+extern int32_t ciaaLibs_circBufFindPair(ciaaLibs_CircBufType * cbuf, size_t offset, uint8_t c0, uint8_t c1)
+{
+   int32_t ret = ciaaLibs_circBufFind(cbuf, offset, c0);
+   uint8_t next = (uint8_t) ~c1;
+
+   /* check the byte after each c0 until the pair is found */
+   while ( (0 <= ret) && (c1 != next) )
+   {
+      if (1 == ciaaLibs_circBufPeek(cbuf, ret + 1, &next, 1))
+      {
+         if (c1 != next)
+         {
+            ret = ciaaLibs_circBufFind(cbuf, ret + 1, c0);
+         }
       }
       else
       {
-         ciaaPOSIX_memcpy(data, ciaaLibs_circBufReadPos(cbuf), rawCount);
-         ciaaPOSIX_memcpy((void*)((intptr_t)data + rawCount), (void*)(&cbuf->buf[0]), nbytes-rawCount);
+         /* c0 is the last byte in the buffer, the pair is not complete */
+         ret = -1;
       }
+   }
 
-      /* calculates new head position */
-      ciaaLibs_circBufUpdateHead(cbuf, nbytes);
+   return ret;
+} /* end ciaaLibs_circBufFindPair */
+
+extern size_t ciaaLibs_circBufPeek(ciaaLibs_CircBufType * cbuf, size_t offset, void * data, size_t nbytes)
+{
+   ciaaLibs_CircBufSpanType span;
+   size_t count = ciaaLibs_circBufReadReserve(cbuf, &span, cbuf->size);
+   size_t first = 0;
+
+   /* only available data after offset is copied */
+   nbytes = (offset < count) ? ciaaLibs_min(nbytes, count - offset) : 0;
+
+   /* copy from the first span until its end */
+   if (offset < span.nbytes[0])
+   {
+      first = ciaaLibs_min(nbytes, span.nbytes[0] - offset);
+      ciaaPOSIX_memcpy(data, &span.buf[0][offset], first);
+      offset = 0;
+   }
+   else
+   {
+      offset -= span.nbytes[0];
+   }
+
+   /* copy the rest from the second span */
+   if (first < nbytes)
+   {
+      ciaaPOSIX_memcpy((void*)((intptr_t)data + first),
+            &span.buf[1][offset],
+            nbytes - first);
    }
 
    return nbytes;
-} /* end ciaaLibs_circBufGet */
+} /* end ciaaLibs_circBufPeek */
+
+extern size_t ciaaLibs_circBufSkip(ciaaLibs_CircBufType * cbuf, size_t nbytes)
+{
+   /* the tail may be changed by the writer, read it only once */
+   size_t tail = ciaaLibs_circBufTail(cbuf);
+
+   nbytes = ciaaLibs_min(nbytes, ciaaLibs_circBufCount(cbuf, tail));
+   ciaaLibs_circBufReadRelease(cbuf, nbytes);
+
+   return nbytes;
+} /* end ciaaLibs_circBufSkip */
 
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -0,0 +1,210 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ * All rights reserved.
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/** \brief Multi Producer Circular Buffer Library source file
+ **
+ ** This library provides a circular buffer for many writers and one reader
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup Libs CIAA Libraries
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "ciaaLibs_CircBufMp.h"
+#include "ciaaLibs_Maths.h"
+#include "ciaaPOSIX_stdlib.h"
+#include "ciaaPOSIX_stdint.h"
+#include "ciaaPOSIX_string.h"
+
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+extern ciaaLibs_CircBufMpType * ciaaLibs_circBufMpNew(size_t nbytes)
+{
+   ciaaLibs_CircBufMpType * ret = NULL;
+
+   /* check that size is at least 8 and power of 2 */
+   if ( (nbytes > 7) && (ciaaLibs_isPowerOfTwo(nbytes)) )
+   {
+      ret = (ciaaLibs_CircBufMpType *) ciaaPOSIX_malloc(sizeof(ciaaLibs_CircBufMpType)+nbytes);
+
+      /* if a valid pointer has been returned */
+      if (NULL != ret)
+      {
+         /* init the buffer */
+         ciaaLibs_circBufMpInit(ret,
+               (void*) ( (intptr_t) ret + sizeof(ciaaLibs_CircBufMpType) ),
+               nbytes);
+      }
+   }
+
+   return ret;
+} /* end ciaaLibs_circBufMpNew */
+
+extern int32_t ciaaLibs_circBufMpInit(ciaaLibs_CircBufMpType * cbuf, void * buf, size_t nbytes)
+{
+   int32_t ret = -1;
+   /* check that size is at least 8 and power of 2 */
+   if ( (nbytes > 7) && (ciaaLibs_isPowerOfTwo(nbytes)) && (NULL != buf) )
+   {
+      /* store the mask of the size and not the size itself */
+      cbuf->size = nbytes-1;
+      /* init the buffer */
+      cbuf->head = 0;
+      cbuf->tail = 0;
+      cbuf->reserve = 0;
+      cbuf->commit = 0;
+      cbuf->buf = buf;
+
+      ret = 1;
+   }
+
+   return ret;
+} /* end ciaaLibs_circBufMpInit */
+
+extern void ciaaLibs_circBufMpRel(ciaaLibs_CircBufMpType * cbuf)
+{
+   /* free reserved memory */
+   ciaaPOSIX_free(cbuf);
+} /* end ciaaLibs_circBufMpRel */
+
+extern size_t ciaaLibs_circBufMpPut(ciaaLibs_CircBufMpType * cbuf, void const * data, size_t nbytes)
+{
+   size_t ret = 0;
+   size_t reserve = ciaaLibs_atomicLoadAcquire(&cbuf->reserve);
+   size_t space;
+   size_t pos;
+   size_t rawSpace;
+   size_t commit;
+   size_t tail;
+
+   /* reserve nbytes, the compare and swap fails if another writer has
+    * reserved in between, in this case reserve holds the new value and the
+    * free space is checked again */
+   do
+   {
+      space = cbuf->size + 1 -
+         (reserve - ciaaLibs_atomicLoadAcquire(&cbuf->head));
+   } while ( (0 < nbytes) && (nbytes <= space) &&
+         (!ciaaLibs_atomicCas(&cbuf->reserve, &reserve, reserve + nbytes)) );
+
+   /* the data is only stored if all bytes fit in the buffer */
+   if ( (0 < nbytes) && (nbytes <= space) )
+   {
+      /* copy the data to the reserved space, wrapping if needed */
+      pos = reserve & cbuf->size;
+      rawSpace = ciaaLibs_min(nbytes, cbuf->size + 1 - pos);
+      ciaaPOSIX_memcpy(&cbuf->buf[pos], data, rawSpace);
+      if (rawSpace < nbytes)
+      {
+         ciaaPOSIX_memcpy(&cbuf->buf[0],
+               (void*)((intptr_t)data + rawSpace),
+               nbytes - rawSpace);
+      }
+
+      /* commit the written bytes, if no other writer has pending data all
+       * reserved bytes are written and can be published */
+      commit = ciaaLibs_atomicAdd(&cbuf->commit, nbytes);
+      if (commit == ciaaLibs_atomicLoadAcquire(&cbuf->reserve))
+      {
+         /* publish the tail, a writer which committed later may have
+          * already published a newer tail which shall not be overwritten */
+         tail = ciaaLibs_atomicLoadAcquire(&cbuf->tail);
+         while ( (0 < (commit - tail)) &&
+               ((commit - tail) <= (cbuf->size + 1)) &&
+               (!ciaaLibs_atomicCas(&cbuf->tail, &tail, commit)) )
+         {
+            /* the tail has been updated by another writer, check again */
+         }
+      }
+
+      /* set return value */
+      ret = nbytes;
+   }
+
+   return ret;
+} /* end ciaaLibs_circBufMpPut */
+
+extern size_t ciaaLibs_circBufMpGet(ciaaLibs_CircBufMpType * cbuf, void * data, size_t nbytes)
+{
+   /* the tail may be changed by the writers, therefore it has to be read
+    * only once and with acquire semantic */
+   size_t tail = ciaaLibs_atomicLoadAcquire(&cbuf->tail);
+   size_t pos = cbuf->head & cbuf->size;
+   size_t rawCount;
+
+   /* if the users tries to read to much data, only available data will be
+    * provided */
+   nbytes = ciaaLibs_min(nbytes, tail - cbuf->head);
+
+   /* check if data to be read */
+   if (nbytes > 0)
+   {
+      rawCount = ciaaLibs_min(nbytes, cbuf->size + 1 - pos);
+      ciaaPOSIX_memcpy(data, &cbuf->buf[pos], rawCount);
+
+      /* check if wrapping is needed */
+      if (rawCount < nbytes)
+      {
+         ciaaPOSIX_memcpy((void*)((intptr_t)data + rawCount),
+               &cbuf->buf[0],
+               nbytes - rawCount);
+      }
+
+      /* publish the new head, the space is visible to the writers after
+       * this point */
+      ciaaLibs_atomicStoreRelease(&cbuf->head, cbuf->head + nbytes);
+   }
+
+   return nbytes;
+} /* end ciaaLibs_circBufMpGet */
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+
@@ -43,6 +43,7 @@
  ** @{ */
 
 /*==================[inclusions]=============================================*/
+#include "ciaaLibs_Maths.h"
 #include "ciaaPOSIX_stdlib.h"
 
 /*==================[macros and definitions]=================================*/
@@ -60,33 +61,76 @@
 /*==================[external functions definition]==========================*/
 extern int8_t ciaaLibs_getFirstNotSetBit(uint32_t value)
 {
-   uint32_t mask = 0xffffffffu;
-   bool found = false;
-   uint8_t searchSize = 16;
-   uint8_t searchPos = 0;
-
-   if (mask != value) {
-      while(false == found)
-      {
-         /* check if one or more bits are 0 */
-         if (((mask >> (32-searchSize)) << searchPos) !=
-               (value & ((mask >> (32-searchSize)) << searchPos))) {
-            if (1 != searchSize) {
-               searchSize >>= 1;
-            } else {
-               found = true;
-            }
-         } else {
-            searchPos += searchSize;
-         }
+   int8_t ret = -1;
+
+   /* the first not set bit is the first set bit of the complement */
+   if (0xffffffffu != value) {
+      ret = (int8_t)ciaaLibs_ctz(~value);
+   }
+
+   return ret;
+}
+
+extern uint8_t ciaaLibs_ctzPortable(uint32_t value)
+{
+   uint8_t ret = 32;
+
+   if (0 != value) {
+      ret = 0;
+      /* halve the searched part of the word on each step */
+      if (0 == (value & 0x0000ffffu)) {
+         ret += 16;
+         value >>= 16;
+      }
+      if (0 == (value & 0x000000ffu)) {
+         ret += 8;
+         value >>= 8;
+      }
+      if (0 == (value & 0x0000000fu)) {
+         ret += 4;
+         value >>= 4;
+      }
+      if (0 == (value & 0x00000003u)) {
+         ret += 2;
+         value >>= 2;
+      }
+      if (0 == (value & 0x00000001u)) {
+         ret += 1;
       }
    }
 
-   if (false == found) {
-      searchPos = -1;
+   return ret;
+}
+
+extern uint8_t ciaaLibs_clzPortable(uint32_t value)
+{
+   uint8_t ret = 32;
+
+   if (0 != value) {
+      ret = 0;
+      /* halve the searched part of the word on each step */
+      if (0 == (value & 0xffff0000u)) {
+         ret += 16;
+         value <<= 16;
+      }
+      if (0 == (value & 0xff000000u)) {
+         ret += 8;
+         value <<= 8;
+      }
+      if (0 == (value & 0xf0000000u)) {
+         ret += 4;
+         value <<= 4;
+      }
+      if (0 == (value & 0xc0000000u)) {
+         ret += 2;
+         value <<= 2;
+      }
+      if (0 == (value & 0x80000000u)) {
+         ret += 1;
+      }
    }
 
-   return searchPos;
+   return ret;
 }
 
 /** @} doxygen end group definition */
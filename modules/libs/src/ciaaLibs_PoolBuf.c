@@ -45,6 +45,7 @@
 /*==================[inclusions]=============================================*/
 #include "ciaaLibs_PoolBuf.h"
 #include "ciaaLibs_Maths.h"
+#include "ciaaLibs_Atomic.h"
 #include "ciaaPOSIX_string.h"
 
 /*==================[macros and definitions]=================================*/
@@ -62,12 +63,13 @@
 
 /*==================[external functions definition]==========================*/
 extern int32_t ciaaLibs_poolBufInit(ciaaLibs_poolBufType * pbuf,
-      void * buf, uint32_t * statusPtr, size_t poolSize, size_t elementSize)
+      void * buf, uint32_t * statusPtr, uint32_t * summaryPtr,
+      size_t poolSize, size_t elementSize)
 {
    int32_t ret = 1;
    uint32_t i;
 
-   /* all 3 buffers shall be valid */
+   /* all 4 buffers shall be valid */
    if (NULL == pbuf) {
       ret = -1;
    }
@@ -77,18 +79,27 @@ extern int32_t ciaaLibs_poolBufInit(ciaaLibs_poolBufType * pbuf,
    if (NULL == statusPtr) {
       ret = -1;
    }
+   if (NULL == summaryPtr) {
+      ret = -1;
+   }
 
    /* if not errors are found perform the initialization */
    if (1 == ret) {
       pbuf->buf = buf;
       pbuf->statusPtr = statusPtr;
+      pbuf->summaryPtr = summaryPtr;
       pbuf->poolSize = poolSize;
       pbuf->elementSize = elementSize;
 
-      for(i = 0; i < (poolSize >> 5); i++) {
+      for(i = 0; i < CIAALIBS_POOLSTATUSSIZE(poolSize); i++) {
          /* indicate that all elements are free and not beeing used */
          pbuf->statusPtr[i] = 0;
       }
+
+      for(i = 0; i < CIAALIBS_POOLSUMMARYSIZE(poolSize); i++) {
+         /* indicate that no status word is full */
+         pbuf->summaryPtr[i] = 0;
+      }
    }
 
    return ret;
@@ -99,37 +110,68 @@ extern void * ciaaLibs_poolBufLock(ciaaLibs_poolBufType * pbuf)
    void * ret = NULL;
    uint32_t i; /** <= variable for the loop */
    uint32_t loopCount;
+   uint32_t statusCount;
+   uint32_t summary; /** <= local copy of the summary word */
+   uint32_t status; /** <= local copy of the status word */
+   uint32_t word; /** <= status word with a free element */
+   uint32_t wordMask; /** <= bit of word in the summary word */
    uint32_t freePos = 0; /** variable to indicate which position is free */
-   int8_t pos;
    bool found = false;
 
-   loopCount = (pbuf->poolSize + 31 ) >> 5;
-
-   /* enter critical section */
+   loopCount = CIAALIBS_POOLSUMMARYSIZE(pbuf->poolSize);
+   statusCount = CIAALIBS_POOLSTATUSSIZE(pbuf->poolSize);
 
+   /* each summary word covers 1024 elements, pools up to this size are
+    * resolved in the first iteration. The summary is only a hint, a not
+    * full word may become full before it is claimed, in this case the word
+    * is skipped in the local copy and the next one is tried. */
    for(i = 0; (i < loopCount) && (false == found); i++) {
-      pos = ciaaLibs_getFirstNotSetBit(pbuf->statusPtr[i]);
-      if (-1 != pos) {
-         freePos += pos;
-         found = true;
-      } else {
-         /* no free place in the first 32 positions */
-         freePos += 32;
+      summary = ciaaLibs_atomicLoadAcquire(&pbuf->summaryPtr[i]);
+
+      while((false == found) && (0xffffffffu != summary)) {
+         word = (i << 5) + ciaaLibs_ctz(~summary);
+         wordMask = (uint32_t)1 << (word & 0x1f);
+         summary |= wordMask;
+
+         /* the summary bits after the last status word are never set */
+         if (word < statusCount) {
+            status = ciaaLibs_atomicLoadAcquire(&pbuf->statusPtr[word]);
+
+            while((false == found) && (0xffffffffu != status)) {
+               freePos = (word << 5) + ciaaLibs_ctz(~status);
+
+               if (freePos >= pbuf->poolSize) {
+                  /* the unused bits of the last status word are never set */
+                  status = 0xffffffffu;
+               } else if (ciaaLibs_atomicCas(&pbuf->statusPtr[word], &status,
+                     status | ((uint32_t)1 << (freePos & 0x1f)))) {
+                  /* the element is reserved */
+                  found = true;
+                  status |= (uint32_t)1 << (freePos & 0x1f);
+               } else {
+                  /* status has been updated with the current value, try
+                   * again with the next free element */
+               }
+            }
+
+            if ((true == found) && (0xffffffffu == status)) {
+               /* mark the word as full, if an element has been freed in the
+                * meanwhile undo it, a free performed after the check
+                * clears the bit itself */
+               ciaaLibs_atomicFetchOr(&pbuf->summaryPtr[i], wordMask);
+               ciaaLibs_memoryBarrier();
+               if (0xffffffffu !=
+                     ciaaLibs_atomicLoadAcquire(&pbuf->statusPtr[word])) {
+                  ciaaLibs_atomicFetchAnd(&pbuf->summaryPtr[i], ~wordMask);
+               }
+            }
+         }
       }
    }
 
-   /* if found and the found free element is within the size */
-   if ((true == found) && (freePos < pbuf->poolSize))
-   {
-      /* reserve the element in the pool */
-      ciaaLibs_setBit(pbuf->statusPtr[i-1], freePos & 0x1f);
-
-      /* exit critical section */
-
+   if (true == found) {
       /* get element address */
       ret = (void*) &pbuf->buf[freePos * pbuf->elementSize];
-   } else {
-      /* exit critical section */
    }
 
    return ret;
@@ -137,16 +179,27 @@ extern void * ciaaLibs_poolBufLock(ciaaLibs_poolBufType * pbuf)
 
 extern size_t ciaaLibs_poolBufFree(ciaaLibs_poolBufType * pbuf, void * data)
 {
-   /* if data is smaller pbuf->buf this will crash, but it shall never
-    * happens. */
+   size_t ret = 0;
    uintptr_t diff = (uintptr_t)data - (uintptr_t)(pbuf->buf);
-
    size_t element = diff / pbuf->elementSize;
+   uint32_t mask = (uint32_t)1 << (element & 0x1f);
+   uint32_t status;
+
+   /* data shall point to the beginning of an element of the pool, if data
+    * is smaller than pbuf->buf diff wraps to a big value */
+   if ((element < pbuf->poolSize) && (0 == (diff % pbuf->elementSize))) {
+      /* free the element, if it was not being used nothing is changed */
+      status = ciaaLibs_atomicFetchAnd(&pbuf->statusPtr[element >> 5], ~mask);
+
+      if (0 != (status & mask)) {
+         /* its status word is not full anymore */
+         ciaaLibs_atomicFetchAnd(&pbuf->summaryPtr[element >> 10],
+               ~((uint32_t)1 << ((element >> 5) & 0x1f)));
+         ret = 1;
+      }
+   }
 
-   /* free the element */
-   ciaaLibs_clearBit(pbuf->statusPtr[element>>5], element & 0x1f);
-
-   return 1;
+   return ret;
 } /* end of ciaaLibs_poolBufFree */
 
 /** @} doxygen end group definition */
@@ -0,0 +1,161 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ * All rights reserved.
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** \brief Pool List Library sources
+ **
+ ** This library provides a pool of elements linked in a free list
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup Libs CIAA Libraries
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "ciaaLibs_PoolList.h"
+#include "ciaaLibs_PoolBuf.h"
+
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+extern int32_t ciaaLibs_poolListInit(ciaaLibs_poolListType * plist,
+      void * buf, uint32_t * statusPtr, size_t poolSize, size_t elementSize)
+{
+   int32_t ret = 1;
+   uint32_t i;
+
+   /* all 3 buffers shall be valid */
+   if (NULL == plist) {
+      ret = -1;
+   }
+   if (NULL == buf) {
+      ret = -1;
+   }
+   if (NULL == statusPtr) {
+      ret = -1;
+   }
+
+   /* each element and the buffer shall be able to store a pointer */
+   if ((0 == elementSize) || (0 != (elementSize % sizeof(void *)))) {
+      ret = -1;
+   }
+   if (0 != ((uintptr_t)buf % sizeof(void *))) {
+      ret = -1;
+   }
+
+   /* if not errors are found perform the initialization */
+   if (1 == ret) {
+      plist->buf = buf;
+      plist->statusPtr = statusPtr;
+      plist->poolSize = poolSize;
+      plist->elementSize = elementSize;
+
+      /* the elements are linked to the list when they are freed */
+      plist->head = NULL;
+      plist->unused = 0;
+
+      for(i = 0; i < CIAALIBS_POOLSTATUSSIZE(poolSize); i++) {
+         /* indicate that all elements are free and not beeing used */
+         plist->statusPtr[i] = 0;
+      }
+   }
+
+   return ret;
+} /* end of ciaaLibs_poolListInit */
+
+extern void * ciaaLibs_poolListLock(ciaaLibs_poolListType * plist)
+{
+   uint8_t * ret = NULL;
+   size_t element;
+
+   if (NULL != plist->head) {
+      /* pop the first freed element */
+      ret = plist->head;
+      plist->head = *(void **)ret;
+   } else if (plist->unused < plist->poolSize) {
+      /* take the next never used element */
+      ret = &plist->buf[plist->unused * plist->elementSize];
+      plist->unused++;
+   } else {
+      /* pool is full */
+   }
+
+   if (NULL != ret) {
+      /* mark the element as used */
+      element = (size_t)(ret - plist->buf) / plist->elementSize;
+      plist->statusPtr[element >> 5] |= (uint32_t)1 << (element & 0x1f);
+   }
+
+   return ret;
+} /* end of ciaaLibs_poolListLock */
+
+extern size_t ciaaLibs_poolListFree(ciaaLibs_poolListType * plist, void * data)
+{
+   size_t ret = 0;
+   uintptr_t diff = (uintptr_t)data - (uintptr_t)(plist->buf);
+   size_t element = diff / plist->elementSize;
+   uint32_t mask = (uint32_t)1 << (element & 0x1f);
+
+   /* data shall point to the beginning of an used element of the pool, if
+    * data is smaller than plist->buf diff wraps to a big value */
+   if ((element < plist->poolSize) &&
+         (0 == (diff % plist->elementSize)) &&
+         (0 != (plist->statusPtr[element >> 5] & mask))) {
+      plist->statusPtr[element >> 5] &= ~mask;
+
+      /* push the element to the list of freed elements */
+      *(void **)data = plist->head;
+      plist->head = data;
+
+      ret = 1;
+   }
+
+   return ret;
+} /* end of ciaaLibs_poolListFree */
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+
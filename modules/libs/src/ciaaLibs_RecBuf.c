@@ -0,0 +1,266 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ * All rights reserved.
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/** \brief Record Buffer Library source file
+ **
+ ** This library provides a queue of variable length records
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup Libs CIAA Libraries
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "ciaaLibs_RecBuf.h"
+#include "ciaaLibs_CircBuf.h"
+#include "ciaaLibs_Maths.h"
+#include "ciaaPOSIX_stdlib.h"
+#include "ciaaPOSIX_stdint.h"
+#include "ciaaPOSIX_string.h"
+
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+/** \brief write data to the spans of a circular buffer
+ **
+ ** \param[in] span spans reserved to write
+ ** \param[in] offset offset within the spans to write the data
+ ** \param[in] data data to be written
+ ** \param[in] nbytes count of bytes to be written
+ **/
+static void ciaaLibs_recBufSpanWrite(ciaaLibs_CircBufSpanType const * span,
+      size_t offset, void const * data, size_t nbytes);
+
+/** \brief read data from the spans of a circular buffer
+ **
+ ** \param[in] span spans reserved to read
+ ** \param[in] offset offset within the spans to read the data
+ ** \param[out] data pointer to store the read data
+ ** \param[in] nbytes count of bytes to be read
+ **/
+static void ciaaLibs_recBufSpanRead(ciaaLibs_CircBufSpanType const * span,
+      size_t offset, void * data, size_t nbytes);
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static void ciaaLibs_recBufSpanWrite(ciaaLibs_CircBufSpanType const * span,
+      size_t offset, void const * data, size_t nbytes)
+{
+   size_t first = 0;
+
+   /* write in the first span until its end */
+   if (offset < span->nbytes[0])
+   {
+      first = ciaaLibs_min(nbytes, span->nbytes[0] - offset);
+      ciaaPOSIX_memcpy(&span->buf[0][offset], data, first);
+      offset = 0;
+   }
+   else
+   {
+      offset -= span->nbytes[0];
+   }
+
+   /* write the rest in the second span */
+   if (first < nbytes)
+   {
+      ciaaPOSIX_memcpy(&span->buf[1][offset],
+            (void*)((intptr_t)data + first),
+            nbytes - first);
+   }
+} /* end ciaaLibs_recBufSpanWrite */
+
+static void ciaaLibs_recBufSpanRead(ciaaLibs_CircBufSpanType const * span,
+      size_t offset, void * data, size_t nbytes)
+{
+   size_t first = 0;
+
+   /* read from the first span until its end */
+   if (offset < span->nbytes[0])
+   {
+      first = ciaaLibs_min(nbytes, span->nbytes[0] - offset);
+      ciaaPOSIX_memcpy(data, &span->buf[0][offset], first);
+      offset = 0;
+   }
+   else
+   {
+      offset -= span->nbytes[0];
+   }
+
+   /* read the rest from the second span */
+   if (first < nbytes)
+   {
+      ciaaPOSIX_memcpy((void*)((intptr_t)data + first),
+            &span->buf[1][offset],
+            nbytes - first);
+   }
+} /* end ciaaLibs_recBufSpanRead */
+
+/*==================[external functions definition]==========================*/
+extern ciaaLibs_RecBufType * ciaaLibs_recBufNew(size_t nbytes)
+{
+   ciaaLibs_RecBufType * ret = NULL;
+
+   /* check that size is at least 8 and power of 2 */
+   if ( (nbytes > 7) && (ciaaLibs_isPowerOfTwo(nbytes)) )
+   {
+      ret = (ciaaLibs_RecBufType *) ciaaPOSIX_malloc(sizeof(ciaaLibs_RecBufType)+nbytes);
+
+      /* if a valid pointer has been returned */
+      if (NULL != ret)
+      {
+         /* init the buffer */
+         ciaaLibs_recBufInit(ret,
+               (void*) ( (intptr_t) ret + sizeof(ciaaLibs_RecBufType) ),
+               nbytes);
+      }
+   }
+
+   return ret;
+} /* end ciaaLibs_recBufNew */
+
+extern int32_t ciaaLibs_recBufInit(ciaaLibs_RecBufType * rbuf, void * buf, size_t nbytes)
+{
+   rbuf->dropped = 0;
+
+   return ciaaLibs_circBufInit(&rbuf->cbuf, buf, nbytes);
+} /* end ciaaLibs_recBufInit */
+
+extern void ciaaLibs_recBufRel(ciaaLibs_RecBufType * rbuf)
+{
+   /* free reserved memory */
+   ciaaPOSIX_free(rbuf);
+} /* end ciaaLibs_recBufRel */
+
+extern size_t ciaaLibs_recBufPut(ciaaLibs_RecBufType * rbuf, void const * data, size_t nbytes)
+{
+   size_t ret = 0;
+   uint16_t length = (uint16_t) nbytes;
+   ciaaLibs_CircBufSpanType span;
+
+   /* the record is only stored if the header and the data fit in the
+    * buffer */
+   if ( (0 < nbytes) && (ciaaLibs_RECBUF_MAXLENGTH >= nbytes) &&
+        ( (ciaaLibs_RECBUF_HEADER + nbytes) ==
+          ciaaLibs_circBufWriteReserve(&rbuf->cbuf, &span,
+             ciaaLibs_RECBUF_HEADER + nbytes) ) )
+   {
+      ciaaLibs_recBufSpanWrite(&span, 0, &length, ciaaLibs_RECBUF_HEADER);
+      ciaaLibs_recBufSpanWrite(&span, ciaaLibs_RECBUF_HEADER, data, nbytes);
+
+      /* header and data are published together */
+      ciaaLibs_circBufWriteCommit(&rbuf->cbuf, ciaaLibs_RECBUF_HEADER + nbytes);
+
+      /* set return value */
+      ret = nbytes;
+   }
+
+   return ret;
+} /* end ciaaLibs_recBufPut */
+
+extern size_t ciaaLibs_recBufPutOverwrite(ciaaLibs_RecBufType * rbuf, void const * data, size_t nbytes)
+{
+   size_t ret = 0;
+   ciaaLibs_CircBufSpanType span;
+
+   /* the record has to fit in the empty buffer */
+   if ( (0 < nbytes) && (ciaaLibs_RECBUF_MAXLENGTH >= nbytes) &&
+        ( (ciaaLibs_RECBUF_HEADER + nbytes) <= rbuf->cbuf.size ) )
+   {
+      /* drop the oldest records until the new one fits */
+      while ( (ciaaLibs_RECBUF_HEADER + nbytes) >
+            ciaaLibs_circBufWriteReserve(&rbuf->cbuf, &span,
+               ciaaLibs_RECBUF_HEADER + nbytes) )
+      {
+         ciaaLibs_circBufReadRelease(&rbuf->cbuf,
+               ciaaLibs_RECBUF_HEADER + ciaaLibs_recBufPeekNextLength(rbuf));
+         rbuf->dropped++;
+      }
+
+      ret = ciaaLibs_recBufPut(rbuf, data, nbytes);
+   }
+
+   return ret;
+} /* end ciaaLibs_recBufPutOverwrite */
+
+extern size_t ciaaLibs_recBufPeekNextLength(ciaaLibs_RecBufType * rbuf)
+{
+   uint16_t length = 0;
+   ciaaLibs_CircBufSpanType span;
+
+   /* a header is only available together with the data of its record */
+   if (ciaaLibs_RECBUF_HEADER ==
+         ciaaLibs_circBufReadReserve(&rbuf->cbuf, &span, ciaaLibs_RECBUF_HEADER))
+   {
+      ciaaLibs_recBufSpanRead(&span, 0, &length, ciaaLibs_RECBUF_HEADER);
+   }
+
+   return length;
+} /* end ciaaLibs_recBufPeekNextLength */
+
+extern size_t ciaaLibs_recBufGet(ciaaLibs_RecBufType * rbuf, void * data, size_t nbytes)
+{
+   size_t ret = 0;
+   size_t length = ciaaLibs_recBufPeekNextLength(rbuf);
+   ciaaLibs_CircBufSpanType span;
+
+   /* check that a record is available and fits in data */
+   if ( (0 < length) && (length <= nbytes) )
+   {
+      /* the whole record has been committed with its header */
+      ciaaLibs_circBufReadReserve(&rbuf->cbuf, &span,
+            ciaaLibs_RECBUF_HEADER + length);
+      ciaaLibs_recBufSpanRead(&span, ciaaLibs_RECBUF_HEADER, data, length);
+
+      /* release the header and the data */
+      ciaaLibs_circBufReadRelease(&rbuf->cbuf, ciaaLibs_RECBUF_HEADER + length);
+
+      /* set return value */
+      ret = length;
+   }
+
+   return ret;
+} /* end ciaaLibs_recBufGet */
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+
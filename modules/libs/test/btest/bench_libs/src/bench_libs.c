@@ -0,0 +1,522 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ * All rights reserved.
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/** \brief Benchmark of the CIAA Libraries
+ **
+ ** Measures the performance of the data structures and kernels of
+ ** modules/libs on the ciaa_sim_ia32 target. Each measurement is repeated
+ ** BENCH_REPEAT times and the fastest run is reported, one line per
+ ** measurement with comma separated values:
+ **
+ ** benchmark,variant,param,ops,ns_per_op,bytes_per_s
+ **
+ ** - benchmark: name of the measured function
+ ** - variant: what is changed between the measurements (eg. fill)
+ ** - param: value of the variant (eg. fill level in percent)
+ ** - ops: count of operations of each run
+ ** - ns_per_op: time of each operation in ns
+ ** - bytes_per_s: throughput, 0 if not applicable
+ **
+ ** The output can be stored and compared between two versions to find
+ ** performance regressions.
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup Libs CIAA Libraries
+ ** @{ */
+/** \addtogroup Benchmarks Benchmarks
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "os.h"
+#include "ciaaPOSIX_stdio.h"
+#include "ciaaPOSIX_string.h"
+#include "ciaak.h"
+#include "ciaaLibs_CircBuf.h"
+#include "ciaaLibs_PoolBuf.h"
+#include "ciaaLibs_PoolList.h"
+#include "ciaaLibs_Maths.h"
+#include "ciaaLibs_Matrix.h"
+
+#if (x86 == ARCH)
+#include "time.h"
+#else
+#error the libs benchmark is only supported for ARCH x86
+#endif
+
+/*==================[macros and definitions]=================================*/
+/** \brief count of runs of each measurement, the fastest one is reported */
+#define BENCH_REPEAT             5
+
+/** \brief size of the circular buffers, multiple of the page size */
+#define BENCH_CIRCBUF_SIZE       (64 * 1024)
+
+/** \brief count of bytes transfered by each circular buffer measurement */
+#define BENCH_CIRCBUF_BYTES      (16 * 1024 * 1024)
+
+/** \brief maximal chunk size of the circular buffer measurements */
+#define BENCH_CIRCBUF_MAXCHUNK   (4096)
+
+/** \brief chunk size of the fill level and wrap position measurements */
+#define BENCH_CIRCBUF_CHUNK      (256)
+
+/** \brief count of elements of the pool buffer */
+#define BENCH_POOLBUF_SIZE       (1024)
+
+/** \brief count of operations of the pool buffer measurements */
+#define BENCH_POOLBUF_OPS        (1024 * 1024)
+
+/** \brief count of operations of the first not set bit measurements */
+#define BENCH_BIT_OPS            (16 * 1024 * 1024)
+
+/** \brief maximal count of rows and columns of the matrix measurements */
+#define BENCH_MATRIX_MAXN        (32)
+
+/** \brief count of floats processed by each matrix measurement */
+#define BENCH_MATRIX_FLOPS       (16 * 1024 * 1024)
+
+/** \brief count of elements of an array */
+#define BENCH_COUNT(array)       (sizeof(array) / sizeof((array)[0]))
+
+/*==================[internal data declaration]==============================*/
+/** \brief function to be measured
+ **
+ ** \param[in] arg argument of the measurement
+ ** \param[in] ops count of operations to be performed
+ **/
+typedef void (* bench_fctType)(void * arg, uint32_t ops);
+
+/** \brief argument of the circular buffer measurements */
+typedef struct {
+   ciaaLibs_CircBufType * cbuf;  /** <= buffer to be measured */
+   size_t chunk;                 /** <= bytes of each put and get */
+   size_t fill;                  /** <= bytes stored before the measurement */
+   size_t pos;                   /** <= head and tail position before each
+                                        operation, > size for free running */
+} bench_circBufArgType;
+
+/** \brief argument of the pool buffer measurements */
+typedef struct {
+   ciaaLibs_poolBufType * pbuf;  /** <= pool to be measured */
+   size_t fill;                  /** <= elements locked before measuring */
+} bench_poolBufArgType;
+
+/** \brief argument of the matrix measurements */
+typedef struct {
+   ciaaLibs_matrix_t src1;       /** <= first operand */
+   ciaaLibs_matrix_t src2;       /** <= second operand */
+   ciaaLibs_matrix_t dst;        /** <= result */
+} bench_matrixArgType;
+
+/*==================[internal functions declaration]=========================*/
+/** \brief get a monotonic time stamp
+ **
+ ** \return time stamp in ns
+ **/
+static uint64_t bench_now(void);
+
+/** \brief measure a function
+ **
+ ** Calls fct BENCH_REPEAT times and prints the fastest run.
+ **
+ ** \param[in] benchmark name of the benchmark
+ ** \param[in] variant variant of the benchmark
+ ** \param[in] param parameter of the measurement
+ ** \param[in] fct function to be measured
+ ** \param[in] arg argument of fct
+ ** \param[in] ops count of operations of each run
+ ** \param[in] bytesPerOp bytes processed by each operation, 0 if not
+ **                       applicable
+ **/
+static void bench_measure(char const * benchmark, char const * variant,
+      uint32_t param, bench_fctType fct, void * arg, uint32_t ops,
+      uint32_t bytesPerOp);
+
+/** \brief put and get chunks of a circular buffer */
+static void bench_circBufPutGet(void * arg, uint32_t ops);
+
+/** \brief lock and free an element of a pool buffer */
+static void bench_poolBufLockFree(void * arg, uint32_t ops);
+
+/** \brief lock and free an element of a pool list */
+static void bench_poolListLockFree(void * arg, uint32_t ops);
+
+/** \brief find the first not set bit of a value */
+static void bench_getFirstNotSetBit(void * arg, uint32_t ops);
+
+/** \brief add two float matrices */
+static void bench_matrixAdd(void * arg, uint32_t ops);
+
+/** \brief multiply two float matrices */
+static void bench_matrixMul(void * arg, uint32_t ops);
+
+/** \brief measure a circular buffer with all chunk sizes, fill levels and
+ **        wrap positions
+ **
+ ** \param[in] cbuf circular buffer to be measured
+ ** \param[in] variants names of the variants for the chunk sizes, the fill
+ **                     levels and the wrap positions
+ **/
+static void bench_circBuf(ciaaLibs_CircBufType * cbuf, char const * const variants[3]);
+
+/*==================[internal data definition]===============================*/
+/** \brief memory of the split circular buffer */
+static uint8_t bench_circBufMem[BENCH_CIRCBUF_SIZE];
+
+/** \brief data to be written and read */
+static uint8_t bench_data[BENCH_CIRCBUF_MAXCHUNK];
+
+/** \brief chunk sizes of the circular buffer measurements */
+static size_t const bench_circBufChunks[] = { 1, 7, 16, 61, 256, 1021, 4096 };
+
+/** \brief fill levels in percent of the circular and pool buffers */
+static size_t const bench_fillLevels[] = { 0, 50, 90 };
+
+/** \brief wrap positions relative to the end of the circular buffer */
+static size_t const bench_wrapPositions[] = { 0, 1, 3, BENCH_CIRCBUF_CHUNK / 2, BENCH_CIRCBUF_CHUNK - 1 };
+
+/** \brief variants of the split circular buffer measurements */
+static char const * const bench_splitVariants[3] = { "split", "split_fill", "split_wrap" };
+
+/** \brief variants of the mirrored circular buffer measurements */
+static char const * const bench_mirroredVariants[3] = { "mirrored", "mirrored_fill", "mirrored_wrap" };
+
+/** \brief values for the first not set bit measurements */
+static uint32_t const bench_bitValues[] = { 0x00000000u, 0x000000FFu, 0x0000FFFFu, 0x7FFFFFFFu, 0xFFFFFFFFu };
+
+/** \brief sizes of the matrix measurements */
+static uint16_t const bench_matrixSizes[] = { 4, 8, 16, BENCH_MATRIX_MAXN };
+
+/** \brief pool buffer to be measured */
+CIAALIBS_POOLDECLARE(bench_pool, uint32_t, BENCH_POOLBUF_SIZE)
+
+/** \brief pool list to be measured */
+CIAALIBS_POOLLISTDECLARE(bench_list, uint32_t, BENCH_POOLBUF_SIZE)
+
+/** \brief matrices data */
+static float bench_matrixData[3][BENCH_MATRIX_MAXN * BENCH_MATRIX_MAXN];
+
+/** \brief result of the measured functions, avoids optimizing them out */
+static volatile uint32_t bench_sink;
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static uint64_t bench_now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+
+   return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_measure(char const * benchmark, char const * variant,
+      uint32_t param, bench_fctType fct, void * arg, uint32_t ops,
+      uint32_t bytesPerOp)
+{
+   uint64_t best = UINT64_MAX;
+   uint64_t start;
+   uint64_t ns;
+   uint32_t loopi;
+
+   for(loopi = 0; loopi < BENCH_REPEAT; loopi++)
+   {
+      start = bench_now();
+      fct(arg, ops);
+      ns = bench_now() - start;
+      best = ciaaLibs_min(best, ns);
+   }
+
+   /* avoid divisions by 0 for too fast measurements */
+   best = (0 == best) ? 1 : best;
+
+   ciaaPOSIX_printf("%s,%s,%u,%u,%.3f,%.0f\n", benchmark, variant, param, ops,
+         (double)best / (double)ops,
+         ((double)ops * (double)bytesPerOp * 1000000000.0) / (double)best);
+}
+
+static void bench_circBufPutGet(void * arg, uint32_t ops)
+{
+   bench_circBufArgType * bench = (bench_circBufArgType *) arg;
+   ciaaLibs_CircBufType * cbuf = bench->cbuf;
+   uint32_t loopi;
+
+   /* store the data of the fill level */
+   ciaaLibs_circBufClean(cbuf);
+   for(loopi = 0; loopi < bench->fill; loopi += BENCH_CIRCBUF_MAXCHUNK)
+   {
+      ciaaLibs_circBufPut(cbuf, bench_data,
+            ciaaLibs_min(BENCH_CIRCBUF_MAXCHUNK, bench->fill - loopi));
+   }
+
+   for(loopi = 0; loopi < ops; loopi++)
+   {
+      /* move head and tail to the requested position */
+      if (bench->pos <= cbuf->size)
+      {
+         cbuf->head = bench->pos;
+         cbuf->tail = bench->pos;
+      }
+
+      ciaaLibs_circBufPut(cbuf, bench_data, bench->chunk);
+      ciaaLibs_circBufGet(cbuf, bench_data, bench->chunk);
+   }
+}
+
+static void bench_poolBufLockFree(void * arg, uint32_t ops)
+{
+   bench_poolBufArgType * bench = (bench_poolBufArgType *) arg;
+   uint32_t loopi;
+   void * data;
+
+   for(loopi = 0; loopi < ops; loopi++)
+   {
+      data = ciaaLibs_poolBufLock(bench->pbuf);
+      ciaaLibs_poolBufFree(bench->pbuf, data);
+   }
+}
+
+static void bench_poolListLockFree(void * arg, uint32_t ops)
+{
+   ciaaLibs_poolListType * plist = (ciaaLibs_poolListType *) arg;
+   uint32_t loopi;
+   void * data;
+
+   for(loopi = 0; loopi < ops; loopi++)
+   {
+      data = ciaaLibs_poolListLock(plist);
+      ciaaLibs_poolListFree(plist, data);
+   }
+}
+
+static void bench_getFirstNotSetBit(void * arg, uint32_t ops)
+{
+   uint32_t value = *(uint32_t *) arg;
+   uint32_t loopi;
+   int32_t acc = 0;
+
+   for(loopi = 0; loopi < ops; loopi++)
+   {
+      /* read the value through the volatile sink so the call is not
+       * hoisted out of the loop */
+      bench_sink = value;
+      acc += ciaaLibs_getFirstNotSetBit(bench_sink);
+   }
+
+   bench_sink = (uint32_t) acc;
+}
+
+static void bench_matrixAdd(void * arg, uint32_t ops)
+{
+   bench_matrixArgType * bench = (bench_matrixArgType *) arg;
+   uint32_t loopi;
+
+   for(loopi = 0; loopi < ops; loopi++)
+   {
+      ciaaLibs_MatrixAdd_float(&bench->src1, &bench->src2, &bench->dst);
+   }
+}
+
+static void bench_matrixMul(void * arg, uint32_t ops)
+{
+   bench_matrixArgType * bench = (bench_matrixArgType *) arg;
+   uint32_t loopi;
+
+   for(loopi = 0; loopi < ops; loopi++)
+   {
+      ciaaLibs_MatrixMul_float(&bench->src1, &bench->src2, &bench->dst);
+   }
+}
+
+static void bench_circBuf(ciaaLibs_CircBufType * cbuf, char const * const variants[3])
+{
+   bench_circBufArgType arg;
+   size_t loopi;
+
+   arg.cbuf = cbuf;
+
+   /* chunk sizes with free running head and tail */
+   arg.fill = 0;
+   arg.pos = SIZE_MAX;
+   for(loopi = 0; loopi < BENCH_COUNT(bench_circBufChunks); loopi++)
+   {
+      arg.chunk = bench_circBufChunks[loopi];
+      bench_measure("ciaaLibs_circBufPutGet", variants[0], arg.chunk,
+            bench_circBufPutGet, &arg, BENCH_CIRCBUF_BYTES / arg.chunk,
+            2 * arg.chunk);
+   }
+
+   /* fill levels in percent with chunks of BENCH_CIRCBUF_CHUNK */
+   arg.chunk = BENCH_CIRCBUF_CHUNK;
+   for(loopi = 0; loopi < BENCH_COUNT(bench_fillLevels); loopi++)
+   {
+      arg.fill = (cbuf->size * bench_fillLevels[loopi]) / 100;
+      bench_measure("ciaaLibs_circBufPutGet", variants[1], bench_fillLevels[loopi],
+            bench_circBufPutGet, &arg, BENCH_CIRCBUF_BYTES / arg.chunk,
+            2 * arg.chunk);
+   }
+
+   /* wrap positions with chunks of BENCH_CIRCBUF_CHUNK, the put wraps
+    * after the given count of bytes */
+   arg.fill = 0;
+   for(loopi = 0; loopi < BENCH_COUNT(bench_wrapPositions); loopi++)
+   {
+      arg.pos = cbuf->size + 1 - bench_wrapPositions[loopi];
+      arg.pos &= cbuf->size;
+      bench_measure("ciaaLibs_circBufPutGet", variants[2], bench_wrapPositions[loopi],
+            bench_circBufPutGet, &arg, BENCH_CIRCBUF_BYTES / arg.chunk,
+            2 * arg.chunk);
+   }
+}
+
+/*==================[external functions definition]==========================*/
+int main(void)
+{
+   StartOS(AppMode1);
+   return 0;
+}
+
+void ErrorHook(void)
+{
+   ciaaPOSIX_printf("ErrorHook was called\n");
+   ciaaPOSIX_printf("Service: %d, P1: %d, P2: %d, P3: %d, RET: %d\n", OSErrorGetServiceId(), OSErrorGetParam1(), OSErrorGetParam2(), OSErrorGetParam3(), OSErrorGetRet());
+   ShutdownOS(0);
+}
+
+/*==================[tasks]==================================================*/
+TASK(InitTask)
+{
+   ciaaLibs_CircBufType split;
+   ciaaLibs_CircBufType * mirrored;
+   bench_poolBufArgType poolArg;
+   bench_matrixArgType matrixArg;
+   uint32_t value;
+   uint16_t n;
+   size_t loopi;
+   size_t loopj;
+
+   ciaak_start();
+
+   ciaaPOSIX_memset(bench_data, 0x5A, sizeof(bench_data));
+
+   ciaaPOSIX_printf("benchmark,variant,param,ops,ns_per_op,bytes_per_s\n");
+
+   /* circular buffer with two copies on each wrap */
+   ciaaLibs_circBufInit(&split, bench_circBufMem, BENCH_CIRCBUF_SIZE);
+   bench_circBuf(&split, bench_splitVariants);
+
+   /* mirrored circular buffer, always one copy */
+   mirrored = ciaaLibs_circBufNewMirrored(BENCH_CIRCBUF_SIZE);
+   if (NULL != mirrored)
+   {
+      if (1 == mirrored->mirrored)
+      {
+         bench_circBuf(mirrored, bench_mirroredVariants);
+      }
+      ciaaLibs_circBufRel(mirrored);
+   }
+
+   /* pool buffer lock and free at different fill levels, the elements are
+    * locked from the beginning of the pool */
+   poolArg.pbuf = &bench_pool;
+   for(loopi = 0; loopi < BENCH_COUNT(bench_fillLevels); loopi++)
+   {
+      poolArg.fill = (BENCH_POOLBUF_SIZE * bench_fillLevels[loopi]) / 100;
+      ciaaLibs_poolBufInit(&bench_pool, bench_pool_buf, bench_pool_status,
+            bench_pool_summary, BENCH_POOLBUF_SIZE, sizeof(uint32_t));
+      for(loopj = 0; loopj < poolArg.fill; loopj++)
+      {
+         ciaaLibs_poolBufLock(&bench_pool);
+      }
+      bench_measure("ciaaLibs_poolBufLockFree", "fill", bench_fillLevels[loopi],
+            bench_poolBufLockFree, &poolArg, BENCH_POOLBUF_OPS, 0);
+   }
+
+   /* pool list lock and free at the same fill levels */
+   for(loopi = 0; loopi < BENCH_COUNT(bench_fillLevels); loopi++)
+   {
+      ciaaLibs_poolListInit(&bench_list, bench_list_buf, bench_list_status,
+            BENCH_POOLBUF_SIZE, sizeof(bench_list_buf[0]));
+      for(loopj = 0; loopj < (BENCH_POOLBUF_SIZE * bench_fillLevels[loopi]) / 100; loopj++)
+      {
+         ciaaLibs_poolListLock(&bench_list);
+      }
+      bench_measure("ciaaLibs_poolListLockFree", "fill", bench_fillLevels[loopi],
+            bench_poolListLockFree, &bench_list, BENCH_POOLBUF_OPS, 0);
+   }
+
+   /* first not set bit */
+   for(loopi = 0; loopi < BENCH_COUNT(bench_bitValues); loopi++)
+   {
+      value = bench_bitValues[loopi];
+      bench_measure("ciaaLibs_getFirstNotSetBit", "value", value,
+            bench_getFirstNotSetBit, &value, BENCH_BIT_OPS, 0);
+   }
+
+   /* float matrices of n x n */
+   for(loopi = 0; loopi < BENCH_COUNT(bench_matrixData); loopi++)
+   {
+      for(loopj = 0; loopj < BENCH_COUNT(bench_matrixData[0]); loopj++)
+      {
+         bench_matrixData[loopi][loopj] =
+            (float) ((loopi * BENCH_COUNT(bench_matrixData[0])) + loopj);
+      }
+   }
+   for(loopi = 0; loopi < BENCH_COUNT(bench_matrixSizes); loopi++)
+   {
+      n = bench_matrixSizes[loopi];
+      ciaaLibs_MatrixInit(&matrixArg.src1, n, n, CIAA_LIBS_FLOAT_32, bench_matrixData[0]);
+      ciaaLibs_MatrixInit(&matrixArg.src2, n, n, CIAA_LIBS_FLOAT_32, bench_matrixData[1]);
+      ciaaLibs_MatrixInit(&matrixArg.dst, n, n, CIAA_LIBS_FLOAT_32, bench_matrixData[2]);
+
+      bench_measure("ciaaLibs_MatrixAdd_float", "float", n,
+            bench_matrixAdd, &matrixArg, BENCH_MATRIX_FLOPS / (n * n),
+            3 * n * n * sizeof(float));
+      bench_measure("ciaaLibs_MatrixMul_float", "float", n,
+            bench_matrixMul, &matrixArg, BENCH_MATRIX_FLOPS / (n * n * n),
+            3 * n * n * sizeof(float));
+   }
+
+   ShutdownOS(0);
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+
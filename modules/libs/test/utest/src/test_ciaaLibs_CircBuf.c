@@ -47,14 +47,22 @@
 #include "ciaaLibs_CircBuf.h"
 #include "stdlib.h"
 #include "string.h"
+#include "pthread.h"
+#include "sched.h"
 
 /*==================[macros and definitions]=================================*/
+/** \brief count of bytes transfered by the stress tests */
+#define TEST_STRESS_BYTES        (1024 * 1024 * 4)
 
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
 void ciaaLibs_circBufPrint(ciaaLibs_CircBufType * cbuf);
 
+static void * test_stressWriter(void * cbuf);
+
+static void * test_stressReader(void * cbuf);
+
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
@@ -77,6 +85,93 @@ void ciaaLibs_circBufPrint(ciaaLibs_CircBufType * cbuf)
    printf("                      0123456789012345678901234567890123456789012345678901234567890123\n");
    printf("Head: %2d Tail: %2d Val:%s\n\n", cbuf->head, cbuf->tail, cbuf->buf);
 }
+
+/** \brief writer thread of the stress test
+ **
+ ** Writes TEST_STRESS_BYTES of a known sequence with different chunk sizes.
+ **
+ **/
+static void * test_stressWriter(void * cbuf)
+{
+   uint8_t data[64];
+   size_t written = 0;
+   size_t chunk = 1;
+   size_t loopi;
+   uint8_t seq = 0;
+
+   while(written < TEST_STRESS_BYTES)
+   {
+      /* do not write more than TEST_STRESS_BYTES */
+      chunk = ciaaLibs_min(chunk, TEST_STRESS_BYTES - written);
+
+      /* prepare next chunk of the sequence */
+      for(loopi = 0; loopi < chunk; loopi++)
+      {
+         data[loopi] = (uint8_t)(seq + loopi);
+      }
+
+      if (chunk == ciaaLibs_circBufPut((ciaaLibs_CircBufType *) cbuf, data, chunk))
+      {
+         seq += chunk;
+         written += chunk;
+         /* use chunks of 1 to 37 bytes */
+         chunk = (chunk % 37) + 1;
+      }
+      else
+      {
+         /* buffer full, let the reader run */
+         sched_yield();
+      }
+   }
+
+   return NULL;
+}
+
+/** \brief reader thread of the stress test
+ **
+ ** Reads TEST_STRESS_BYTES with different chunk sizes and checks the sequence
+ **
+ ** \return count of wrong bytes
+ **/
+static void * test_stressReader(void * cbuf)
+{
+   uint8_t data[64];
+   size_t read = 0;
+   size_t chunk = 1;
+   size_t ret;
+   size_t loopi;
+   uint8_t seq = 0;
+   uintptr_t errors = 0;
+
+   while(read < TEST_STRESS_BYTES)
+   {
+      /* do not read more than TEST_STRESS_BYTES */
+      chunk = ciaaLibs_min(chunk, TEST_STRESS_BYTES - read);
+
+      ret = ciaaLibs_circBufGet((ciaaLibs_CircBufType *) cbuf, data, chunk);
+
+      for(loopi = 0; loopi < ret; loopi++)
+      {
+         if (data[loopi] != seq)
+         {
+            errors++;
+         }
+         seq++;
+      }
+      read += ret;
+
+      if (0 == ret)
+      {
+         /* buffer empty, let the writer run */
+         sched_yield();
+      }
+
+      /* use chunks of 1 to 41 bytes */
+      chunk = (chunk % 41) + 1;
+   }
+
+   return (void *) errors;
+}
 /*==================[external functions definition]==========================*/
 /** \brief set Up function
  **
@@ -317,6 +412,307 @@ void test_ciaaLibs_circBufEmptyFull(void) {
    ciaaLibs_circBufRel(cbuf);
 }
 
+/** \brief test:
+ **            - ciaaLibs_circBufWriteReserve
+ **            - ciaaLibs_circBufWriteCommit
+ **            - ciaaLibs_circBufReadReserve
+ **            - ciaaLibs_circBufReadRelease
+ **/
+void test_ciaaLibs_circBufReserve(void) {
+   ciaaLibs_CircBufType * cbuf;
+   ciaaLibs_CircBufSpanType span;
+   size_t ret;
+   char * from = "0hallo123-10HALLO12-20hallo12-30HALLO12-40HALLO12-50hallo12-60-4";
+                /*0123456789012345678901234567890123456789012345678901234567890123*/
+   char to[100];
+
+   /* use linux malloc, free and memcpy */
+   ciaaPOSIX_malloc_StubWithCallback(malloc);
+   ciaaPOSIX_memcpy_StubWithCallback(memcpy);
+   ciaaPOSIX_free_StubWithCallback(free);
+
+   /* creates a cicular buffer with 64 bytes */
+   cbuf = ciaaLibs_circBufNew(64);
+   TEST_ASSERT_TRUE(NULL != cbuf);
+
+   /* nothing to be read */
+   ret = ciaaLibs_circBufReadReserve(cbuf, &span, 10);
+   TEST_ASSERT_EQUAL_INT(0, ret);
+   TEST_ASSERT_EQUAL_INT(0, span.nbytes[0]);
+   TEST_ASSERT_EQUAL_INT(0, span.nbytes[1]);
+
+   /* reserve more than available, only 63 bytes are provided */
+   ret = ciaaLibs_circBufWriteReserve(cbuf, &span, 100);
+   TEST_ASSERT_EQUAL_INT(63, ret);
+   TEST_ASSERT_TRUE(&cbuf->buf[0] == span.buf[0]);
+   TEST_ASSERT_EQUAL_INT(63, span.nbytes[0]);
+   TEST_ASSERT_EQUAL_INT(0, span.nbytes[1]);
+
+   /* write 50 bytes in place but commit only 40 */
+   memcpy(span.buf[0], from, 50);
+   ciaaLibs_circBufWriteCommit(cbuf, 40);
+   TEST_ASSERT_EQUAL_INT(40, ciaaLibs_circBufCount(cbuf, cbuf->tail));
+
+   /* read 30 bytes in place */
+   ret = ciaaLibs_circBufReadReserve(cbuf, &span, 30);
+   TEST_ASSERT_EQUAL_INT(30, ret);
+   TEST_ASSERT_EQUAL_INT(30, span.nbytes[0]);
+   TEST_ASSERT_EQUAL_INT(0, span.nbytes[1]);
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(from, span.buf[0], 30);
+   ciaaLibs_circBufReadRelease(cbuf, 30);
+
+   /* reserve space which wraps: 24 bytes at the end and 29 at the begin */
+   ret = ciaaLibs_circBufWriteReserve(cbuf, &span, 100);
+   TEST_ASSERT_EQUAL_INT(53, ret);
+   TEST_ASSERT_TRUE(&cbuf->buf[40] == span.buf[0]);
+   TEST_ASSERT_EQUAL_INT(24, span.nbytes[0]);
+   TEST_ASSERT_TRUE(&cbuf->buf[0] == span.buf[1]);
+   TEST_ASSERT_EQUAL_INT(29, span.nbytes[1]);
+
+   /* write 30 bytes over the wrap */
+   memcpy(span.buf[0], &from[30], span.nbytes[0]);
+   memcpy(span.buf[1], &from[30 + span.nbytes[0]], 30 - span.nbytes[0]);
+   ciaaLibs_circBufWriteCommit(cbuf, 30);
+
+   /* read all: 10 old and 30 new bytes in two spans */
+   ret = ciaaLibs_circBufReadReserve(cbuf, &span, 100);
+   TEST_ASSERT_EQUAL_INT(40, ret);
+   TEST_ASSERT_EQUAL_INT(34, span.nbytes[0]);
+   TEST_ASSERT_EQUAL_INT(6, span.nbytes[1]);
+   memcpy(to, span.buf[0], span.nbytes[0]);
+   memcpy(&to[span.nbytes[0]], span.buf[1], span.nbytes[1]);
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(&from[30], to, 10);
+   TEST_ASSERT_EQUAL_UINT8_ARRAY(&from[30], &to[10], 30);
+   ciaaLibs_circBufReadRelease(cbuf, ret);
+
+   /* buffer is empty */
+   TEST_ASSERT_TRUE(ciaaLibs_circBufEmpty(cbuf));
+
+   /* release buffer */
+   ciaaLibs_circBufRel(cbuf);
+}
+
+/** \brief test ciaaLibs_circBufPutOverwrite
+ **/
+void test_ciaaLibs_circBufPutOverwrite(void) {
+   ciaaLibs_CircBufType cbuf;
+   uint8_t buf[16];
+   char * data = "0123456789abcdefghijklmnopqrstuvwxyz";
+   char to[16];
+
+   ciaaPOSIX_memcpy_StubWithCallback(memcpy);
+
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_circBufInit(&cbuf, buf, 16));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_circBufDropped(&cbuf));
+
+   /* no data is dropped while space is available */
+   TEST_ASSERT_EQUAL_INT(10, ciaaLibs_circBufPutOverwrite(&cbuf, data, 10));
+   TEST_ASSERT_EQUAL_INT(5, ciaaLibs_circBufPutOverwrite(&cbuf, &data[10], 5));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_circBufDropped(&cbuf));
+   TEST_ASSERT_TRUE(ciaaLibs_circBufFull(&cbuf));
+
+   /* the oldest 4 bytes are overwritten */
+   TEST_ASSERT_EQUAL_INT(4, ciaaLibs_circBufPutOverwrite(&cbuf, &data[15], 4));
+   TEST_ASSERT_EQUAL_INT(4, ciaaLibs_circBufDropped(&cbuf));
+   TEST_ASSERT_EQUAL_INT(15, ciaaLibs_circBufGet(&cbuf, to, 16));
+   TEST_ASSERT_EQUAL_MEMORY(&data[4], to, 15);
+
+   /* only the last 15 bytes of a too long write are stored */
+   TEST_ASSERT_EQUAL_INT(2, ciaaLibs_circBufPutOverwrite(&cbuf, data, 2));
+   TEST_ASSERT_EQUAL_INT(15, ciaaLibs_circBufPutOverwrite(&cbuf, data, 20));
+   TEST_ASSERT_EQUAL_INT(4 + 5 + 2, ciaaLibs_circBufDropped(&cbuf));
+   TEST_ASSERT_EQUAL_INT(15, ciaaLibs_circBufGet(&cbuf, to, 16));
+   TEST_ASSERT_EQUAL_MEMORY(&data[5], to, 15);
+   TEST_ASSERT_TRUE(ciaaLibs_circBufEmpty(&cbuf));
+} /* end test_ciaaLibs_circBufPutOverwrite */
+
+/** \brief test ciaaLibs_circBufFind at all positions and alignments
+ **/
+void test_ciaaLibs_circBufFind(void) {
+   ciaaLibs_CircBufType cbuf;
+   uint8_t buf[64];
+   uint8_t data[63];
+   size_t start;
+   size_t pos;
+   size_t offset;
+
+   ciaaPOSIX_memcpy_StubWithCallback(memcpy);
+
+   memset(data, 'a', sizeof(data));
+
+   /* move the head over all positions of the buffer so the data starts at
+    * every alignment and wraps at every position */
+   for(start = 0; start < 64; start++)
+   {
+      TEST_ASSERT_EQUAL_INT(1, ciaaLibs_circBufInit(&cbuf, buf, 64));
+      cbuf.head = start;
+      cbuf.tail = start;
+      TEST_ASSERT_EQUAL_INT(63, ciaaLibs_circBufPut(&cbuf, data, 63));
+
+      /* not found */
+      TEST_ASSERT_EQUAL_INT(-1, ciaaLibs_circBufFind(&cbuf, 0, 'b'));
+
+      for(pos = 0; pos < 63; pos++)
+      {
+         buf[(start + pos) & 63] = 'b';
+
+         TEST_ASSERT_EQUAL_INT(pos, ciaaLibs_circBufFind(&cbuf, 0, 'b'));
+         for(offset = 0; offset < 63; offset += 7)
+         {
+            TEST_ASSERT_EQUAL_INT((offset <= pos) ? (int32_t)pos : -1,
+                  ciaaLibs_circBufFind(&cbuf, offset, 'b'));
+         }
+
+         buf[(start + pos) & 63] = 'a';
+      }
+
+      /* free bytes of the buffer are not checked */
+      buf[(start + 63) & 63] = 'b';
+      TEST_ASSERT_EQUAL_INT(-1, ciaaLibs_circBufFind(&cbuf, 0, 'b'));
+   }
+} /* end test_ciaaLibs_circBufFind */
+
+/** \brief test ciaaLibs_circBufFindPair, ciaaLibs_circBufPeek and
+ **        ciaaLibs_circBufSkip
+ **/
+void test_ciaaLibs_circBufFindPairPeekSkip(void) {
+   ciaaLibs_CircBufType cbuf;
+   uint8_t buf[16];
+   char * frame = ":01\r02\r\n:03";
+   char to[16];
+   int32_t pos;
+
+   ciaaPOSIX_memcpy_StubWithCallback(memcpy);
+
+   /* start at 10 so the frame wraps */
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_circBufInit(&cbuf, buf, 16));
+   cbuf.head = 10;
+   cbuf.tail = 10;
+   TEST_ASSERT_EQUAL_INT(6, ciaaLibs_circBufPut(&cbuf, frame, 6));
+
+   /* the first CR is not followed by LF, the second one is the last byte */
+   TEST_ASSERT_EQUAL_INT(-1, ciaaLibs_circBufFindPair(&cbuf, 0, '\r', '\n'));
+
+   /* the LF arrives after the end of the buffer */
+   TEST_ASSERT_EQUAL_INT(5, ciaaLibs_circBufPut(&cbuf, &frame[6], 5));
+   pos = ciaaLibs_circBufFindPair(&cbuf, 0, '\r', '\n');
+   TEST_ASSERT_EQUAL_INT(6, pos);
+   TEST_ASSERT_EQUAL_INT(-1, ciaaLibs_circBufFindPair(&cbuf, 7, '\r', '\n'));
+
+   /* peek the frame across the wrap without removing it */
+   TEST_ASSERT_EQUAL_INT(pos, ciaaLibs_circBufPeek(&cbuf, 0, to, pos));
+   TEST_ASSERT_EQUAL_MEMORY(frame, to, pos);
+   TEST_ASSERT_EQUAL_INT(3, ciaaLibs_circBufPeek(&cbuf, 2, to, 3));
+   TEST_ASSERT_EQUAL_MEMORY(&frame[2], to, 3);
+   TEST_ASSERT_EQUAL_INT(2, ciaaLibs_circBufPeek(&cbuf, 9, to, 3));
+   TEST_ASSERT_EQUAL_MEMORY(&frame[9], to, 2);
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_circBufPeek(&cbuf, 11, to, 3));
+   TEST_ASSERT_EQUAL_INT(11, ciaaLibs_circBufCount(&cbuf, cbuf.tail));
+
+   /* skip the frame and the delimiter */
+   TEST_ASSERT_EQUAL_INT(pos + 2, ciaaLibs_circBufSkip(&cbuf, pos + 2));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_circBufFind(&cbuf, 0, ':'));
+   TEST_ASSERT_EQUAL_INT(3, ciaaLibs_circBufSkip(&cbuf, 10));
+   TEST_ASSERT_TRUE(ciaaLibs_circBufEmpty(&cbuf));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_circBufSkip(&cbuf, 1));
+} /* end test_ciaaLibs_circBufFindPairPeekSkip */
+
+/** \brief test ciaaLibs_circBufNewMirrored
+ **/
+void test_ciaaLibs_circBufNewMirrored(void) {
+   ciaaLibs_CircBufType * cbuf;
+   ciaaLibs_CircBufSpanType span;
+   uint8_t data[200];
+   uint8_t to[200];
+   size_t loopi;
+
+   /* use linux malloc, free and memcpy */
+   ciaaPOSIX_malloc_StubWithCallback(malloc);
+   ciaaPOSIX_memcpy_StubWithCallback(memcpy);
+   ciaaPOSIX_free_StubWithCallback(free);
+
+   for(loopi = 0; loopi < sizeof(data); loopi++)
+   {
+      data[loopi] = (uint8_t) loopi;
+   }
+
+   /* a buffer smaller than a page is created without mirroring */
+   cbuf = ciaaLibs_circBufNewMirrored(64);
+   TEST_ASSERT_TRUE(NULL != cbuf);
+   TEST_ASSERT_EQUAL_INT(0, cbuf->mirrored);
+   ciaaLibs_circBufRel(cbuf);
+
+   cbuf = ciaaLibs_circBufNewMirrored(4096);
+   TEST_ASSERT_TRUE(NULL != cbuf);
+   TEST_ASSERT_EQUAL_INT(1, cbuf->mirrored);
+   TEST_ASSERT_EQUAL_INT(4095, cbuf->size);
+
+   /* the memory after the end of the buffer is the buffer itself */
+   cbuf->buf[0] = 0x5A;
+   TEST_ASSERT_EQUAL_HEX8(0x5A, cbuf->buf[4096]);
+   cbuf->buf[4096 + 10] = 0xA5;
+   TEST_ASSERT_EQUAL_HEX8(0xA5, cbuf->buf[10]);
+
+   /* move head and tail near the end of the buffer */
+   cbuf->head = 4000;
+   cbuf->tail = 4000;
+
+   /* writing across the end needs a single span */
+   TEST_ASSERT_EQUAL_INT(200, ciaaLibs_circBufWriteReserve(cbuf, &span, 200));
+   TEST_ASSERT_EQUAL_INT(200, span.nbytes[0]);
+   TEST_ASSERT_EQUAL_INT(0, span.nbytes[1]);
+
+   TEST_ASSERT_EQUAL_INT(200, ciaaLibs_circBufPut(cbuf, data, 200));
+   TEST_ASSERT_EQUAL_INT(104, cbuf->tail);
+   TEST_ASSERT_EQUAL_MEMORY(&data[96], cbuf->buf, 104);
+
+   /* reading across the end needs a single span */
+   TEST_ASSERT_EQUAL_INT(200, ciaaLibs_circBufReadReserve(cbuf, &span, 200));
+   TEST_ASSERT_EQUAL_INT(200, span.nbytes[0]);
+   TEST_ASSERT_EQUAL_INT(0, span.nbytes[1]);
+
+   TEST_ASSERT_EQUAL_INT(150, ciaaLibs_circBufFind(cbuf, 0, 150));
+   TEST_ASSERT_EQUAL_INT(200, ciaaLibs_circBufGet(cbuf, to, sizeof(to)));
+   TEST_ASSERT_EQUAL_MEMORY(data, to, 200);
+   TEST_ASSERT_TRUE(ciaaLibs_circBufEmpty(cbuf));
+
+   ciaaLibs_circBufRel(cbuf);
+} /* end test_ciaaLibs_circBufNewMirrored */
+
+/** \brief test ciaaLibs_circBufPut and ciaaLibs_circBufGet from two threads
+ **
+ ** A writer and a reader thread transfer a known sequence over a small
+ ** buffer, the reader checks that each byte is received once and in order.
+ **/
+void test_ciaaLibs_circBufPutGetConcurrent(void) {
+   ciaaLibs_CircBufType * cbuf;
+   pthread_t writer;
+   pthread_t reader;
+   void * errors;
+
+   /* use linux malloc, free and memcpy */
+   ciaaPOSIX_malloc_StubWithCallback(malloc);
+   ciaaPOSIX_memcpy_StubWithCallback(memcpy);
+   ciaaPOSIX_free_StubWithCallback(free);
+
+   /* a small buffer forces many wraps and full/empty conditions */
+   cbuf = ciaaLibs_circBufNew(64);
+   TEST_ASSERT_TRUE(NULL != cbuf);
+
+   TEST_ASSERT_EQUAL_INT(0, pthread_create(&reader, NULL, test_stressReader, cbuf));
+   TEST_ASSERT_EQUAL_INT(0, pthread_create(&writer, NULL, test_stressWriter, cbuf));
+
+   TEST_ASSERT_EQUAL_INT(0, pthread_join(writer, NULL));
+   TEST_ASSERT_EQUAL_INT(0, pthread_join(reader, &errors));
+
+   /* all bytes have been received in the right order */
+   TEST_ASSERT_EQUAL_INT(0, (uintptr_t) errors);
+   TEST_ASSERT_TRUE(ciaaLibs_circBufEmpty(cbuf));
+
+   /* release buffer */
+   ciaaLibs_circBufRel(cbuf);
+}
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
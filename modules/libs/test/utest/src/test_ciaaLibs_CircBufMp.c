@@ -0,0 +1,362 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ * All rights reserved.
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/** \brief This file implements the test of the multi producer circular buffer
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup Libs CIAA Libraries
+ ** @{ */
+/** \addtogroup UnitTests Unit Tests
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "unity.h"
+#include "mock_ciaaPOSIX_stdlib.h"
+#include "ciaaLibs_CircBufMp.h"
+#include "stdlib.h"
+#include "string.h"
+#include "pthread.h"
+#include "sched.h"
+
+/*==================[macros and definitions]=================================*/
+/** \brief count of writer threads of the stress test */
+#define TEST_WRITERS             4
+
+/** \brief count of chunks written by each writer of the stress test */
+#define TEST_CHUNKS              (1024 * 128)
+
+/** \brief size of each chunk of the stress test, does not divide the buffer
+ ** size so chunks are written wrapped */
+#define TEST_CHUNK_SIZE          6
+
+/*==================[internal data declaration]==============================*/
+/** \brief argument of a writer thread of the stress test */
+typedef struct {
+   ciaaLibs_CircBufMpType * cbuf;
+   uint8_t id;
+} test_writerType;
+
+/*==================[internal functions declaration]=========================*/
+static void * test_stressWriter(void * arg);
+
+static void * test_stressReader(void * cbuf);
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/** \brief writer thread of the stress test
+ **
+ ** Writes TEST_CHUNKS chunks, each chunk has the id of the writer in the
+ ** first byte followed by a sequence of the writer.
+ **
+ **/
+static void * test_stressWriter(void * arg)
+{
+   test_writerType * writer = (test_writerType *) arg;
+   uint8_t data[TEST_CHUNK_SIZE];
+   size_t written = 0;
+   size_t loopi;
+   uint8_t seq = 0;
+
+   while(written < TEST_CHUNKS)
+   {
+      /* prepare next chunk of the sequence */
+      data[0] = writer->id;
+      for(loopi = 1; loopi < TEST_CHUNK_SIZE; loopi++)
+      {
+         data[loopi] = (uint8_t)(seq + loopi);
+      }
+
+      if (TEST_CHUNK_SIZE == ciaaLibs_circBufMpPut(writer->cbuf, data, TEST_CHUNK_SIZE))
+      {
+         seq += TEST_CHUNK_SIZE;
+         written++;
+      }
+      else
+      {
+         /* buffer full, let the reader run */
+         sched_yield();
+      }
+   }
+
+   return NULL;
+}
+
+/** \brief reader thread of the stress test
+ **
+ ** Reads all chunks of all writers with different sizes and checks that the
+ ** chunks are not interleaved and the sequence of each writer.
+ **
+ ** \return count of wrong bytes
+ **/
+static void * test_stressReader(void * cbuf)
+{
+   uint8_t data[TEST_CHUNK_SIZE];
+   uint8_t seq[TEST_WRITERS] = { 0 };
+   size_t chunks = 0;
+   size_t count = 0;
+   size_t chunk = 1;
+   size_t ret;
+   size_t loopi;
+   uintptr_t errors = 0;
+
+   while(chunks < (TEST_CHUNKS * TEST_WRITERS))
+   {
+      /* read up to the end of the current chunk with 1 to 6 bytes */
+      chunk = ciaaLibs_min(chunk, TEST_CHUNK_SIZE - count);
+      ret = ciaaLibs_circBufMpGet((ciaaLibs_CircBufMpType *) cbuf, &data[count], chunk);
+      count += ret;
+
+      if (TEST_CHUNK_SIZE == count)
+      {
+         /* check the chunk against the sequence of its writer */
+         if (data[0] < TEST_WRITERS)
+         {
+            for(loopi = 1; loopi < TEST_CHUNK_SIZE; loopi++)
+            {
+               if (data[loopi] != (uint8_t)(seq[data[0]] + loopi))
+               {
+                  errors++;
+               }
+            }
+            seq[data[0]] += TEST_CHUNK_SIZE;
+         }
+         else
+         {
+            errors++;
+         }
+         chunks++;
+         count = 0;
+      }
+
+      if (0 == ret)
+      {
+         /* buffer empty, let the writers run */
+         sched_yield();
+      }
+
+      chunk = (chunk % TEST_CHUNK_SIZE) + 1;
+   }
+
+   return (void *) errors;
+}
+
+/*==================[external functions definition]==========================*/
+/** \brief set Up function
+ **
+ ** This function is called before each test case is executed
+ **
+ **/
+void setUp(void) {
+}
+
+/** \brief tear Down function
+ **
+ ** This function is called after each test case is executed
+ **
+ **/
+void tearDown(void) {
+}
+
+void doNothing(void) {
+}
+
+/** \brief test ciaaLibs_circBufMpNew and ciaaLibs_circBufMpInit
+ **/
+void test_ciaaLibs_circBufMpNew(void) {
+   ciaaLibs_CircBufMpType * cbuf;
+   ciaaLibs_CircBufMpType cbufStatic;
+   uint8_t buf[16];
+
+   /* try to create a buffer with less than 8 bytes */
+   cbuf = ciaaLibs_circBufMpNew(4);
+   TEST_ASSERT_TRUE(cbuf == NULL);
+
+   /* try to create a buffer with size != power of 2 */
+   cbuf = ciaaLibs_circBufMpNew(17);
+   TEST_ASSERT_TRUE(cbuf == NULL);
+
+   /* no memory available */
+   ciaaPOSIX_malloc_ExpectAndReturn(sizeof(ciaaLibs_CircBufMpType) + 8, NULL);
+   cbuf = ciaaLibs_circBufMpNew(8);
+   TEST_ASSERT_TRUE(cbuf == NULL);
+
+   /* use linux malloc */
+   ciaaPOSIX_malloc_StubWithCallback(malloc);
+
+   /* try to create a buffer */
+   cbuf = ciaaLibs_circBufMpNew(16);
+   TEST_ASSERT_TRUE(cbuf != NULL);
+   TEST_ASSERT_TRUE(ciaaLibs_circBufMpEmpty(cbuf));
+   TEST_ASSERT_EQUAL_INT(15, cbuf->size);
+   /* free reserved memory */
+   free(cbuf);
+
+   /* init a static buffer */
+   TEST_ASSERT_EQUAL_INT(-1, ciaaLibs_circBufMpInit(&cbufStatic, buf, 12));
+   TEST_ASSERT_EQUAL_INT(-1, ciaaLibs_circBufMpInit(&cbufStatic, NULL, 16));
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_circBufMpInit(&cbufStatic, buf, 16));
+   TEST_ASSERT_TRUE(ciaaLibs_circBufMpEmpty(&cbufStatic));
+} /* end test_ciaaLibs_circBufMpNew */
+
+/** \brief test ciaaLibs_circBufMpPut and ciaaLibs_circBufMpGet
+ **/
+void test_ciaaLibs_circBufMpPutGet(void) {
+   ciaaLibs_CircBufMpType cbuf;
+   uint8_t buf[16];
+   char * data = "0123456789abcdefghij";
+   char to[20];
+
+   ciaaPOSIX_memcpy_StubWithCallback(memcpy);
+
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_circBufMpInit(&cbuf, buf, 16));
+
+   /* nothing to read and nothing to write */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_circBufMpGet(&cbuf, to, 4));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_circBufMpPut(&cbuf, data, 0));
+
+   /* all bytes of the buffer can be used */
+   TEST_ASSERT_EQUAL_INT(10, ciaaLibs_circBufMpPut(&cbuf, data, 10));
+   TEST_ASSERT_EQUAL_INT(6, ciaaLibs_circBufMpPut(&cbuf, &data[10], 6));
+   TEST_ASSERT_EQUAL_INT(16, ciaaLibs_circBufMpCount(&cbuf));
+
+   /* no partial writes */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_circBufMpPut(&cbuf, data, 1));
+
+   /* read partially */
+   TEST_ASSERT_EQUAL_INT(12, ciaaLibs_circBufMpGet(&cbuf, to, 12));
+   TEST_ASSERT_EQUAL_MEMORY(data, to, 12);
+   TEST_ASSERT_EQUAL_INT(4, ciaaLibs_circBufMpCount(&cbuf));
+
+   /* write wrapping */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_circBufMpPut(&cbuf, data, 13));
+   TEST_ASSERT_EQUAL_INT(10, ciaaLibs_circBufMpPut(&cbuf, data, 10));
+
+   /* read wrapping, only available data is returned */
+   TEST_ASSERT_EQUAL_INT(14, ciaaLibs_circBufMpGet(&cbuf, to, 20));
+   TEST_ASSERT_EQUAL_MEMORY(&data[12], to, 4);
+   TEST_ASSERT_EQUAL_MEMORY(data, &to[4], 10);
+   TEST_ASSERT_TRUE(ciaaLibs_circBufMpEmpty(&cbuf));
+} /* end test_ciaaLibs_circBufMpPutGet */
+
+/** \brief test that the tail is only published once all writers committed
+ **/
+void test_ciaaLibs_circBufMpCommitOrder(void) {
+   ciaaLibs_CircBufMpType cbuf;
+   uint8_t buf[16];
+   char * data = "0123456789abcdef";
+   char to[16];
+
+   ciaaPOSIX_memcpy_StubWithCallback(memcpy);
+
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_circBufMpInit(&cbuf, buf, 16));
+
+   /* simulate a writer which has reserved 4 bytes but not committed yet */
+   cbuf.reserve = 4;
+
+   /* a second writer puts data, it is not visible until the first commits */
+   TEST_ASSERT_EQUAL_INT(4, ciaaLibs_circBufMpPut(&cbuf, &data[4], 4));
+   TEST_ASSERT_TRUE(ciaaLibs_circBufMpEmpty(&cbuf));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_circBufMpGet(&cbuf, to, 16));
+
+   /* the reserved space is not available for other writers */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_circBufMpPut(&cbuf, data, 9));
+
+   /* the first writer commits */
+   memcpy(buf, data, 4);
+   cbuf.commit += 4;
+   cbuf.tail = cbuf.commit;
+
+   /* the data is read in reservation order */
+   TEST_ASSERT_EQUAL_INT(8, ciaaLibs_circBufMpGet(&cbuf, to, 16));
+   TEST_ASSERT_EQUAL_MEMORY(data, to, 8);
+} /* end test_ciaaLibs_circBufMpCommitOrder */
+
+/** \brief test ciaaLibs_circBufMpPut from many threads
+ **
+ ** TEST_WRITERS threads write chunks to a small buffer and one reader
+ ** checks that the chunks are not interleaved and the sequence of each
+ ** writer is received in order.
+ **/
+void test_ciaaLibs_circBufMpPutConcurrent(void) {
+   ciaaLibs_CircBufMpType * cbuf;
+   test_writerType writerArg[TEST_WRITERS];
+   pthread_t writer[TEST_WRITERS];
+   pthread_t reader;
+   void * errors;
+   uint8_t loopi;
+
+   /* use linux malloc, free and memcpy */
+   ciaaPOSIX_malloc_StubWithCallback(malloc);
+   ciaaPOSIX_memcpy_StubWithCallback(memcpy);
+   ciaaPOSIX_free_StubWithCallback(free);
+
+   /* a small buffer forces many wraps and full/empty conditions */
+   cbuf = ciaaLibs_circBufMpNew(64);
+   TEST_ASSERT_TRUE(NULL != cbuf);
+
+   TEST_ASSERT_EQUAL_INT(0, pthread_create(&reader, NULL, test_stressReader, cbuf));
+   for(loopi = 0; loopi < TEST_WRITERS; loopi++)
+   {
+      writerArg[loopi].cbuf = cbuf;
+      writerArg[loopi].id = loopi;
+      TEST_ASSERT_EQUAL_INT(0, pthread_create(&writer[loopi], NULL, test_stressWriter, &writerArg[loopi]));
+   }
+
+   for(loopi = 0; loopi < TEST_WRITERS; loopi++)
+   {
+      TEST_ASSERT_EQUAL_INT(0, pthread_join(writer[loopi], NULL));
+   }
+   TEST_ASSERT_EQUAL_INT(0, pthread_join(reader, &errors));
+
+   /* all chunks have been received complete and in the right order */
+   TEST_ASSERT_EQUAL_INT(0, (uintptr_t) errors);
+   TEST_ASSERT_TRUE(ciaaLibs_circBufMpEmpty(cbuf));
+   TEST_ASSERT_EQUAL_INT(cbuf->reserve, cbuf->commit);
+
+   /* release buffer */
+   ciaaLibs_circBufMpRel(cbuf);
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+
@@ -177,6 +177,58 @@ void test_ciaaLibs_getFirstNotSetBit(void) {
    TEST_ASSERT_EQUAL_INT(29, val);
 }
 
+/** \brief test ciaaLibs_byteToWord and ciaaLibs_hasZeroByte
+ **/
+void test_ciaaLibs_hasZeroByte(void) {
+   uint32_t val;
+
+   TEST_ASSERT_EQUAL_HEX32(0x0d0d0d0du, ciaaLibs_byteToWord('\r'));
+   TEST_ASSERT_EQUAL_HEX32(0xffffffffu, ciaaLibs_byteToWord(0xff));
+
+   TEST_ASSERT_TRUE(0 == ciaaLibs_hasZeroByte(0x01010101u));
+   TEST_ASSERT_TRUE(0 == ciaaLibs_hasZeroByte(0xffffffffu));
+   TEST_ASSERT_TRUE(0 == ciaaLibs_hasZeroByte(0x80808080u));
+   TEST_ASSERT_TRUE(0 != ciaaLibs_hasZeroByte(0x00000000u));
+   TEST_ASSERT_TRUE(0 != ciaaLibs_hasZeroByte(0xffffff00u));
+   TEST_ASSERT_TRUE(0 != ciaaLibs_hasZeroByte(0x00ffffffu));
+   TEST_ASSERT_TRUE(0 != ciaaLibs_hasZeroByte(0x01000101u));
+
+   /* look for a byte xoring with the replicated pattern */
+   val = 0x0a0d3a31u;
+   TEST_ASSERT_TRUE(0 != ciaaLibs_hasZeroByte(val ^ ciaaLibs_byteToWord('\r')));
+   TEST_ASSERT_TRUE(0 == ciaaLibs_hasZeroByte(val ^ ciaaLibs_byteToWord('0')));
+}
+
+/** \brief test ciaaLibs_ctz and ciaaLibs_clz against their portable
+ **        implementation
+ **/
+void test_ciaaLibs_ctzClz(void) {
+   uint8_t loopi;
+   uint32_t val;
+
+   TEST_ASSERT_EQUAL_UINT8(32, ciaaLibs_ctzPortable(0));
+   TEST_ASSERT_EQUAL_UINT8(32, ciaaLibs_clzPortable(0));
+
+   for(loopi = 0; loopi < 32; loopi++) {
+      /* single bit set */
+      val = (uint32_t)1 << loopi;
+      TEST_ASSERT_EQUAL_UINT8(loopi, ciaaLibs_ctz(val));
+      TEST_ASSERT_EQUAL_UINT8(loopi, ciaaLibs_ctzPortable(val));
+      TEST_ASSERT_EQUAL_UINT8(31 - loopi, ciaaLibs_clz(val));
+      TEST_ASSERT_EQUAL_UINT8(31 - loopi, ciaaLibs_clzPortable(val));
+
+      /* all bits above respectively below set */
+      TEST_ASSERT_EQUAL_UINT8(loopi, ciaaLibs_ctzPortable(0xffffffffu << loopi));
+      TEST_ASSERT_EQUAL_UINT8(loopi, ciaaLibs_clzPortable(0xffffffffu >> loopi));
+   }
+
+   val = 0x00f01000u;
+   TEST_ASSERT_EQUAL_UINT8(12, ciaaLibs_ctz(val));
+   TEST_ASSERT_EQUAL_UINT8(12, ciaaLibs_ctzPortable(val));
+   TEST_ASSERT_EQUAL_UINT8(8, ciaaLibs_clz(val));
+   TEST_ASSERT_EQUAL_UINT8(8, ciaaLibs_clzPortable(val));
+}
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -47,19 +47,84 @@
 #include "ciaaPOSIX_stdint.h"
 #include "ciaaLibs_PoolBuf.h"
 #include "mock_ciaaLibs_Maths.h"
+#include "pthread.h"
+#include "sched.h"
 
 /*==================[macros and definitions]=================================*/
+/** \brief count of threads of the stress test */
+#define TEST_THREADS             4
+
+/** \brief count of elements locked at once by each thread of the stress
+ ** test, all threads together need more elements than available */
+#define TEST_LOCKED              12
+
+/** \brief count of lock and free rounds of each thread of the stress test */
+#define TEST_ROUNDS              (1024 * 32)
+
+/** \brief size of the pool of the stress test, uses 2 status words */
+#define TEST_POOL_SIZE           40
 
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
+static void * test_stressThread(void * arg);
 
 /*==================[internal data definition]===============================*/
 CIAALIBS_POOLDECLARE(pool, uint32_t, 60);
 
+CIAALIBS_POOLDECLARE(bigPool, uint8_t, 2080);
+
+CIAALIBS_POOLDECLARE(stressPool, uint32_t, TEST_POOL_SIZE);
+
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/** \brief thread of the stress test
+ **
+ ** Locks up to TEST_LOCKED elements, writes its id and a sequence to them
+ ** and checks that no other thread got the same element before freeing
+ ** them.
+ **
+ ** \param[in] arg id of the thread
+ ** \return count of detected errors
+ **/
+static void * test_stressThread(void * arg)
+{
+   uint32_t id = (uint32_t)(uintptr_t) arg;
+   uint32_t * element[TEST_LOCKED];
+   uintptr_t errors = 0;
+   uint32_t round;
+   uint32_t locked;
+   uint32_t loopi;
+
+   for(round = 0; round < TEST_ROUNDS; round++)
+   {
+      locked = 0;
+      for(loopi = 0; loopi < TEST_LOCKED; loopi++)
+      {
+         element[locked] = ciaaLibs_poolBufLock(&stressPool);
+         if (NULL != element[locked])
+         {
+            *element[locked] = (id << 24) | round;
+            locked++;
+         }
+      }
+
+      /* let the other threads run while the elements are locked */
+      sched_yield();
+
+      for(loopi = 0; loopi < locked; loopi++)
+      {
+         if (((id << 24) | round) != *element[loopi])
+         {
+            errors++;
+         }
+         ciaaLibs_poolBufFree(&stressPool, element[loopi]);
+      }
+   }
+
+   return (void *) errors;
+}
 
 /*==================[external functions definition]==========================*/
 /** \brief set Up function
@@ -80,16 +145,19 @@ void tearDown(void) {
 
 void test_ciaaLibs_poolBufInit(void) {
    int32_t val;
-   val = ciaaLibs_poolBufInit((ciaaLibs_poolBufType*)NULL, (void*)pool_buf, pool_status, 60, sizeof(uint32_t));
+   val = ciaaLibs_poolBufInit((ciaaLibs_poolBufType*)NULL, (void*)pool_buf, pool_status, pool_summary, 60, sizeof(uint32_t));
+   TEST_ASSERT_EQUAL_INT(-1, val);
+
+   val = ciaaLibs_poolBufInit(&pool, (void*)NULL, pool_status, pool_summary, 60, sizeof(uint32_t));
    TEST_ASSERT_EQUAL_INT(-1, val);
 
-   val = ciaaLibs_poolBufInit(&pool, (void*)NULL, pool_status, 60, sizeof(uint32_t));
+   val = ciaaLibs_poolBufInit(&pool, (void*)pool_buf, (uint32_t*)NULL, pool_summary, 60, sizeof(uint32_t));
    TEST_ASSERT_EQUAL_INT(-1, val);
 
-   val = ciaaLibs_poolBufInit(&pool, (void*)pool_buf, (uint32_t*)NULL, 60, sizeof(uint32_t));
+   val = ciaaLibs_poolBufInit(&pool, (void*)pool_buf, pool_status, (uint32_t*)NULL, 60, sizeof(uint32_t));
    TEST_ASSERT_EQUAL_INT(-1, val);
 
-   val = ciaaLibs_poolBufInit(&pool, (void*)pool_buf, pool_status, 60, sizeof(uint32_t));
+   val = ciaaLibs_poolBufInit(&pool, (void*)pool_buf, pool_status, pool_summary, 60, sizeof(uint32_t));
    TEST_ASSERT_EQUAL_INT(1, val);
 }
 
@@ -98,32 +166,137 @@ void test_ciaaLibs_poolBufLockAndFree(void) {
    uint32_t * element;
    size_t ret;
 
-   ciaaLibs_getFirstNotSetBit_ExpectAndReturn(0, 0);
    element = ciaaLibs_poolBufLock(&pool);
    TEST_ASSERT_EQUAL_PTR(&pool_buf[0], element);
 
-   ciaaLibs_getFirstNotSetBit_ExpectAndReturn(1, 1);
    element = ciaaLibs_poolBufLock(&pool);
    TEST_ASSERT_EQUAL_PTR(&pool_buf[1], element);
 
-   ciaaLibs_getFirstNotSetBit_ExpectAndReturn(3, 2);
    element = ciaaLibs_poolBufLock(&pool);
    TEST_ASSERT_EQUAL_PTR(&pool_buf[2], element);
 
-   /* simulate full */
-   ciaaLibs_getFirstNotSetBit_ExpectAndReturn(7,-1);
-   ciaaLibs_getFirstNotSetBit_ExpectAndReturn(0,60-32);
-   element = ciaaLibs_poolBufLock(&pool);
-   TEST_ASSERT_EQUAL_PTR(NULL, element);
-
    ret = ciaaLibs_poolBufFree(&pool, &pool_buf[1]);
    TEST_ASSERT_EQUAL_INT(1, ret);
 
-   ciaaLibs_getFirstNotSetBit_ExpectAndReturn(5, 1);
    element = ciaaLibs_poolBufLock(&pool);
    TEST_ASSERT_EQUAL_PTR(&pool_buf[1], element);
 }
 
+void test_ciaaLibs_poolBufFull(void) {
+   uint32_t * element;
+   uint32_t loopi;
+
+   ciaaLibs_poolBufInit(&pool, (void*)pool_buf, pool_status, pool_summary, 60, sizeof(uint32_t));
+
+   for(loopi = 0; loopi < 60; loopi++) {
+      element = ciaaLibs_poolBufLock(&pool);
+      TEST_ASSERT_EQUAL_PTR(&pool_buf[loopi], element);
+   }
+
+   /* the first status word is full, the second has unused bits */
+   TEST_ASSERT_EQUAL_HEX32(0xffffffffu, pool_status[0]);
+   TEST_ASSERT_EQUAL_HEX32(0x0fffffffu, pool_status[1]);
+   TEST_ASSERT_EQUAL_HEX32(0x1, pool_summary[0]);
+
+   element = ciaaLibs_poolBufLock(&pool);
+   TEST_ASSERT_EQUAL_PTR(NULL, element);
+
+   /* free an element of the full status word */
+   ciaaLibs_poolBufFree(&pool, &pool_buf[17]);
+   TEST_ASSERT_EQUAL_HEX32(0x0, pool_summary[0]);
+
+   element = ciaaLibs_poolBufLock(&pool);
+   TEST_ASSERT_EQUAL_PTR(&pool_buf[17], element);
+
+   /* free an element of the last status word */
+   ciaaLibs_poolBufFree(&pool, &pool_buf[59]);
+   element = ciaaLibs_poolBufLock(&pool);
+   TEST_ASSERT_EQUAL_PTR(&pool_buf[59], element);
+
+   element = ciaaLibs_poolBufLock(&pool);
+   TEST_ASSERT_EQUAL_PTR(NULL, element);
+}
+
+void test_ciaaLibs_poolBufSummary(void) {
+   uint32_t * element;
+   uint32_t loopi;
+
+   /* pool with more than one summary word */
+   ciaaLibs_poolBufInit(&bigPool, (void*)bigPool_buf, bigPool_status, bigPool_summary, 2080, sizeof(uint8_t));
+
+   for(loopi = 0; loopi < 2080; loopi++) {
+      element = ciaaLibs_poolBufLock(&bigPool);
+      TEST_ASSERT_EQUAL_PTR(&bigPool_buf[loopi], element);
+   }
+   TEST_ASSERT_EQUAL_HEX32(0xffffffffu, bigPool_summary[0]);
+   TEST_ASSERT_EQUAL_HEX32(0xffffffffu, bigPool_summary[1]);
+   TEST_ASSERT_EQUAL_HEX32(0x1, bigPool_summary[2]);
+
+   element = ciaaLibs_poolBufLock(&bigPool);
+   TEST_ASSERT_EQUAL_PTR(NULL, element);
+
+   /* the element of the second summary word is found after the first one */
+   ciaaLibs_poolBufFree(&bigPool, &bigPool_buf[1500]);
+   ciaaLibs_poolBufFree(&bigPool, &bigPool_buf[2070]);
+   element = ciaaLibs_poolBufLock(&bigPool);
+   TEST_ASSERT_EQUAL_PTR(&bigPool_buf[1500], element);
+   element = ciaaLibs_poolBufLock(&bigPool);
+   TEST_ASSERT_EQUAL_PTR(&bigPool_buf[2070], element);
+}
+
+void test_ciaaLibs_poolBufFreeInvalid(void) {
+   uint32_t * element;
+
+   ciaaLibs_poolBufInit(&pool, (void*)pool_buf, pool_status, pool_summary, 60, sizeof(uint32_t));
+
+   element = ciaaLibs_poolBufLock(&pool);
+   TEST_ASSERT_EQUAL_PTR(&pool_buf[0], element);
+
+   /* out of range */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_poolBufFree(&pool, &pool_buf[60]));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_poolBufFree(&pool, &pool_buf[-1]));
+
+   /* not aligned to an element */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_poolBufFree(&pool, (uint8_t*)&pool_buf[0] + 1));
+
+   /* not being used */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_poolBufFree(&pool, &pool_buf[1]));
+   TEST_ASSERT_EQUAL_HEX32(0x1, pool_status[0]);
+
+   /* double free */
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_poolBufFree(&pool, element));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_poolBufFree(&pool, element));
+   TEST_ASSERT_EQUAL_HEX32(0x0, pool_status[0]);
+}
+
+/** \brief test ciaaLibs_poolBufLock and ciaaLibs_poolBufFree from many
+ **        threads
+ **
+ ** TEST_THREADS threads lock and free elements of a small pool and check
+ ** that an element is never locked twice.
+ **/
+void test_ciaaLibs_poolBufConcurrent(void) {
+   pthread_t thread[TEST_THREADS];
+   void * errors;
+   uintptr_t loopi;
+
+   for(loopi = 0; loopi < TEST_THREADS; loopi++)
+   {
+      TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread[loopi], NULL, test_stressThread, (void *) loopi));
+   }
+
+   for(loopi = 0; loopi < TEST_THREADS; loopi++)
+   {
+      TEST_ASSERT_EQUAL_INT(0, pthread_join(thread[loopi], &errors));
+      TEST_ASSERT_EQUAL_INT(0, (uintptr_t) errors);
+   }
+
+   /* all elements have been freed */
+   TEST_ASSERT_EQUAL_HEX32(0, stressPool_status[0]);
+   TEST_ASSERT_EQUAL_HEX32(0, stressPool_status[1]);
+   TEST_ASSERT_EQUAL_HEX32(0, stressPool_summary[0]);
+}
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -0,0 +1,193 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ * All rights reserved.
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** \brief This file implements the test of the pool list
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup Libs CIAA Libraries
+ ** @{ */
+/** \addtogroup UnitTests Unit Tests
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "unity.h"
+#include "ciaaPOSIX_stdint.h"
+#include "ciaaLibs_PoolList.h"
+#include "mock_ciaaLibs_PoolBuf.h"
+
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+/** \brief element type of the test, bigger than a pointer */
+typedef struct {
+   uint32_t id;
+   uint8_t data[13];
+} test_elementType;
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+CIAALIBS_POOLLISTDECLARE(list, test_elementType, 40);
+
+/** \brief buffer for the pool lists initialized with ciaaLibs_poolListInit */
+static void * buf[40 * 4];
+
+/** \brief status of the pool lists initialized with ciaaLibs_poolListInit */
+static uint32_t status[2];
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+/** \brief set Up function
+ **
+ ** This function is called before each test case is executed
+ **
+ **/
+void setUp(void) {
+}
+
+/** \brief tear Down function
+ **
+ ** This function is called after each test case is executed
+ **
+ **/
+void tearDown(void) {
+}
+
+/** \brief test ciaaLibs_poolListInit
+ **/
+void test_ciaaLibs_poolListInit(void) {
+   ciaaLibs_poolListType plist;
+
+   TEST_ASSERT_EQUAL_INT(-1, ciaaLibs_poolListInit(NULL, buf, status, 40, 4 * sizeof(void *)));
+   TEST_ASSERT_EQUAL_INT(-1, ciaaLibs_poolListInit(&plist, NULL, status, 40, 4 * sizeof(void *)));
+   TEST_ASSERT_EQUAL_INT(-1, ciaaLibs_poolListInit(&plist, buf, NULL, 40, 4 * sizeof(void *)));
+
+   /* elements shall be able to store the link */
+   TEST_ASSERT_EQUAL_INT(-1, ciaaLibs_poolListInit(&plist, buf, status, 40, 0));
+   TEST_ASSERT_EQUAL_INT(-1, ciaaLibs_poolListInit(&plist, buf, status, 40, sizeof(void *) + 1));
+   TEST_ASSERT_EQUAL_INT(-1, ciaaLibs_poolListInit(&plist, (uint8_t *)buf + 1, status, 40, sizeof(void *)));
+
+   status[0] = 0xffffffffu;
+   status[1] = 0xffffffffu;
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_poolListInit(&plist, buf, status, 40, 4 * sizeof(void *)));
+   TEST_ASSERT_EQUAL_HEX32(0, status[0]);
+   TEST_ASSERT_EQUAL_HEX32(0, status[1]);
+   TEST_ASSERT_EQUAL_PTR(NULL, plist.head);
+   TEST_ASSERT_EQUAL_INT(0, plist.unused);
+}
+
+/** \brief test ciaaLibs_poolListLock and ciaaLibs_poolListFree
+ **/
+void test_ciaaLibs_poolListLockAndFree(void) {
+   test_elementType * element[40];
+   uint32_t loopi;
+
+   /* the declared pool needs no initialization */
+   TEST_ASSERT_TRUE(sizeof(test_elementType) <= list.elementSize);
+   TEST_ASSERT_EQUAL_INT(0, list.elementSize % sizeof(void *));
+
+   for(loopi = 0; loopi < 40; loopi++) {
+      element[loopi] = ciaaLibs_poolListLock(&list);
+      TEST_ASSERT_EQUAL_PTR(&list_buf[loopi], element[loopi]);
+      element[loopi]->id = loopi;
+   }
+   TEST_ASSERT_EQUAL_HEX32(0xffffffffu, list_status[0]);
+   TEST_ASSERT_EQUAL_HEX32(0x000000ffu, list_status[1]);
+
+   /* pool is full */
+   TEST_ASSERT_EQUAL_PTR(NULL, ciaaLibs_poolListLock(&list));
+
+   /* the freed elements are locked again in reverse order */
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_poolListFree(&list, element[3]));
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_poolListFree(&list, element[35]));
+   TEST_ASSERT_EQUAL_HEX32(0xfffffff7u, list_status[0]);
+   TEST_ASSERT_EQUAL_HEX32(0x000000f7u, list_status[1]);
+
+   TEST_ASSERT_EQUAL_PTR(element[35], ciaaLibs_poolListLock(&list));
+   TEST_ASSERT_EQUAL_PTR(element[3], ciaaLibs_poolListLock(&list));
+   TEST_ASSERT_EQUAL_PTR(NULL, ciaaLibs_poolListLock(&list));
+
+   /* the other elements have not been modified */
+   for(loopi = 0; loopi < 40; loopi++) {
+      if ((3 != loopi) && (35 != loopi)) {
+         TEST_ASSERT_EQUAL_INT(loopi, element[loopi]->id);
+      }
+   }
+
+   for(loopi = 0; loopi < 40; loopi++) {
+      TEST_ASSERT_EQUAL_INT(1, ciaaLibs_poolListFree(&list, element[loopi]));
+   }
+   TEST_ASSERT_EQUAL_HEX32(0, list_status[0]);
+   TEST_ASSERT_EQUAL_HEX32(0, list_status[1]);
+}
+
+/** \brief test ciaaLibs_poolListFree with invalid pointers
+ **/
+void test_ciaaLibs_poolListFreeInvalid(void) {
+   ciaaLibs_poolListType plist;
+   void * element;
+
+   ciaaLibs_poolListInit(&plist, buf, status, 40, 4 * sizeof(void *));
+
+   element = ciaaLibs_poolListLock(&plist);
+   TEST_ASSERT_EQUAL_PTR(&buf[0], element);
+
+   /* out of range */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_poolListFree(&plist, &buf[40 * 4]));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_poolListFree(&plist, (uint8_t *)buf - 4 * sizeof(void *)));
+
+   /* not aligned to an element */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_poolListFree(&plist, &buf[1]));
+
+   /* never used and not being used */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_poolListFree(&plist, &buf[4]));
+
+   /* double free does not link the element twice */
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_poolListFree(&plist, element));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_poolListFree(&plist, element));
+   TEST_ASSERT_EQUAL_PTR(element, ciaaLibs_poolListLock(&plist));
+   TEST_ASSERT_EQUAL_PTR(&buf[4], ciaaLibs_poolListLock(&plist));
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+
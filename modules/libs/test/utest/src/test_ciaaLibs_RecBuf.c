@@ -0,0 +1,279 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ * All rights reserved.
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/** \brief This file implements the test of the record buffer
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup Libs CIAA Libraries
+ ** @{ */
+/** \addtogroup UnitTests Unit Tests
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "unity.h"
+#include "mock_ciaaPOSIX_stdlib.h"
+#include "mock_ciaaLibs_CircBuf.h"
+#include "ciaaLibs_RecBuf.h"
+#include "stdlib.h"
+#include "string.h"
+
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static int32_t test_circBufInit(ciaaLibs_CircBufType * cbuf, void * buf,
+      size_t nbytes, int cmock_num_calls);
+
+static size_t test_circBufWriteReserve(ciaaLibs_CircBufType * cbuf,
+      ciaaLibs_CircBufSpanType * span, size_t nbytes, int cmock_num_calls);
+
+static size_t test_circBufReadReserve(ciaaLibs_CircBufType * cbuf,
+      ciaaLibs_CircBufSpanType * span, size_t nbytes, int cmock_num_calls);
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/** \brief stub of ciaaLibs_circBufInit */
+static int32_t test_circBufInit(ciaaLibs_CircBufType * cbuf, void * buf,
+      size_t nbytes, int cmock_num_calls)
+{
+   cbuf->size = nbytes - 1;
+   cbuf->head = 0;
+   cbuf->tail = 0;
+   cbuf->buf = buf;
+
+   return 1;
+}
+
+/** \brief stub of ciaaLibs_circBufWriteReserve */
+static size_t test_circBufWriteReserve(ciaaLibs_CircBufType * cbuf,
+      ciaaLibs_CircBufSpanType * span, size_t nbytes, int cmock_num_calls)
+{
+   size_t head = cbuf->head;
+
+   nbytes = ciaaLibs_min(nbytes, ciaaLibs_circBufSpace(cbuf, head));
+   span->buf[0] = ciaaLibs_circBufWritePos(cbuf);
+   span->nbytes[0] = ciaaLibs_min(nbytes, ciaaLibs_circBufRawSpace(cbuf, head));
+   span->buf[1] = &cbuf->buf[0];
+   span->nbytes[1] = nbytes - span->nbytes[0];
+
+   return nbytes;
+}
+
+/** \brief stub of ciaaLibs_circBufReadReserve */
+static size_t test_circBufReadReserve(ciaaLibs_CircBufType * cbuf,
+      ciaaLibs_CircBufSpanType * span, size_t nbytes, int cmock_num_calls)
+{
+   size_t tail = cbuf->tail;
+
+   nbytes = ciaaLibs_min(nbytes, ciaaLibs_circBufCount(cbuf, tail));
+   span->buf[0] = ciaaLibs_circBufReadPos(cbuf);
+   span->nbytes[0] = ciaaLibs_min(nbytes, ciaaLibs_circBufRawCount(cbuf, tail));
+   span->buf[1] = &cbuf->buf[0];
+   span->nbytes[1] = nbytes - span->nbytes[0];
+
+   return nbytes;
+}
+
+/*==================[external functions definition]==========================*/
+/** \brief set Up function
+ **
+ ** This function is called before each test case is executed
+ **
+ **/
+void setUp(void) {
+   ciaaLibs_circBufInit_StubWithCallback(test_circBufInit);
+   ciaaLibs_circBufWriteReserve_StubWithCallback(test_circBufWriteReserve);
+   ciaaLibs_circBufReadReserve_StubWithCallback(test_circBufReadReserve);
+   ciaaPOSIX_memcpy_StubWithCallback(memcpy);
+}
+
+/** \brief tear Down function
+ **
+ ** This function is called after each test case is executed
+ **
+ **/
+void tearDown(void) {
+}
+
+void doNothing(void) {
+}
+
+/** \brief test ciaaLibs_recBufNew
+ **/
+void test_ciaaLibs_recBufNew(void) {
+   ciaaLibs_RecBufType * rbuf;
+
+   /* try to create a buffer with size != power of 2 */
+   rbuf = ciaaLibs_recBufNew(12);
+   TEST_ASSERT_TRUE(rbuf == NULL);
+
+   /* no memory available */
+   ciaaPOSIX_malloc_ExpectAndReturn(sizeof(ciaaLibs_RecBufType) + 16, NULL);
+   rbuf = ciaaLibs_recBufNew(16);
+   TEST_ASSERT_TRUE(rbuf == NULL);
+
+   /* use linux malloc and free */
+   ciaaPOSIX_malloc_StubWithCallback(malloc);
+   ciaaPOSIX_free_StubWithCallback(free);
+
+   rbuf = ciaaLibs_recBufNew(16);
+   TEST_ASSERT_TRUE(rbuf != NULL);
+   TEST_ASSERT_TRUE(ciaaLibs_recBufEmpty(rbuf));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_recBufPeekNextLength(rbuf));
+
+   ciaaLibs_recBufRel(rbuf);
+} /* end test_ciaaLibs_recBufNew */
+
+/** \brief test ciaaLibs_recBufPut, ciaaLibs_recBufPeekNextLength and
+ **        ciaaLibs_recBufGet
+ **/
+void test_ciaaLibs_recBufPutGet(void) {
+   ciaaLibs_RecBufType rbuf;
+   uint8_t buf[16];
+   char * data = "0123456789abcdef";
+   char to[16];
+
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_recBufInit(&rbuf, buf, 16));
+
+   /* empty records are not allowed */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_recBufPut(&rbuf, data, 0));
+
+   /* a record of 14 bytes does not fit, 15 bytes can be used */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_recBufPut(&rbuf, data, 14));
+
+   /* put two records */
+   TEST_ASSERT_EQUAL_INT(5, ciaaLibs_recBufPut(&rbuf, data, 5));
+   TEST_ASSERT_EQUAL_INT(3, ciaaLibs_recBufPut(&rbuf, &data[5], 3));
+
+   /* a third one does not fit */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_recBufPut(&rbuf, data, 4));
+
+   /* the record is not read if it does not fit */
+   TEST_ASSERT_EQUAL_INT(5, ciaaLibs_recBufPeekNextLength(&rbuf));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_recBufGet(&rbuf, to, 4));
+   TEST_ASSERT_EQUAL_INT(5, ciaaLibs_recBufPeekNextLength(&rbuf));
+
+   /* read the records in order */
+   TEST_ASSERT_EQUAL_INT(5, ciaaLibs_recBufGet(&rbuf, to, sizeof(to)));
+   TEST_ASSERT_EQUAL_MEMORY(data, to, 5);
+   TEST_ASSERT_EQUAL_INT(3, ciaaLibs_recBufPeekNextLength(&rbuf));
+   TEST_ASSERT_EQUAL_INT(3, ciaaLibs_recBufGet(&rbuf, to, sizeof(to)));
+   TEST_ASSERT_EQUAL_MEMORY(&data[5], to, 3);
+
+   TEST_ASSERT_TRUE(ciaaLibs_recBufEmpty(&rbuf));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_recBufGet(&rbuf, to, sizeof(to)));
+} /* end test_ciaaLibs_recBufPutGet */
+
+/** \brief test records wrapping the end of the buffer
+ **/
+void test_ciaaLibs_recBufWrap(void) {
+   ciaaLibs_RecBufType rbuf;
+   uint8_t buf[16];
+   char * data = "0123456789abcdef";
+   char to[16];
+   size_t loopi;
+
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_recBufInit(&rbuf, buf, 16));
+
+   /* records of 4 bytes use 6 bytes, after some records the header and
+    * the data are split at each possible position */
+   for(loopi = 0; loopi < 32; loopi++)
+   {
+      TEST_ASSERT_EQUAL_INT(4, ciaaLibs_recBufPut(&rbuf, &data[loopi % 8], 4));
+      TEST_ASSERT_EQUAL_INT(7, ciaaLibs_recBufPut(&rbuf, &data[loopi % 9], 7));
+
+      TEST_ASSERT_EQUAL_INT(4, ciaaLibs_recBufPeekNextLength(&rbuf));
+      TEST_ASSERT_EQUAL_INT(4, ciaaLibs_recBufGet(&rbuf, to, sizeof(to)));
+      TEST_ASSERT_EQUAL_MEMORY(&data[loopi % 8], to, 4);
+
+      TEST_ASSERT_EQUAL_INT(7, ciaaLibs_recBufPeekNextLength(&rbuf));
+      TEST_ASSERT_EQUAL_INT(7, ciaaLibs_recBufGet(&rbuf, to, sizeof(to)));
+      TEST_ASSERT_EQUAL_MEMORY(&data[loopi % 9], to, 7);
+
+      TEST_ASSERT_TRUE(ciaaLibs_recBufEmpty(&rbuf));
+   }
+} /* end test_ciaaLibs_recBufWrap */
+
+/** \brief test ciaaLibs_recBufPutOverwrite
+ **/
+void test_ciaaLibs_recBufPutOverwrite(void) {
+   ciaaLibs_RecBufType rbuf;
+   uint8_t buf[16];
+   char * data = "0123456789abcdef";
+   char to[16];
+
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_recBufInit(&rbuf, buf, 16));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_recBufDropped(&rbuf));
+
+   /* records which never fit are not stored */
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_recBufPutOverwrite(&rbuf, data, 0));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_recBufPutOverwrite(&rbuf, data, 14));
+
+   /* fill the buffer with 3 records of 3 bytes */
+   TEST_ASSERT_EQUAL_INT(3, ciaaLibs_recBufPutOverwrite(&rbuf, data, 3));
+   TEST_ASSERT_EQUAL_INT(3, ciaaLibs_recBufPutOverwrite(&rbuf, &data[3], 3));
+   TEST_ASSERT_EQUAL_INT(2, ciaaLibs_recBufPutOverwrite(&rbuf, &data[6], 2));
+   TEST_ASSERT_EQUAL_INT(0, ciaaLibs_recBufDropped(&rbuf));
+
+   /* a record of 5 bytes needs 7, the two oldest records are dropped */
+   TEST_ASSERT_EQUAL_INT(5, ciaaLibs_recBufPutOverwrite(&rbuf, &data[8], 5));
+   TEST_ASSERT_EQUAL_INT(2, ciaaLibs_recBufDropped(&rbuf));
+
+   TEST_ASSERT_EQUAL_INT(2, ciaaLibs_recBufGet(&rbuf, to, sizeof(to)));
+   TEST_ASSERT_EQUAL_MEMORY(&data[6], to, 2);
+   TEST_ASSERT_EQUAL_INT(5, ciaaLibs_recBufGet(&rbuf, to, sizeof(to)));
+   TEST_ASSERT_EQUAL_MEMORY(&data[8], to, 5);
+   TEST_ASSERT_TRUE(ciaaLibs_recBufEmpty(&rbuf));
+
+   /* the biggest record replaces all others */
+   TEST_ASSERT_EQUAL_INT(1, ciaaLibs_recBufPutOverwrite(&rbuf, data, 1));
+   TEST_ASSERT_EQUAL_INT(13, ciaaLibs_recBufPutOverwrite(&rbuf, data, 13));
+   TEST_ASSERT_EQUAL_INT(3, ciaaLibs_recBufDropped(&rbuf));
+   TEST_ASSERT_EQUAL_INT(13, ciaaLibs_recBufGet(&rbuf, to, sizeof(to)));
+   TEST_ASSERT_EQUAL_MEMORY(data, to, 13);
+} /* end test_ciaaLibs_recBufPutOverwrite */
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+
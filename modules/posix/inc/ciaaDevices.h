@@ -48,6 +48,7 @@
 /*==================[inclusions]=============================================*/
 #include "ciaaPOSIX_stdint.h"
 #include "ciaaPOSIX_stddef.h"
+#include "ciaaPOSIX_stdbool.h"
 
 /*==================[cplusplus]==============================================*/
 #ifdef __cplusplus
@@ -55,7 +56,14 @@ extern "C" {
 #endif
 
 /*==================[macros]=================================================*/
-#define ciaaDevices_MAXDEVICES      20
+/** \brief count of buckets of the devices registry
+ **
+ ** Shall be a power of 2. The count of devices is not limited, the buckets
+ ** only define how many devices share a bucket.
+ **/
+#ifndef ciaaDevices_BUCKETS
+#define ciaaDevices_BUCKETS         32
+#endif
 
 /** \brief the file offset shall be set to offset bytes */
 /*@-namechecks@*/
@@ -68,9 +76,27 @@ extern "C" {
 #define SEEK_END                    2
 /*@=namechecks@*/
 
+/** \brief data can be read without blocking */
+#define ciaaPOSIX_POLLIN            0x0001
+
+/** \brief data can be written without blocking */
+#define ciaaPOSIX_POLLOUT           0x0004
+
+/** \brief the file descriptor is not open, only returned in revents */
+#define ciaaPOSIX_POLLNVAL          0x0020
+
 /*==================[typedef]================================================*/
 typedef struct ciaaDevices_deviceStruct ciaaDevices_deviceType;
 
+/** \brief I/O vector type
+ **
+ ** Describes one buffer of a vectored read or write.
+ **/
+typedef struct {
+   void * iov_base;              /** <- address of the buffer */
+   size_t iov_len;               /** <- count of bytes of the buffer */
+} ciaaPOSIX_iovecType;
+
 /** \brief open a device
  **
  ** Open and if needed perform the initialization of the indicated device
@@ -103,6 +129,22 @@ typedef ssize_t (*ciaaDevices_write)(ciaaDevices_deviceType const * const device
 /** \brief lseek function type */
 typedef off_t (*ciaaDevices_lseek)(ciaaDevices_deviceType const * const device, off_t const offset, uint8_t const whence);
 
+/** \brief poll function type
+ **
+ ** Returns the events of events which are ready. If notify is true the
+ ** calling task is registered to be woken with the POSIXE event when one of
+ ** the events gets ready. The registration is removed after waking the
+ ** task, when an event is already ready or when called with notify false.
+ ** Only one task can be registered per device.
+ **/
+typedef int16_t (*ciaaDevices_poll)(ciaaDevices_deviceType const * const device, int16_t const events, bool const notify);
+
+/** \brief vectored read function type */
+typedef ssize_t (*ciaaDevices_readv)(ciaaDevices_deviceType const * const device, ciaaPOSIX_iovecType const * const iov, int32_t const iovcnt);
+
+/** \brief vectored write function type */
+typedef ssize_t (*ciaaDevices_writev)(ciaaDevices_deviceType const * const device, ciaaPOSIX_iovecType const * const iov, int32_t const iovcnt);
+
 /** \brief Device Type */
 struct ciaaDevices_deviceStruct {
    char const * path;            /** <- device path, eg. /dev/serlia/UART1 */
@@ -117,6 +159,12 @@ struct ciaaDevices_deviceStruct {
    void * layer;                 /** <- pointer ot be used by the layer */
    void * loLayer;               /** <- pointer to be provided to the lower
                                         layer */
+   ciaaDevices_readv readv;      /** <- pointer to readv function, NULL if
+                                        read shall be called per buffer */
+   ciaaDevices_writev writev;    /** <- pointer to writev function, NULL if
+                                        write shall be called per buffer */
+   ciaaDevices_poll poll;        /** <- pointer to poll function, NULL if
+                                        the device never blocks */
 };
 
 /** \brief Devices Status
@@ -147,7 +195,8 @@ extern void ciaaDevices_init(void);
 
 /** \brief add deivce
  **
- ** Adds the device device during the initialization.
+ ** Adds the device device during the initialization. A device with the
+ ** path of an already added device is ignored.
  **
  ** \param[in] device device to be added
  **
@@ -157,7 +206,10 @@ extern void ciaaDevices_addDevice(ciaaDevices_deviceType * device);
 
 /** \brief get a device
  **
- ** Get the device with the indicated path.
+ ** Get the device with exactly the indicated path.
+ **
+ ** \param[in] path path of the device
+ ** \return pointer to the device or NULL if not found
  **/
 extern ciaaDevices_deviceType * ciaaDevices_getDevice(char const * const path);
 
@@ -54,6 +54,9 @@ extern "C" {
 /*==================[macros]=================================================*/
 #define EAGAIN 1             /* No more processes */
 #define EWOULDBLOCK EAGAIN   /* Operation would block */
+#define EINVAL 2             /* Invalid argument */
+#define ETIMEDOUT 3          /* Connection timed out */
+#define EBUSY 4              /* Device or resource busy */
 
 /*==================[typedef]================================================*/
 
@@ -62,6 +62,15 @@ extern "C" {
  ** which needs to be cleared/erased before written
  **/
 #define ciaaPOSIX_IOCTL_BLOCK_ERASE       0x8001U
+
+/** \brief Request the pending transfer to be cancelled
+ **
+ ** After this ioctl command returns the driver shall neither access the
+ ** buffer of the cancelled transfer nor indicate its completion. Drivers
+ ** supporting this command return 0 also if no transfer is pending, the
+ ** block devices only accept a read timeout if the driver supports it.
+ **/
+#define ciaaPOSIX_IOCTL_BLOCK_CANCEL      0x8002U
 /*==================[typedef]================================================*/
 /** TODO document */
 typedef struct {
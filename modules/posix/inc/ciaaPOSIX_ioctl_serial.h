@@ -47,6 +47,8 @@
  ** @{ */
 
 /*==================[inclusions]=============================================*/
+#include "ciaaPOSIX_stdint.h"
+#include "ciaaPOSIX_stddef.h"
 
 /*==================[cplusplus]==============================================*/
 #ifdef __cplusplus
@@ -181,7 +183,69 @@ extern "C" {
  **/
 #define ciaaPOSIX_IOCTL_SET_NONBLOCK_MODE              9
 
+/** \brief request an asynchronous read
+ **
+ ** If ioctl is called with this request and param is a ciaaPOSIX_aiocbType *
+ ** the read request is queued and the call returns without blocking. The
+ ** request is completed from the receive indication of the device as soon as
+ ** data is available, the read count is stored in the result field and the
+ ** completion is notified with the callback and/or the event of the control
+ ** block.
+ **
+ ** If param is NULL all pending asynchronous reads are cancelled and
+ ** completed with result -1.
+ **
+ ** Devices without asynchronous requests return -1.
+ **
+ **/
+#define ciaaPOSIX_IOCTL_AIO_READ                       15
+
+/** \brief request an asynchronous write
+ **
+ ** If ioctl is called with this request and param is a ciaaPOSIX_aiocbType *
+ ** the write request is queued and the call returns without blocking. The
+ ** request is completed from the transmit confirmation of the device when
+ ** all its bytes have been stored in the transmit buffer.
+ **
+ ** If param is NULL all pending asynchronous writes are cancelled and
+ ** completed with result -1.
+ **
+ ** Devices without asynchronous requests return -1.
+ **
+ **/
+#define ciaaPOSIX_IOCTL_AIO_WRITE                      13
+
+/** \brief result of an asynchronous request which is still pending */
+#define ciaaPOSIX_AIO_INPROGRESS                       (-2)
+
 /*==================[typedef]================================================*/
+/** \brief asynchronous input/output control block type */
+typedef struct ciaaPOSIX_aiocbStruct ciaaPOSIX_aiocbType;
+
+/** \brief asynchronous input/output completion callback
+ **
+ ** \remarks This callback is called from the context completing the request,
+ **          which may be an ISR or the task submitting the request.
+ **/
+typedef void (*ciaaPOSIX_aioCallbackType)(ciaaPOSIX_aiocbType * aiocb);
+
+/** \brief asynchronous input/output control block
+ **
+ ** The control block is owned by the device from its submission until its
+ ** completion and shall not be modified in the meantime.
+ **/
+struct ciaaPOSIX_aiocbStruct {
+   uint8_t * buf;                         /** <= buffer to be read or written */
+   size_t nbytes;                         /** <= count of bytes */
+   ssize_t result;                        /** <= count of transferred bytes,
+                                                 -1 if cancelled or
+                                                 ciaaPOSIX_AIO_INPROGRESS */
+   ciaaPOSIX_aioCallbackType callback;    /** <= completion callback or NULL */
+   uint32_t task;                         /** <= task to be notified */
+   uint32_t event;                        /** <= event to be set or 0 */
+   size_t count;                          /** <= internal transfer count */
+   ciaaPOSIX_aiocbType * next;            /** <= internal queue link */
+};
 
 /*==================[external data declaration]==============================*/
 
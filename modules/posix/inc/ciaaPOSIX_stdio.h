@@ -60,8 +60,14 @@ extern "C" {
 
 /*==================[macros]=================================================*/
 /** \brief Max count of file descriptors
+ **
+ ** May be defined by the project, eg. -DciaaPOSIX_stdio_MAXFILDES=64. Each
+ ** descriptor costs a descriptor entry and one bit of the free descriptors
+ ** bitmap.
  **/
+#ifndef ciaaPOSIX_stdio_MAXFILDES
 #define ciaaPOSIX_stdio_MAXFILDES      20
+#endif
 
 /** \brief Open for read only */
 #define ciaaPOSIX_O_RDONLY             0x0000
@@ -105,6 +111,20 @@ extern "C" {
  **/
 #define ciaaPOSIX_IOCTL_SET_RESOLUTION                 12
 
+/** \brief set the timeout of the blocking reads
+ **
+ ** This ioctl command is used to bound the time a blocking read on a serial
+ ** or block device waits for data. param shall be a ciaaPOSIX_timeoutType *,
+ ** NULL or a timeout of 0 ticks waits forever. A read which times out
+ ** returns -1 and sets errno to ETIMEDOUT, or EBUSY if the alarm is already
+ ** in use. A timed out block read is cancelled with
+ ** ciaaPOSIX_IOCTL_BLOCK_CANCEL, block devices whose driver does not support
+ ** it reject the timeout.
+ **
+ ** Returned value for ioctl is 0, -1 if the timeout is rejected
+ **/
+#define ciaaPOSIX_IOCTL_SET_TIMEOUT                    14
+
 /** \brief resolution macros for input/output macros for analogic input device
  **/
 #define ciaaRESOLUTION_10BITS       0
@@ -117,6 +137,23 @@ extern "C" {
 #define ciaaRESOLUTION_3BITS        7
 
 /*==================[typedef]================================================*/
+/** \brief timeout type of ciaaPOSIX_IOCTL_SET_TIMEOUT
+ **
+ ** The alarm shall be configured to set the event POSIXE to the task
+ ** performing the read, it is armed once per blocking read.
+ **/
+typedef struct {
+   uint32_t alarm;         /** <= alarm of the timeout */
+   uint32_t ticks;         /** <= ticks of the counter of the alarm, 0 to
+                                 wait forever */
+} ciaaPOSIX_timeoutType;
+
+/** \brief poll file descriptor type */
+typedef struct {
+   int32_t fd;          /** <- file descriptor, ignored if negative */
+   int16_t events;      /** <- requested events, eg. ciaaPOSIX_POLLIN */
+   int16_t revents;     /** <- returned events */
+} ciaaPOSIX_pollfdType;
 
 /*==================[external data declaration]==============================*/
 
@@ -217,6 +254,95 @@ extern ssize_t ciaaPOSIX_read(int32_t fildes, void * buf, size_t nbyte);
  **/
 extern ssize_t ciaaPOSIX_write(int32_t fildes, void const * buf, size_t nbyte);
 
+/** \brief Reads from a file descriptor into several buffers
+ **
+ ** Reads from the file descriptor fildes and fills the iovcnt buffers of iov
+ ** in order. A buffer is only used if all previous buffers have been
+ ** filled.
+ **
+ ** \param[in]  fildes  file descriptor to read from
+ ** \param[in]  iov     buffers to store the read data
+ ** \param[in]  iovcnt  count of buffers, shall be greater than 0
+ ** \return -1 if failed, a non negative integer representing the count of
+ **         read bytes if success
+ **
+ ** \remarks If the device does not provide a readv function ciaaPOSIX_read
+ **          is performed for each buffer until one returns less bytes than
+ **          requested.
+ **/
+extern ssize_t ciaaPOSIX_readv(int32_t fildes, ciaaPOSIX_iovecType const * iov, int32_t iovcnt);
+
+/** \brief Writes several buffers to a file descriptor
+ **
+ ** Writes the iovcnt buffers of iov in order to the file descriptor fildes,
+ ** as if they were a single buffer.
+ **
+ ** \param[in] fildes   file descriptor to write to
+ ** \param[in] iov      buffers with the data to be written
+ ** \param[in] iovcnt   count of buffers, shall be greater than 0
+ ** \return -1 if failed, a non negative integer representing the count of
+ **         written bytes if success
+ **
+ ** \remarks If the device does not provide a writev function ciaaPOSIX_write
+ **          is performed for each buffer until one returns less bytes than
+ **          requested.
+ **/
+extern ssize_t ciaaPOSIX_writev(int32_t fildes, ciaaPOSIX_iovecType const * iov, int32_t iovcnt);
+
+/** \brief Waits for events on several file descriptors
+ **
+ ** Checks the requested events of the nfds file descriptors of fds and, if
+ ** none is ready, blocks the calling task until one of them gets ready or
+ ** the timeout expires. The ready events are returned in revents,
+ ** ciaaPOSIX_POLLNVAL is returned for file descriptors which are not open.
+ ** Devices without poll function are always ready.
+ **
+ ** \param[inout] fds   file descriptors and events
+ ** \param[in] nfds     count of file descriptors
+ ** \param[in] timeout  -1 to wait forever, 0 to return immediately, in other
+ **                     case ticks of the counter of the alarm POSIXA (ms
+ **                     with the usual 1 ms system counter)
+ ** \return -1 if failed, in other case the count of file descriptors with
+ **         revents not 0, 0 if the timeout expired
+ **
+ ** \remarks The calling task shall be an extended task with the POSIXE
+ **          event. A positive timeout needs the alarm POSIXA, which shall
+ **          set POSIXE to the calling task, in other case -1 is returned and
+ **          errno is set to EINVAL.
+ **/
+extern int32_t ciaaPOSIX_poll(ciaaPOSIX_pollfdType * fds, uint32_t nfds, int32_t timeout);
+
+/** \brief Requests an asynchronous read
+ **
+ ** Queues a read of up to aiocbp->nbytes bytes into aiocbp->buf and returns
+ ** without blocking. When data is available the count of read bytes is
+ ** stored in aiocbp->result, aiocbp->callback is called if not NULL and
+ ** aiocbp->event is set to aiocbp->task if not 0.
+ **
+ ** \param[in] fildes   file descriptor to read from
+ ** \param[inout] aiocbp control block of the request
+ ** \return -1 if failed, 0 if the request has been queued or completed
+ **
+ ** \remarks Only serial devices support asynchronous requests. Asynchronous
+ **          and blocking reads shall not be mixed on the same device.
+ **/
+extern int32_t ciaaPOSIX_aio_read(int32_t fildes, ciaaPOSIX_aiocbType * aiocbp);
+
+/** \brief Requests an asynchronous write
+ **
+ ** Queues the write of aiocbp->nbytes bytes from aiocbp->buf and returns
+ ** without blocking. When all bytes have been stored in the transmit buffer
+ ** the request is completed as described for ciaaPOSIX_aio_read.
+ **
+ ** \param[in] fildes   file descriptor to write to
+ ** \param[inout] aiocbp control block of the request
+ ** \return -1 if failed, 0 if the request has been queued or completed
+ **
+ ** \remarks Only serial devices support asynchronous requests. Asynchronous
+ **          and blocking writes shall not be mixed on the same device.
+ **/
+extern int32_t ciaaPOSIX_aio_write(int32_t fildes, ciaaPOSIX_aiocbType * aiocbp);
+
 /** \brief Seek into a file descriptor
  **
  ** Set the read/write position to a given offset.
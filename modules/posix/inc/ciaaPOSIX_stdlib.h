@@ -64,7 +64,67 @@ extern "C" {
 /*@=namechecks@*/
 #endif
 
+/** \brief memory without special requirements */
+#define ciaaPOSIX_MEM_ANY        0x00U
+
+/** \brief memory on the local bus of the core, without wait states */
+#define ciaaPOSIX_MEM_FAST       0x01U
+
+/** \brief memory accessible by the DMA controllers */
+#define ciaaPOSIX_MEM_DMA        0x02U
+
+/** \brief memory shared between the cores */
+#define ciaaPOSIX_MEM_SHARED     0x04U
+
+/** \brief count of bins of the allocation latency histogram */
+#define ciaaPOSIX_stdlib_LATENCYBINS   8
+
+/** \brief count of records of the allocation trace, 0 disables the trace
+ **
+ ** Can be defined in the compiler flags of the project, for example
+ ** CFLAGS += -DciaaPOSIX_stdlib_TRACESIZE=128
+ **/
+#ifndef ciaaPOSIX_stdlib_TRACESIZE
+#define ciaaPOSIX_stdlib_TRACESIZE     0
+#endif
+
+/** \brief size of the trace records of the calls to free */
+#define ciaaPOSIX_stdlib_TRACEFREE     0xFFFFFFFFU
+
 /*==================[typedef]================================================*/
+/** \brief statistics of the allocator */
+typedef struct {
+   size_t used;            /** <= bytes in use, including the slab elements
+                                  and the block headers */
+   size_t peak;            /** <= maximal value of used */
+   uint32_t allocations;   /** <= count of allocation requests */
+   uint32_t failures;      /** <= count of allocation requests which
+                                  returned NULL */
+   uint32_t freeBlocks;    /** <= count of free blocks of the heaps */
+   size_t largestFree;     /** <= size of the largest free block of the
+                                  heaps */
+   uint32_t latency[ciaaPOSIX_stdlib_LATENCYBINS];
+                           /** <= histogram of the allocation latency, the
+                                  first bin counts the allocations faster
+                                  than 64 cycles and each bin doubles the
+                                  limit, the last bin counts all slower
+                                  allocations */
+   uint32_t traceDropped;  /** <= count of trace records lost because the
+                                  trace was full */
+} ciaaPOSIX_stdlib_statsType;
+
+/** \brief allocation trace record
+ **
+ ** realloc is traced as a free of the old memory and an allocation of the
+ ** new memory, also if the memory has been resized in place.
+ **/
+typedef struct {
+   uintptr_t callsite;     /** <= return address of the call */
+   uintptr_t ptr;          /** <= allocated or freed memory, 0 if the
+                                  allocation failed */
+   uint32_t size;          /** <= requested size or
+                                  ciaaPOSIX_stdlib_TRACEFREE */
+} ciaaPOSIX_stdlib_traceType;
 
 /*==================[external data declaration]==============================*/
 
@@ -79,10 +139,65 @@ void ciaaPOSIX_stdlib_init(void);
  **
  ** Allocates unused space
  **
+ ** Requests up to 256 bytes are served in constant time from a slab of the
+ ** power of two size class, bigger requests and requests of a full size
+ ** class are served from the heap.
+ **
  ** \param[in] number of bytes to allocate
  **/
 void *ciaaPOSIX_malloc(size_t size);
 
+/** \brief ciaaPOSIX malloc with placement hint
+ **
+ ** Allocates unused space from a memory region fulfilling all the
+ ** requirements of the hint. The regions are tried in order of
+ ** preference, so the allocation continues in the next region if a
+ ** region is full.
+ **
+ ** \param[in] size number of bytes to allocate
+ ** \param[in] hint ciaaPOSIX_MEM_ANY or a combination of
+ **            ciaaPOSIX_MEM_FAST, ciaaPOSIX_MEM_DMA and ciaaPOSIX_MEM_SHARED
+ ** \return pointer to the allocated memory or NULL if no region fulfilling
+ **         the hint has enough memory
+ **/
+void *ciaaPOSIX_malloc_hint(size_t size, uint32_t hint);
+
+/** \brief ciaaPOSIX memalign
+ **
+ ** Allocates unused space aligned to alignment bytes, for example for DMA
+ ** descriptors or cache lines. All the regions are DMA capable.
+ **
+ ** \param[in] alignment alignment of the memory, shall be a power of two
+ ** \param[in] size number of bytes to allocate
+ ** \return pointer to the allocated memory or NULL if not available or
+ **         if the alignment is not a power of two
+ **/
+void *ciaaPOSIX_memalign(size_t alignment, size_t size);
+
+/** \brief ciaaPOSIX calloc
+ **
+ ** Allocates unused space for an array and sets it to 0
+ **
+ ** \param[in] nmemb number of elements of the array
+ ** \param[in] size size of each element
+ ** \return pointer to the allocated memory or NULL if not available or if
+ **         the size of the array overflows
+ **/
+void *ciaaPOSIX_calloc(size_t nmemb, size_t size);
+
+/** \brief ciaaPOSIX realloc
+ **
+ ** Changes the size of allocated memory. The memory grows in place if the
+ ** next block is free, otherwise it is moved to a region with the same
+ ** attributes and its content is copied.
+ **
+ ** \param[in] ptr pointer to a previously allocated region or NULL
+ ** \param[in] size new number of bytes, if 0 the memory is freed
+ ** \return pointer to the memory or NULL if not available, in this case
+ **         the previous memory is not freed
+ **/
+void *ciaaPOSIX_realloc(void *ptr, size_t size);
+
 /** \brief ciaaPOSIX free
  **
  ** Frees allocated memory
@@ -91,6 +206,28 @@ void *ciaaPOSIX_malloc(size_t size);
  **/
 void ciaaPOSIX_free(void *);
 
+/** \brief ciaaPOSIX stdlib statistics
+ **
+ ** Reads the statistics of the allocator, the free blocks of the heaps
+ ** are counted during the call.
+ **
+ ** \param[out] stats statistics of the allocator
+ **/
+void ciaaPOSIX_stdlib_getStats(ciaaPOSIX_stdlib_statsType *stats);
+
+/** \brief ciaaPOSIX stdlib trace
+ **
+ ** Reads and removes the oldest records of the allocation trace, for
+ ** example to write them to a serial device. The trace is only available
+ ** if ciaaPOSIX_stdlib_TRACESIZE is not 0.
+ **
+ ** \param[out] records buffer for the records
+ ** \param[in] count maximal count of records to be read
+ ** \return count of records read
+ **/
+size_t ciaaPOSIX_stdlib_readTrace(ciaaPOSIX_stdlib_traceType *records,
+      size_t count);
+
 /*==================[cplusplus]==============================================*/
 #ifdef __cplusplus
 }
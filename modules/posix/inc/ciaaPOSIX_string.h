@@ -119,6 +119,19 @@ extern int8_t ciaaPOSIX_strcmp(char const * s1, char const * s2);
  **/
 extern void * ciaaPOSIX_memcpy(void * s1, void const * s2, size_t n);
 
+/** \brief copy bytes of memory which may overlap
+ **
+ ** copy n bytes from s2 to s1, the result is correct also if both memory
+ ** areas overlap.
+ **
+ ** \param[out] s1 destination pointer
+ ** \param[in] s2 source pointer
+ ** \param[in] n count of bytes to be copied
+ ** \return returns the input parameter s1
+ **
+ **/
+extern void * ciaaPOSIX_memmove(void * s1, void const * s2, size_t n);
+
 /** \brief set n bytes to memory to (uint8_t)c
  **
  ** set n bytes of memory to the value of c casted to uint8_t.
@@ -144,6 +157,31 @@ extern void * ciaaPOSIX_memset(void * s, int c, size_t n);
  **/
 extern int32_t ciaaPOSIX_memcmp(const void * s1, const void * s2, size_t n);
 
+/** \brief find a byte in memory
+ **
+ ** search the first byte equal to c casted to uint8_t in the first n bytes
+ ** of s.
+ **
+ ** \param[in] s pointer to the memory to be searched
+ ** \param[in] c byte to be found
+ ** \param[in] n count of bytes to be searched
+ ** \return pointer to the found byte or NULL if not found
+ **
+ **/
+extern void * ciaaPOSIX_memchr(void const * s, int c, size_t n);
+
+/** \brief find a char in a string
+ **
+ ** search the first char equal to c casted to char in the string s, the
+ ** null termination is part of the string.
+ **
+ ** \param[in] s string to be searched
+ ** \param[in] c char to be found
+ ** \return pointer to the found char or NULL if not found
+ **
+ **/
+extern char * ciaaPOSIX_strchr(char const * s, int c);
+
 /*==================[cplusplus]==============================================*/
 #ifdef __cplusplus
 }
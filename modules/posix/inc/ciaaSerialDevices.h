@@ -110,6 +110,14 @@ extern int32_t ciaaSerialDevices_close(ciaaDevices_deviceType const * const devi
  **               ciaaPOSIX_IOCTL_GET_TX_SPACE
  **                  param shall be an uint32_t*
  **                  the count free of bytes in the TX circular buffer are returned
+ **               ciaaPOSIX_IOCTL_AIO_READ
+ **                  param shall be a ciaaPOSIX_aiocbType* to queue an
+ **                  asynchronous read or NULL to cancel the pending ones,
+ **                  fails with EBUSY while a task is blocked in read
+ **               ciaaPOSIX_IOCTL_AIO_WRITE
+ **                  param shall be a ciaaPOSIX_aiocbType* to queue an
+ **                  asynchronous write or NULL to cancel the pending ones,
+ **                  fails with EBUSY while a task is blocked in write
  **               other values see serial device driver
  ** \param[in]  param
  ** \return     a negative value if failed, a positive value
@@ -124,7 +132,8 @@ extern int32_t ciaaSerialDevices_ioctl(ciaaDevices_deviceType const * const devi
  ** \param[in]  device  pointer to the device to be read
  ** \param[out] buf     buffer to store the read data
  ** \param[in]  nbyte   count of bytes to be read
- ** \return     the count of read bytes is returned
+ ** \return     the count of read bytes is returned, -1 with errno EBUSY
+ **             if asynchronous reads are pending
  **
  **/
 extern ssize_t ciaaSerialDevices_read(ciaaDevices_deviceType const * const device, uint8_t * const buf, size_t const nbyte);
@@ -136,10 +145,37 @@ extern ssize_t ciaaSerialDevices_read(ciaaDevices_deviceType const * const devic
  ** \param[in]  device  device to be written
  ** \param[in]  buf     buffer with the data to be written
  ** \param[in]  nbyte   count of bytes to be written
- ** \return     the count of bytes written
+ ** \return     the count of bytes written, -1 with errno EBUSY if
+ **             asynchronous writes are pending
  **/
 extern ssize_t ciaaSerialDevices_write(ciaaDevices_deviceType const * device, uint8_t const * const buf, size_t const nbyte);
 
+/** \brief Polls a serial device
+ **
+ ** ciaaPOSIX_POLLIN is ready if the rx buffer has data and ciaaPOSIX_POLLOUT
+ ** if the tx buffer has space.
+ **
+ ** \param[in]  device  device to be polled
+ ** \param[in]  events  requested events
+ ** \param[in]  notify  register the calling task to be woken by the next
+ **                     requested event if none is ready
+ ** \return     the ready events
+ **/
+extern int16_t ciaaSerialDevices_poll(ciaaDevices_deviceType const * const device, int16_t const events, bool const notify);
+
+/** \brief Writes several buffers to a serial device
+ **
+ ** Stores the buffers one after the other in the transmit buffer and starts
+ ** the transmission once per filling of the transmit buffer.
+ **
+ ** \param[in]  device  device to be written
+ ** \param[in]  iov     buffers with the data to be written
+ ** \param[in]  iovcnt  count of buffers
+ ** \return     the count of bytes written, -1 with errno EBUSY if
+ **             asynchronous writes are pending
+ **/
+extern ssize_t ciaaSerialDevices_writev(ciaaDevices_deviceType const * const device, ciaaPOSIX_iovecType const * const iov, int32_t const iovcnt);
+
 /** \brief Transmit confirmation of a serial device
  **
  ** This interface informs the serial device that a recepction has been completed
@@ -65,6 +65,7 @@ typedef struct {
 typedef struct {
    ciaaDevices_deviceType const * device;
    ciaaBlockDevices_blockerType blocked;
+   ciaaPOSIX_timeoutType timeout;
    uint8_t flags;
 } ciaaBlockDevices_deviceType;
 
@@ -110,6 +111,7 @@ extern void ciaaBlockDevices_init(void)
       /* set invalid task as default */
       ciaaBlockDevices.devstr[loopi].blocked.taskID = 255; /* TODO */
       ciaaBlockDevices.devstr[loopi].blocked.fct = NULL;
+      ciaaBlockDevices.devstr[loopi].timeout.ticks = 0;
    }
 }
 
@@ -151,6 +153,9 @@ extern void ciaaBlockDevices_addDriver(ciaaDevices_deviceType * driver)
       newDevice->read = ciaaBlockDevices_read;
       newDevice->write = ciaaBlockDevices_write;
       newDevice->lseek = ciaaBlockDevices_lseek;
+      newDevice->readv = NULL;
+      newDevice->writev = NULL;
+      newDevice->poll = NULL;
 
       /* store layers information information */
       newDevice->layer = (void *) &ciaaBlockDevices.devstr[position];
@@ -224,6 +229,31 @@ extern int32_t ciaaBlockDevices_ioctl(ciaaDevices_deviceType const * const devic
 
    switch(request)
    {
+      case ciaaPOSIX_IOCTL_SET_TIMEOUT:
+         if (NULL == param)
+         {
+            blockDevice->timeout.ticks = 0;
+            ret = 0;
+         }
+         /* a timed out read has to be cancelled in the driver */
+         else if (0 == blockDevice->device->ioctl(device->loLayer,
+                  ciaaPOSIX_IOCTL_BLOCK_CANCEL, NULL))
+         {
+            blockDevice->timeout = *(ciaaPOSIX_timeoutType *)param;
+            ret = 0;
+         }
+         else
+         {
+            ret = -1;
+         }
+         break;
+
+      case ciaaPOSIX_IOCTL_AIO_READ:
+      case ciaaPOSIX_IOCTL_AIO_WRITE:
+         /* asynchronous requests are not supported by block devices */
+         ret = -1;
+         break;
+
       default:
          ret = blockDevice->device->ioctl(device->loLayer, request, param);
          break;
@@ -237,6 +267,8 @@ extern ssize_t ciaaBlockDevices_read(ciaaDevices_deviceType const * const device
    ciaaBlockDevices_deviceType * blockDevice =
       (ciaaBlockDevices_deviceType*) device->layer;
    ssize_t ret = 0;
+   StatusType status;
+   bool timedOut;
 
    /* trigger read data from lower layer */
    ret = blockDevice->device->read(device->loLayer, buf, nbyte);
@@ -248,16 +280,55 @@ extern ssize_t ciaaBlockDevices_read(ciaaDevices_deviceType const * const device
       GetTaskID(&blockDevice->blocked.taskID);
       blockDevice->blocked.fct = (void*) ciaaBlockDevices_read;
 
+      /* TODO improve this */
+      /* for the first impl. the driver shall return as much bytes as requested */
+      ret = nbyte;
+
       /* if no data wait for it */
 #ifdef POSIXE
-      WaitEvent(POSIXE);
-      ClearEvent(POSIXE);
+      if (0 == blockDevice->timeout.ticks)
+      {
+         WaitEvent(POSIXE);
+         ClearEvent(POSIXE);
+      }
+      else
+      {
+         /* the alarm wakes the task if the read is not indicated in time,
+          * if the alarm can not be set the read is not awaited */
+         status = SetRelAlarm((AlarmType)blockDevice->timeout.alarm,
+               (TickType)blockDevice->timeout.ticks, 0);
+         if (E_OK == status)
+         {
+            WaitEvent(POSIXE);
+            ClearEvent(POSIXE);
+         }
+
+         /* the read indication invalidates the task id */
+         SuspendAllInterrupts();
+         timedOut = (255 != blockDevice->blocked.taskID);
+         blockDevice->blocked.taskID = 255;
+         blockDevice->blocked.fct = NULL;
+         ResumeAllInterrupts();
+
+         if (E_OK == status)
+         {
+            /* the alarm may have expired after the read indication */
+            CancelAlarm((AlarmType)blockDevice->timeout.alarm);
+         }
+         ClearEvent(POSIXE);
+
+         if (timedOut)
+         {
+            /* the driver shall not store data in buf after returning */
+            blockDevice->device->ioctl(device->loLayer,
+                  ciaaPOSIX_IOCTL_BLOCK_CANCEL, NULL);
+
+            ciaaPOSIX_errno = (E_OK == status) ? ETIMEDOUT : EBUSY;
+            ret = -1;
+         }
+      }
 #else
 #endif
-
-      /* TODO improve this */
-      /* for the first impl. the driver shall return as much bytes as requested */
-      ret = nbyte;
    }
 
    return ret;
@@ -344,8 +415,8 @@ extern void ciaaBlockDevices_readIndication(ciaaDevices_deviceType const * const
 #else
 #endif
    } else {
-      /* this shall not happens */
-      ciaaPOSIX_assert(0);
+      /* this shall only happen if the read has timed out */
+      ciaaPOSIX_assert(0 != blockDevice->timeout.ticks);
    }
 }
 
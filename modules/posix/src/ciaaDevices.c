@@ -47,48 +47,119 @@
 #include "ciaaPOSIX_stdbool.h"
 #include "ciaaPOSIX_string.h"
 #include "ciaaPOSIX_stdio.h"
+#include "ciaak.h"       /* <= ciaa kernel header */
 
 /*==================[macros and definitions]=================================*/
+/** \brief FNV-1a offset basis */
+#define ciaaDevices_HASHBASIS       0x811C9DC5U
+
+/** \brief FNV-1a prime */
+#define ciaaDevices_HASHPRIME       0x01000193U
 
 /*==================[typedef]================================================*/
+/** \brief Device node type
+ **
+ ** Links a device in a bucket of the registry.
+ **/
+typedef struct ciaaDevices_nodeStruct {
+   struct ciaaDevices_nodeStruct * next;  /** <- next node of the bucket */
+   ciaaDevices_deviceType * device;       /** <- registered device */
+   uint32_t hash;                         /** <- hash of the device path */
+} ciaaDevices_nodeType;
+
 /** \brief Devices type */
 typedef struct {
-   ciaaDevices_deviceType * device[ciaaDevices_MAXDEVICES];
-   uint8_t position;
+   ciaaDevices_nodeType * bucket[ciaaDevices_BUCKETS];
 } ciaaDevices_devicesType;
 
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
+/** \brief calculate the hash of a path
+ **
+ ** \param[in] path path to be hashed
+ ** \return FNV-1a hash of the path
+ **/
+static uint32_t ciaaDevices_hash(char const * path);
+
+/** \brief search a device
+ **
+ ** \param[in] path path of the device
+ ** \param[in] hash hash of the path
+ ** \return pointer to the node of the device or NULL if not found
+ **/
+static ciaaDevices_nodeType * ciaaDevices_find(char const * path, uint32_t hash);
 
 /*==================[internal data definition]===============================*/
-/** \brief List of devices */
+/** \brief Registry of devices */
 static ciaaDevices_devicesType ciaaDevices;
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static uint32_t ciaaDevices_hash(char const * path)
+{
+   uint32_t hash = ciaaDevices_HASHBASIS;
+
+   while(0 != *path)
+   {
+      hash ^= (uint8_t)*path;
+      hash *= ciaaDevices_HASHPRIME;
+      path++;
+   }
+
+   return hash;
+}
+
+static ciaaDevices_nodeType * ciaaDevices_find(char const * path, uint32_t hash)
+{
+   ciaaDevices_nodeType * node;
+
+   /* search in the bucket, the path is only compared if the hash matches */
+   node = ciaaDevices.bucket[hash & (ciaaDevices_BUCKETS - 1)];
+   while((NULL != node) &&
+         ((hash != node->hash) || (0 != ciaaPOSIX_strcmp(path, node->device->path))))
+   {
+      node = node->next;
+   }
+
+   return node;
+}
 
 /*==================[external functions definition]==========================*/
 extern void ciaaDevices_init(void)
 {
-   /* reset position of the devices */
-   ciaaDevices.position = 0;
+   uint32_t loopi;
+
+   /* reset the buckets of the registry */
+   for(loopi = 0; loopi < ciaaDevices_BUCKETS; loopi++)
+   {
+      ciaaDevices.bucket[loopi] = NULL;
+   }
 }
 
 extern void ciaaDevices_addDevice(ciaaDevices_deviceType * device)
 {
+   ciaaDevices_nodeType * node;
+   uint32_t hash = ciaaDevices_hash(device->path);
+
    /* enter critical section */
    /* not needed, only 1 task running */
 
-   /* check if positions are empty for more devices */
-   if (ciaaDevices.position < (uint8_t)ciaaDevices_MAXDEVICES)
+   /* check that the path is not already registered */
+   if (NULL == ciaaDevices_find(device->path, hash))
    {
-      /* store the device in the list */
-      ciaaDevices.device[ciaaDevices.position] = device;
+      /* the nodes are never freed, they are taken from the boot arena */
+      node = (ciaaDevices_nodeType *)ciaak_malloc(sizeof(ciaaDevices_nodeType));
 
-      /* increment the device position */
-      ciaaDevices.position++;
+      if (NULL != node)
+      {
+         /* store the device in front of its bucket */
+         node->device = device;
+         node->hash = hash;
+         node->next = ciaaDevices.bucket[hash & (ciaaDevices_BUCKETS - 1)];
+         ciaaDevices.bucket[hash & (ciaaDevices_BUCKETS - 1)] = node;
+      }
    }
 
    /* exit critical section */
@@ -97,23 +168,16 @@ extern void ciaaDevices_addDevice(ciaaDevices_deviceType * device)
 
 extern ciaaDevices_deviceType * ciaaDevices_getDevice(char const * const path)
 {
-   bool found = false;
    ciaaDevices_deviceType * ret = NULL;
-   uint8_t device;
+   ciaaDevices_nodeType * node;
 
-   /* search over all devices */
-   for(device = 0; (device < ciaaDevices.position) && !found; device++)
-   {
-      /* if the same path is found */
-      if (ciaaPOSIX_strncmp(path, ciaaDevices.device[device]->path,
-               ciaaPOSIX_strlen(ciaaDevices.device[device]->path)) == 0)
-      {
-         /* return the device */
-         ret = ciaaDevices.device[device];
+   node = ciaaDevices_find(path, ciaaDevices_hash(path));
 
-         /* break the loop */
-         found = true;
-      }
+   /* if the same path is found */
+   if (NULL != node)
+   {
+      /* return the device */
+      ret = node->device;
    }
 
    return ret;
@@ -127,6 +127,9 @@ extern void ciaaDioDevices_addDriver(ciaaDevices_deviceType * driver)
       newDevice->ioctl = ciaaDioDevices_ioctl;
       newDevice->read = ciaaDioDevices_read;
       newDevice->write = ciaaDioDevices_write;
+      newDevice->readv = NULL;
+      newDevice->writev = NULL;
+      newDevice->poll = NULL;
 
       /* store layers information information */
       newDevice->layer = (void*) &ciaaDioDevices.devstr[position];
@@ -189,7 +192,18 @@ extern int32_t ciaaDioDevices_ioctl(ciaaDevices_deviceType const * const device,
    int32_t ret;
    ciaaDevices_deviceType * drv = (ciaaDevices_deviceType*) device->loLayer;
 
-   ret = drv->ioctl(drv, request, param);
+   switch(request)
+   {
+      case ciaaPOSIX_IOCTL_AIO_READ:
+      case ciaaPOSIX_IOCTL_AIO_WRITE:
+         /* asynchronous requests are not supported by dio devices */
+         ret = -1;
+         break;
+
+      default:
+         ret = drv->ioctl(drv, request, param);
+         break;
+   }
 
    return ret;
 }
@@ -47,6 +47,9 @@
 #include "ciaaPOSIX_string.h"
 #include "ciaaPOSIX_stdlib.h"
 #include "ciaaPOSIX_assert.h"
+#include "ciaaPOSIX_errno.h"
+#include "ciaaLibs_Atomic.h"
+#include "ciaaLibs_Maths.h"
 #include "os.h"
 
 /* in windows and posix also include posix interfaces */
@@ -56,16 +59,48 @@
 #endif
 
 /*==================[macros and definitions]=================================*/
+/** \brief count of words of the free file descriptors bitmap */
+#define ciaaPOSIX_stdio_FREEWORDS   ((ciaaPOSIX_stdio_MAXFILDES + 31) / 32)
 
 /*==================[internal data declaration]==============================*/
 /** \brief Filedescriptor type */
 typedef struct {
-   ciaaDevices_deviceType * device;
+   ciaaDevices_deviceType * device; /** <- opened device, NULL if not used */
+   off_t offset;                    /** <- position reported by the device */
+   TaskType owner;                  /** <- task which opened the descriptor */
+   uint8_t flags;                   /** <- oflag passed to open */
 } ciaaPOSIX_stdio_fildesType;
 
 /*==================[internal functions declaration]=========================*/
+/** \brief claim a free file descriptor
+ **
+ ** Clears the bit of the lowest free file descriptor in the bitmap with
+ ** a compare and swap, no critical section is needed.
+ **
+ ** \return the claimed file descriptor or -1 if all are used
+ **/
+static int32_t ciaaPOSIX_stdio_claim(void);
+
+/** \brief return a file descriptor to the free bitmap
+ **
+ ** \param[in] fildes file descriptor to be released
+ **/
+static void ciaaPOSIX_stdio_release(int32_t fildes);
+
+/** \brief get the ready events of several file descriptors
+ **
+ ** \param[inout] fds   file descriptors, revents is set
+ ** \param[in] nfds     count of file descriptors
+ ** \param[in] notify   register the calling task in the devices if no event
+ **                     is ready, and remove the registration if false
+ ** \return count of file descriptors with revents not 0
+ **/
+static int32_t ciaaPOSIX_stdio_pollDevices(ciaaPOSIX_pollfdType * fds, uint32_t nfds, bool notify);
 
 /*==================[internal data definition]===============================*/
+/** \brief Free file descriptors, a set bit indicates a free descriptor */
+static uint32_t ciaaPOSIX_stdio_free[ciaaPOSIX_stdio_FREEWORDS];
+
 
 /*==================[external data definition]===============================*/
 /** \brief List of files descriptors */
@@ -75,6 +110,87 @@ ciaaPOSIX_stdio_fildesType ciaaPOSIX_stdio_fildes[ciaaPOSIX_stdio_MAXFILDES];
 char const * const ciaaPOSIX_stdio_devPrefix = "/dev";
 
 /*==================[internal functions definition]==========================*/
+static int32_t ciaaPOSIX_stdio_claim(void)
+{
+   int32_t ret = -1;
+   uint32_t word;
+   uint32_t free;
+   uint8_t bit;
+
+   for(word = 0; (word < ciaaPOSIX_stdio_FREEWORDS) && (-1 == ret); word++)
+   {
+      free = ciaaLibs_atomicLoadAcquire(&ciaaPOSIX_stdio_free[word]);
+
+      /* a failed compare and swap reloads free, retry while the word has
+       * free descriptors */
+      while((0 != free) && (-1 == ret))
+      {
+         bit = ciaaLibs_ctz(free);
+         if (ciaaLibs_atomicCas(&ciaaPOSIX_stdio_free[word], &free,
+                  free & ~((uint32_t)1 << bit)))
+         {
+            ret = (int32_t)((word * 32) + bit);
+         }
+      }
+   }
+
+   return ret;
+}
+
+static void ciaaPOSIX_stdio_release(int32_t fildes)
+{
+   (void)ciaaLibs_atomicFetchOr(&ciaaPOSIX_stdio_free[(uint32_t)fildes / 32],
+         (uint32_t)1 << ((uint32_t)fildes % 32));
+}
+
+static int32_t ciaaPOSIX_stdio_pollDevices(ciaaPOSIX_pollfdType * fds, uint32_t nfds, bool notify)
+{
+   ciaaDevices_deviceType * device;
+   int32_t ret = 0;
+   uint32_t loopi;
+
+   for(loopi = 0; loopi < nfds; loopi++)
+   {
+      fds[loopi].revents = 0;
+
+      if ( (fds[loopi].fd >= 0) && (fds[loopi].fd < ciaaPOSIX_stdio_MAXFILDES) )
+      {
+         device = ciaaPOSIX_stdio_fildes[fds[loopi].fd].device;
+
+         if (NULL == device)
+         {
+            fds[loopi].revents = ciaaPOSIX_POLLNVAL;
+         }
+         else if (NULL == device->poll)
+         {
+            /* the device never blocks */
+            fds[loopi].revents = fds[loopi].events &
+               (ciaaPOSIX_POLLIN | ciaaPOSIX_POLLOUT);
+         }
+         else
+         {
+            /* the task only needs to be registered until an event is ready */
+            fds[loopi].revents = device->poll(device, fds[loopi].events,
+                  notify && (0 == ret));
+         }
+      }
+      else if (fds[loopi].fd >= 0)
+      {
+         fds[loopi].revents = ciaaPOSIX_POLLNVAL;
+      }
+      else
+      {
+         /* negative file descriptors are ignored */
+      }
+
+      if (0 != fds[loopi].revents)
+      {
+         ret++;
+      }
+   }
+
+   return ret;
+}
 
 /*==================[external functions definition]==========================*/
 void ciaaPOSIX_init(void)
@@ -85,6 +201,15 @@ void ciaaPOSIX_init(void)
    for (loopi = 0; loopi < ciaaPOSIX_stdio_MAXFILDES; loopi++) {
       ciaaPOSIX_stdio_fildes[loopi].device = NULL;
    }
+
+   /* mark all file descriptors as free, the bits after the last one stay
+    * cleared */
+   for (loopi = 0; loopi < ciaaPOSIX_stdio_FREEWORDS; loopi++) {
+      ciaaPOSIX_stdio_free[loopi] = 0;
+   }
+   for (loopi = 0; loopi < ciaaPOSIX_stdio_MAXFILDES; loopi++) {
+      ciaaPOSIX_stdio_free[loopi / 32] |= (uint32_t)1 << (loopi % 32);
+   }
 }
 
 extern int32_t ciaaPOSIX_open(char const * path, uint8_t oflag)
@@ -92,7 +217,6 @@ extern int32_t ciaaPOSIX_open(char const * path, uint8_t oflag)
    ciaaDevices_deviceType * device;
    ciaaDevices_deviceType * rewriteDevice;
    int32_t ret = -1;
-   int8_t loopi;
 
    /* check if device */
    if (ciaaPOSIX_strncmp(path,
@@ -105,39 +229,18 @@ extern int32_t ciaaPOSIX_open(char const * path, uint8_t oflag)
       /* if a device has been found */
       if (NULL != device)
       {
-         /* search a file descriptor */
-         for(loopi = 0; (loopi < ciaaPOSIX_stdio_MAXFILDES) && (-1 == ret); loopi++)
-         {
-            /* enter critical section */
-#ifdef POSIXR
-            /* in production mode only returns E_OK */
-            (void)GetResource(POSIXR);
-#else /* #ifdef POSIXR */
-            SuspendOSInterrupts();
-#endif /* #ifdef POSIXR */
-
-            /* if file descriptor not used, use it */
-            if (NULL == ciaaPOSIX_stdio_fildes[loopi].device)
-            {
-               /* load device in descriptor */
-               ciaaPOSIX_stdio_fildes[loopi].device = device;
-
-               /* return file descriptor */
-               ret = loopi;
-            }
-
-            /* exit critical section */
-#ifdef POSIXR
-            /* in production mode only returns E_OK */
-            (void)ReleaseResource(POSIXR);
-#else /* #ifdef POSIXR */
-            ResumeOSInterrupts();
-#endif /* #ifdef POSIXR */
-         }
+         /* claim a file descriptor */
+         ret = ciaaPOSIX_stdio_claim();
 
          /* if a file descriptor has been found */
          if (-1 != ret)
          {
+            /* load device in descriptor */
+            ciaaPOSIX_stdio_fildes[ret].device = device;
+            ciaaPOSIX_stdio_fildes[ret].offset = 0;
+            ciaaPOSIX_stdio_fildes[ret].flags = oflag;
+            (void)GetTaskID(&ciaaPOSIX_stdio_fildes[ret].owner);
+
             /* open device */
             rewriteDevice = ciaaPOSIX_stdio_fildes[ret].device->open(path,
                   ciaaPOSIX_stdio_fildes[ret].device,
@@ -151,24 +254,9 @@ extern int32_t ciaaPOSIX_open(char const * path, uint8_t oflag)
             {
                /* device could not be opened */
 
-               /* enter critical section */
-#ifdef POSIXR
-               /* in production mode only returns E_OK */
-               (void)GetResource(POSIXR);
-#else /* #ifdef POSIXR */
-               SuspendOSInterrupts();
-#endif /* #ifdef POSIXR */
-
-               /* remove device from file descriptor */
+               /* remove device from file descriptor and free it */
                ciaaPOSIX_stdio_fildes[ret].device = NULL;
-
-               /* exit critical section */
-#ifdef POSIXR
-               /* in production mode only returns E_OK */
-               (void)ReleaseResource(POSIXR);
-#else /* #ifdef POSIXR */
-               ResumeOSInterrupts();
-#endif /* #ifdef POSIXR */
+               ciaaPOSIX_stdio_release(ret);
 
                /* return an error */
                ret = -1;
@@ -199,6 +287,7 @@ int32_t ciaaPOSIX_close(int32_t fildes)
          {
             /* free file descriptor, file has been closed */
             ciaaPOSIX_stdio_fildes[fildes].device = NULL;
+            ciaaPOSIX_stdio_release(fildes);
          }
          else
          {
@@ -224,8 +313,9 @@ int32_t ciaaPOSIX_ioctl (int32_t fildes, int32_t request, void * param)
          switch(request)
          {
             case ciaaPOSIX_IOCTL_RXINDICATION:
-               /* store callback */
-               /* TODO continue here */
+               /* the rx indication is internal to the drivers, the
+                * asynchronous reads use ciaaPOSIX_IOCTL_AIO_READ */
+               ret = -1;
                break;
 
             default:
@@ -258,6 +348,11 @@ ssize_t ciaaPOSIX_read(int32_t fildes, void * buf, size_t nbyte)
                ciaaPOSIX_stdio_fildes[fildes].device,
                buf,
                nbyte);
+
+         if (0 < ret)
+         {
+            ciaaPOSIX_stdio_fildes[fildes].offset += ret;
+         }
       }
    }
 
@@ -279,12 +374,218 @@ extern ssize_t ciaaPOSIX_write (int32_t fildes, void const * buf, size_t nbyte)
                ciaaPOSIX_stdio_fildes[fildes].device,
                buf,
                nbyte);
+
+         if (0 < ret)
+         {
+            ciaaPOSIX_stdio_fildes[fildes].offset += ret;
+         }
       }
    }
 
    return ret;
 }
 
+extern ssize_t ciaaPOSIX_readv(int32_t fildes, ciaaPOSIX_iovecType const * iov, int32_t iovcnt)
+{
+   ciaaDevices_deviceType * device;
+   ssize_t ret = -1;
+   ssize_t read;
+   int32_t loopi;
+
+   /* check that file descriptor is on range */
+   if ( (fildes >= 0) && (fildes < ciaaPOSIX_stdio_MAXFILDES) && (0 < iovcnt) )
+   {
+      device = ciaaPOSIX_stdio_fildes[fildes].device;
+
+      /* check that file descriptor is beeing used */
+      if (NULL != device)
+      {
+         if (NULL != device->readv)
+         {
+            /* the device scatters the data by itself */
+            ret = device->readv(device, iov, iovcnt);
+         }
+         else
+         {
+            /* read each buffer until less bytes than requested are read */
+            ret = 0;
+            read = 0;
+            for(loopi = 0; (loopi < iovcnt) && (0 <= read) &&
+                  ((0 == loopi) || ((size_t)read == iov[loopi - 1].iov_len)); loopi++)
+            {
+               read = device->read(device, iov[loopi].iov_base, iov[loopi].iov_len);
+               if (0 < read)
+               {
+                  ret += read;
+               }
+               else if ((0 > read) && (0 == loopi))
+               {
+                  /* only an error of the first read is reported */
+                  ret = -1;
+               }
+            }
+         }
+
+         if (0 < ret)
+         {
+            ciaaPOSIX_stdio_fildes[fildes].offset += ret;
+         }
+      }
+   }
+
+   return ret;
+}
+
+extern ssize_t ciaaPOSIX_writev(int32_t fildes, ciaaPOSIX_iovecType const * iov, int32_t iovcnt)
+{
+   ciaaDevices_deviceType * device;
+   ssize_t ret = -1;
+   ssize_t written;
+   int32_t loopi;
+
+   /* check that file descriptor is on range */
+   if ( (fildes >= 0) && (fildes < ciaaPOSIX_stdio_MAXFILDES) && (0 < iovcnt) )
+   {
+      device = ciaaPOSIX_stdio_fildes[fildes].device;
+
+      /* check that file descriptor is beeing used */
+      if (NULL != device)
+      {
+         if (NULL != device->writev)
+         {
+            /* the device gathers the data by itself */
+            ret = device->writev(device, iov, iovcnt);
+         }
+         else
+         {
+            /* write each buffer until less bytes than requested are written */
+            ret = 0;
+            written = 0;
+            for(loopi = 0; (loopi < iovcnt) && (0 <= written) &&
+                  ((0 == loopi) || ((size_t)written == iov[loopi - 1].iov_len)); loopi++)
+            {
+               written = device->write(device, iov[loopi].iov_base, iov[loopi].iov_len);
+               if (0 < written)
+               {
+                  ret += written;
+               }
+               else if ((0 > written) && (0 == loopi))
+               {
+                  /* only an error of the first write is reported */
+                  ret = -1;
+               }
+            }
+         }
+
+         if (0 < ret)
+         {
+            ciaaPOSIX_stdio_fildes[fildes].offset += ret;
+         }
+      }
+   }
+
+   return ret;
+}
+
+extern int32_t ciaaPOSIX_poll(ciaaPOSIX_pollfdType * fds, uint32_t nfds, int32_t timeout)
+{
+   int32_t ret = -1;
+   bool expired = false;
+#ifdef POSIXA
+   bool armed = false;
+   TickType ticks;
+#endif
+
+   if ((NULL == fds) && (0 != nfds))
+   {
+      /* invalid parameters */
+   }
+#ifndef POSIXA
+   else if (0 < timeout)
+   {
+      /* a timeout can not be supervised without alarm */
+      ciaaPOSIX_errno = EINVAL;
+   }
+#endif
+   else
+   {
+      do
+      {
+         /* register the task in the devices if it will wait */
+         ret = ciaaPOSIX_stdio_pollDevices(fds, nfds, (0 != timeout));
+
+         if ((0 == ret) && (0 != timeout))
+         {
+#ifdef POSIXA
+            if ((0 < timeout) && (false == armed))
+            {
+               /* the alarm sets POSIXE when the timeout expires */
+               (void)SetRelAlarm(POSIXA, (TickType)timeout, 0);
+               armed = true;
+            }
+#endif
+
+#ifdef POSIXE
+            WaitEvent(POSIXE);
+            ClearEvent(POSIXE);
+#endif
+
+#ifdef POSIXA
+            /* the alarm is not running anymore if it has expired */
+            expired = armed && (E_OK != GetAlarm(POSIXA, &ticks));
+#endif
+         }
+      }
+      while ((0 == ret) && (0 != timeout) && (false == expired));
+
+      if (0 != timeout)
+      {
+         /* remove the registrations and get the final events */
+         ret = ciaaPOSIX_stdio_pollDevices(fds, nfds, false);
+
+#ifdef POSIXA
+         if (armed && (false == expired))
+         {
+            (void)CancelAlarm(POSIXA);
+         }
+#endif
+
+#ifdef POSIXE
+         /* a device may have set the event after the last wait */
+         ClearEvent(POSIXE);
+#endif
+      }
+   }
+
+   return ret;
+}
+
+extern int32_t ciaaPOSIX_aio_read(int32_t fildes, ciaaPOSIX_aiocbType * aiocbp)
+{
+   int32_t ret = -1;
+
+   /* a NULL control block would cancel the pending requests */
+   if (NULL != aiocbp)
+   {
+      ret = ciaaPOSIX_ioctl(fildes, ciaaPOSIX_IOCTL_AIO_READ, aiocbp);
+   }
+
+   return ret;
+}
+
+extern int32_t ciaaPOSIX_aio_write(int32_t fildes, ciaaPOSIX_aiocbType * aiocbp)
+{
+   int32_t ret = -1;
+
+   /* a NULL control block would cancel the pending requests */
+   if (NULL != aiocbp)
+   {
+      ret = ciaaPOSIX_ioctl(fildes, ciaaPOSIX_IOCTL_AIO_WRITE, aiocbp);
+   }
+
+   return ret;
+}
+
 extern off_t ciaaPOSIX_lseek(int32_t fildes, off_t offset, uint8_t whence)
 {
    ssize_t ret = -1;
@@ -300,6 +601,11 @@ extern off_t ciaaPOSIX_lseek(int32_t fildes, off_t offset, uint8_t whence)
                ciaaPOSIX_stdio_fildes[fildes].device,
                offset,
                whence);
+
+         if (0 <= ret)
+         {
+            ciaaPOSIX_stdio_fildes[fildes].offset = ret;
+         }
       }
    }
 
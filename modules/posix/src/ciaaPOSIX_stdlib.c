@@ -48,131 +48,1346 @@
 /*==================[inclusions]=============================================*/
 #include "ciaaPOSIX_stdlib.h"
 #include "ciaaPOSIX_stdint.h"
+#include "ciaaPOSIX_string.h"
+#include "ciaaPlatforms.h"
+#include "ciaaLibs_PoolBuf.h"
+#include "ciaaLibs_Maths.h"
+#include "ciaaLibs_Atomic.h"
 
 /*==================[macros and definitions]=================================*/
 
+#if (cortexM0 == ARCH)
+/** \brief size of the heap region of the main RAM, the cortex M0 image
+ ** keeps all its data in the 16 KB of RamAHB_ETB16 */
+#define CIAA_HEAP_MEM_SIZE 8192
+
+/** \brief count of elements of the slabs, one or few of each size class */
+#define CIAA_POSIX_SLAB8_COUNT 4
+#define CIAA_POSIX_SLAB16_COUNT 4
+#define CIAA_POSIX_SLAB32_COUNT 2
+#define CIAA_POSIX_SLAB64_COUNT 1
+#define CIAA_POSIX_SLAB128_COUNT 1
+#define CIAA_POSIX_SLAB256_COUNT 1
+#endif
+
+#ifndef CIAA_HEAP_MEM_SIZE
+/** \brief size of the heap region of the main RAM */
 #define CIAA_HEAP_MEM_SIZE 10000
-#define CIAA_POSIX_STDLIB_AVAILABLE 1
-#define CIAA_POSIX_STDLIB_USED 0
+#endif
+
+#if ((cortexM4 == ARCH) && (lpc43xx == CPUTYPE))
+/** \brief count of heap regions */
+#define CIAA_HEAP_REGIONS 4
+
+/** \brief size of the heap region of the local SRAM at 0x10080000 */
+#define CIAA_HEAP_LOC40_SIZE 0x4000
+
+/** \brief size of the heap region of the AHB SRAM at 0x20000000 */
+#define CIAA_HEAP_AHB32_SIZE 0x4000
+
+/** \brief start of the heap region of the AHB SRAM at 0x20008000, reserved
+ ** by the linker script after the 2 KB of the multicore IPC queue */
+#define CIAA_HEAP_SHARED_ADDR ((void *)__shared_heap_RamAHB16)
+
+/** \brief size of the heap region of the AHB SRAM at 0x20008000, shall
+ ** match the size reserved by the linker script */
+#define CIAA_HEAP_SHARED_SIZE 0x3800
+#elif (x86 == ARCH)
+/** \brief count of heap regions */
+#define CIAA_HEAP_REGIONS 3
+
+/** \brief size of the heap region simulating the DMA capable RAM */
+#define CIAA_HEAP_DMA_SIZE 8192
+
+/** \brief size of the heap region simulating the RAM shared between cores */
+#define CIAA_HEAP_SHARED_SIZE 4096
+#else
+/** \brief count of heap regions */
+#define CIAA_HEAP_REGIONS 1
+#endif
+
+/** \brief log2 of the alignment of the heap blocks, the size of a word */
+#define CIAA_HEAP_ALIGN_LOG2 ((8 == sizeof(size_t)) ? 3 : 2)
+
+/** \brief alignment of the heap blocks */
+#define CIAA_HEAP_ALIGN ((size_t)1 << CIAA_HEAP_ALIGN_LOG2)
+
+/** \brief log2 of the count of second level lists of each first level */
+#define CIAA_HEAP_SL_LOG2 3
+
+/** \brief count of second level lists of each first level */
+#define CIAA_HEAP_SL_COUNT (1 << CIAA_HEAP_SL_LOG2)
+
+/** \brief log2 of the size of the blocks of the first level 1, smaller
+ ** blocks are linearly distributed in the second level lists of level 0 */
+#define CIAA_HEAP_FL_SHIFT (CIAA_HEAP_SL_LOG2 + CIAA_HEAP_ALIGN_LOG2)
+
+/** \brief blocks smaller than this size are stored in the first level 0 */
+#define CIAA_HEAP_SMALL_BLOCK ((size_t)1 << CIAA_HEAP_FL_SHIFT)
+
+/** \brief log2 of the size limit of a block */
+#define CIAA_HEAP_FL_MAX 17
+
+/** \brief count of first level lists */
+#define CIAA_HEAP_FL_COUNT (CIAA_HEAP_FL_MAX - CIAA_HEAP_FL_SHIFT + 1)
+
+/** \brief size limit of a block, bigger regions are split */
+#define CIAA_HEAP_BLOCK_MAX ((size_t)1 << CIAA_HEAP_FL_MAX)
+
+/** \brief flag of the size of a block indicating that it is free */
+#define CIAA_HEAP_BLOCK_FREE ((size_t)1)
+
+/** \brief flag of the size of a block indicating that the previous
+ ** physical block is free */
+#define CIAA_HEAP_BLOCK_PREVFREE ((size_t)2)
+
+/** \brief overhead of an used block, only the size is stored */
+#define CIAA_HEAP_OVERHEAD (sizeof(size_t))
+
+/** \brief offset of the memory returned to the user in a block */
+#define CIAA_HEAP_START_OFFSET (sizeof(void *) + sizeof(size_t))
+
+/** \brief minimal size of a block, a free block stores the links of the
+ ** free list and the previous physical block link of the next block */
+#define CIAA_HEAP_BLOCK_MIN (sizeof(ciaaPOSIX_heapBlockType) - sizeof(void *))
+
+/** \brief size of a block without flags */
+#define CIAA_HEAP_BLOCKSIZE(block)                                   \
+   ((block)->size & ~(CIAA_HEAP_BLOCK_FREE | CIAA_HEAP_BLOCK_PREVFREE))
+
+/** \brief pointer to the memory of a block */
+#define CIAA_HEAP_TOPTR(block)                                       \
+   ((void *)((uint8_t *)(block) + CIAA_HEAP_START_OFFSET))
+
+/** \brief block of a pointer returned to the user */
+#define CIAA_HEAP_FROMPTR(ptr)                                       \
+   ((ciaaPOSIX_heapBlockType *)((uint8_t *)(ptr) - CIAA_HEAP_START_OFFSET))
+
+/** \brief next physical block */
+#define CIAA_HEAP_NEXT(block)                                        \
+   ((ciaaPOSIX_heapBlockType *)((uint8_t *)CIAA_HEAP_TOPTR(block) +  \
+      CIAA_HEAP_BLOCKSIZE(block) - CIAA_HEAP_OVERHEAD))
+
+#if ((cortexM4 == ARCH) && (lpc43xx == CPUTYPE))
+/** \brief cycle counter of the DWT unit */
+#define CIAA_POSIX_DWT_CYCCNT (*(volatile uint32_t *)0xE0001004UL)
+
+/** \brief control register of the DWT unit */
+#define CIAA_POSIX_DWT_CTRL (*(volatile uint32_t *)0xE0001000UL)
+
+/** \brief debug exception and monitor control register */
+#define CIAA_POSIX_DEMCR (*(volatile uint32_t *)0xE000EDFCUL)
+
+/** \brief current value of the cycle counter */
+#define CIAA_POSIX_CYCLES() (CIAA_POSIX_DWT_CYCCNT)
+#elif (x86 == ARCH)
+/** \brief current value of the cycle counter */
+#define CIAA_POSIX_CYCLES() ((uint32_t)__builtin_ia32_rdtsc())
+#else
+/** \brief no cycle counter, all allocations are counted in the first bin */
+#define CIAA_POSIX_CYCLES() ((uint32_t)0)
+#endif
+
+/** \brief log2 of the upper limit of the first latency bin in cycles */
+#define CIAA_POSIX_LATENCY_LOG2 6
+
+/** \brief return address of the caller of the current function */
+#define CIAA_POSIX_CALLSITE() ((uintptr_t)__builtin_return_address(0))
+
+/** \brief size of the smallest slab size class, shall be a power of two */
+#define CIAA_POSIX_SLAB_MIN_SIZE 8
+
+/** \brief size of the biggest slab size class, bigger requests are
+ ** allocated from the heap */
+#define CIAA_POSIX_SLAB_MAX_SIZE 256
+
+/** \brief count of slab size classes */
+#define CIAA_POSIX_SLAB_CLASSES 6
+
+#ifndef CIAA_POSIX_SLAB8_COUNT
+/** \brief count of elements of the slabs of each size class, the serial
+ ** devices allocate 2 buffers of 256 bytes for each device */
+#define CIAA_POSIX_SLAB8_COUNT 32
+#define CIAA_POSIX_SLAB16_COUNT 32
+#define CIAA_POSIX_SLAB32_COUNT 32
+#define CIAA_POSIX_SLAB64_COUNT 16
+#define CIAA_POSIX_SLAB128_COUNT 8
+#define CIAA_POSIX_SLAB256_COUNT 8
+#endif
+
+/** \brief declares the slab of a size class
+ **
+ ** Declares a pool of count elements of size bytes, the elements are
+ ** aligned to 8 bytes.
+ **
+ ** \param[in] size size of the elements of the slab
+ ** \param[in] count count of elements of the slab
+ **/
+#define CIAA_POSIX_SLABDECLARE(size, count)                          \
+   typedef struct {                                                  \
+      uint64_t data[(size) / sizeof(uint64_t)];                      \
+   } ciaaPOSIX_slab ## size ## Type;                                 \
+   CIAALIBS_POOLDECLARE(ciaaPOSIX_slab ## size,                      \
+         ciaaPOSIX_slab ## size ## Type, (count))
 
 /*==================[internal data declaration]==============================*/
 
-struct ciaaPOSIX_chunk_header
+/** \brief heap block
+ **
+ ** The heap is managed as a two level segregated fit (TLSF) allocator. The
+ ** free blocks are stored in lists by size: the first level splits the
+ ** sizes in powers of two and the second level splits each power of two
+ ** in CIAA_HEAP_SL_COUNT ranges. A bitmap of each level indicates the
+ ** non empty lists, so a fitting block is found with two bit scans.
+ **
+ ** The block header is a boundary tag: the previous physical block is
+ ** known when it is free, so a freed block is merged with its neighbours
+ ** in constant time.
+ **/
+typedef struct ciaaPOSIX_heapBlockStruct
 {
-   /* Next chunk pointer */
-   struct ciaaPOSIX_chunk_header *next;
+   /** <= previous physical block, only valid if it is free. It is stored in
+    **    the last word of the previous block */
+   struct ciaaPOSIX_heapBlockStruct *prevPhys;
 
-   /* Size of chunk */
-   uint32_t size;
+   /** <= size of the block without the overhead and flags
+    **    CIAA_HEAP_BLOCK_FREE and CIAA_HEAP_BLOCK_PREVFREE */
+   size_t size;
 
-   /* Indicates if this chunk is available */
-   bool is_available;
-};
-typedef struct ciaaPOSIX_chunk_header ciaaPOSIX_chunk_header;
+   /** <= next free block of the same list, only valid if free */
+   struct ciaaPOSIX_heapBlockStruct *nextFree;
+
+   /** <= previous free block of the same list, only valid if free */
+   struct ciaaPOSIX_heapBlockStruct *prevFree;
+} ciaaPOSIX_heapBlockType;
+
+/** \brief heap control structure */
+typedef struct
+{
+   /** <= bitmap of the first level lists with free blocks */
+   uint32_t flBitmap;
+
+   /** <= bitmaps of the second level lists with free blocks */
+   uint32_t slBitmap[CIAA_HEAP_FL_COUNT];
+
+   /** <= free blocks lists */
+   ciaaPOSIX_heapBlockType *blocks[CIAA_HEAP_FL_COUNT][CIAA_HEAP_SL_COUNT];
+} ciaaPOSIX_heapType;
+
+/** \brief heap memory region */
+typedef struct
+{
+   /** <= start of the memory of the region */
+   void *mem;
+
+   /** <= size of the memory of the region in bytes */
+   size_t size;
+
+   /** <= attributes of the memory, see ciaaPOSIX_MEM_FAST,
+    **    ciaaPOSIX_MEM_DMA and ciaaPOSIX_MEM_SHARED */
+   uint32_t attributes;
+} ciaaPOSIX_regionType;
 
 /*==================[internal functions declaration]=========================*/
+/** \brief get the lists of a block size
+ **
+ ** \param[in] size size of the block
+ ** \param[out] fl first level index
+ ** \param[out] sl second level index
+ **/
+static void ciaaPOSIX_heap_mapping(size_t size, uint32_t *fl, uint32_t *sl);
+
+/** \brief insert a free block in its list
+ **
+ ** \param[inout] heap heap of the block
+ ** \param[in] block block to be inserted
+ **/
+static void ciaaPOSIX_heap_insert(ciaaPOSIX_heapType *heap,
+      ciaaPOSIX_heapBlockType *block);
+
+/** \brief remove a free block from its list
+ **
+ ** \param[inout] heap heap of the block
+ ** \param[in] block block to be removed
+ **/
+static void ciaaPOSIX_heap_remove(ciaaPOSIX_heapType *heap,
+      ciaaPOSIX_heapBlockType *block);
+
+/** \brief link the next physical block to a block
+ **
+ ** \param[in] block block to be linked
+ ** \return next physical block
+ **/
+static ciaaPOSIX_heapBlockType *ciaaPOSIX_heap_linkNext(
+      ciaaPOSIX_heapBlockType *block);
+
+/** \brief initialize the heap of a memory region
+ **
+ ** \param[out] heap heap to be initialized
+ ** \param[in] mem pointer to the memory region
+ ** \param[in] size size of the memory region in bytes
+ **/
+static void ciaaPOSIX_heap_init(ciaaPOSIX_heapType *heap, void *mem,
+      size_t size);
+
+/** \brief adjust a requested size to the size of a block
+ **
+ ** \param[in] size count of bytes requested
+ ** \return size of the block, aligned and not smaller than the minimal size
+ **/
+static size_t ciaaPOSIX_heap_adjust(size_t size);
+
+/** \brief take a free block from the lists
+ **
+ ** \param[inout] heap heap to take the block from
+ ** \param[in] size minimal size of the block
+ ** \return free block removed from its list or NULL if not available
+ **/
+static ciaaPOSIX_heapBlockType *ciaaPOSIX_heap_locate(
+      ciaaPOSIX_heapType *heap, size_t size);
+
+/** \brief return the end of a block to the heap
+ **
+ ** The next physical block of the block shall not be free.
+ **
+ ** \param[inout] heap heap of the block
+ ** \param[in] block block to be trimmed, it is not in the free lists
+ ** \param[in] size new size of the block
+ **/
+static void ciaaPOSIX_heap_trim(ciaaPOSIX_heapType *heap,
+      ciaaPOSIX_heapBlockType *block, size_t size);
+
+/** \brief allocates memory from a heap
+ **
+ ** \param[inout] heap heap to allocate the memory from
+ ** \param[in] size count of bytes to be allocated
+ ** \return pointer to the allocated memory or NULL if not enough memory is
+ **         available
+ **/
+static void *ciaaPOSIX_heap_malloc(ciaaPOSIX_heapType *heap, size_t size);
+
+/** \brief allocates aligned memory from a heap
+ **
+ ** \param[inout] heap heap to allocate the memory from
+ ** \param[in] alignment alignment of the memory, power of two
+ ** \param[in] size count of bytes to be allocated
+ ** \return pointer to the allocated memory or NULL if not enough memory is
+ **         available
+ **/
+static void *ciaaPOSIX_heap_memalign(ciaaPOSIX_heapType *heap,
+      size_t alignment, size_t size);
+
+/** \brief resizes memory allocated from a heap in place
+ **
+ ** \param[inout] heap heap of the memory
+ ** \param[in] ptr pointer returned by ciaaPOSIX_heap_malloc
+ ** \param[in] size new count of bytes
+ ** \return true if the memory has been resized, false if the memory
+ **         shall be moved
+ **/
+static bool ciaaPOSIX_heap_resize(ciaaPOSIX_heapType *heap, void *ptr,
+      size_t size);
+
+/** \brief frees memory allocated from a heap
+ **
+ ** \param[inout] heap heap of the memory
+ ** \param[in] ptr pointer returned by ciaaPOSIX_heap_malloc
+ ** \return true if the memory has been freed, false if it was already free
+ **/
+static bool ciaaPOSIX_heap_free(ciaaPOSIX_heapType *heap, void *ptr);
+
+/** \brief get the slab of a pointer
+ **
+ ** \param[in] ptr pointer to be looked for
+ ** \return index of the slab or CIAA_POSIX_SLAB_CLASSES if the pointer is
+ **         not in a slab
+ **/
+static uint32_t ciaaPOSIX_slab_find(void *ptr);
+
+/** \brief get the region of a pointer
+ **
+ ** \param[in] ptr pointer to be looked for
+ ** \return index of the region or CIAA_HEAP_REGIONS if the pointer is not
+ **         in a region
+ **/
+static uint32_t ciaaPOSIX_region_find(void *ptr);
+
+/** \brief allocates aligned memory
+ **
+ ** \param[in] alignment alignment of the memory, power of two
+ ** \param[in] size count of bytes to be allocated
+ ** \param[in] hint placement hint, see ciaaPOSIX_malloc_hint
+ ** \return pointer to the allocated memory or NULL if not available
+ **/
+static void *ciaaPOSIX_allocate(size_t alignment, size_t size, uint32_t hint);
+
+/** \brief get the allocated size of a pointer
+ **
+ ** \param[in] ptr pointer returned by ciaaPOSIX_allocate
+ ** \return size of the slab element or of the heap block with its header, 0
+ **         if the pointer has not been allocated by ciaaPOSIX_allocate
+ **/
+static size_t ciaaPOSIX_allocatedSize(void *ptr);
+
+/** \brief frees memory allocated by ciaaPOSIX_allocate
+ **
+ ** \param[in] ptr pointer to be freed
+ **/
+static void ciaaPOSIX_release(void *ptr);
+
+/** \brief update the count of bytes in use and its peak
+ **
+ ** \param[in] size count of bytes allocated, negative values (in two's
+ **            complement) indicate freed bytes
+ **/
+static void ciaaPOSIX_stats_used(size_t size);
+
+/** \brief add a record to the trace
+ **
+ ** \param[in] callsite return address of the caller
+ ** \param[in] ptr allocated or freed memory
+ ** \param[in] size requested size or ciaaPOSIX_stdlib_TRACEFREE
+ **/
+static void ciaaPOSIX_trace(uintptr_t callsite, void *ptr, size_t size);
 
 /*==================[internal data definition]===============================*/
 
-/** \brief ciaa first chunk header*/
-ciaaPOSIX_chunk_header *first_chunk_header;
+/** \brief heap control structure of each region */
+static ciaaPOSIX_heapType ciaaPOSIX_heaps[CIAA_HEAP_REGIONS];
 
 /** \brief ciaa memory buffer */
-static char ciaaPOSIX_buffer[CIAA_HEAP_MEM_SIZE];
+static uint64_t ciaaPOSIX_buffer[CIAA_HEAP_MEM_SIZE / sizeof(uint64_t)];
+
+#if ((cortexM4 == ARCH) && (lpc43xx == CPUTYPE))
+/** \brief start of the shared heap region, defined by the linker script */
+extern uint64_t __shared_heap_RamAHB16[];
+
+/** \brief ciaa memory buffer in the local SRAM at 0x10080000 */
+static uint64_t ciaaPOSIX_bufferLoc40[CIAA_HEAP_LOC40_SIZE / sizeof(uint64_t)]
+   __attribute__ ((section(".bss.$RamLoc40")));
+
+/** \brief ciaa memory buffer in the AHB SRAM at 0x20000000 */
+static uint64_t ciaaPOSIX_bufferAhb32[CIAA_HEAP_AHB32_SIZE / sizeof(uint64_t)]
+   __attribute__ ((section(".bss.$RamAHB32")));
+
+/** \brief heap regions ordered by preference
+ **
+ ** The main buffer and the local SRAM are on the local bus of the
+ ** cortex M4, the AHB SRAM is used by the DMA without stalling the core.
+ ** The AHB SRAM at 0x20008000 is reserved by the linker script and is
+ ** shared with the cortex M0, only the cortex M4 allocates from it.
+ **/
+static const ciaaPOSIX_regionType ciaaPOSIX_regions[CIAA_HEAP_REGIONS] =
+{
+   { ciaaPOSIX_buffer, sizeof(ciaaPOSIX_buffer),
+      ciaaPOSIX_MEM_FAST | ciaaPOSIX_MEM_DMA },
+   { ciaaPOSIX_bufferLoc40, sizeof(ciaaPOSIX_bufferLoc40),
+      ciaaPOSIX_MEM_FAST | ciaaPOSIX_MEM_DMA },
+   { ciaaPOSIX_bufferAhb32, sizeof(ciaaPOSIX_bufferAhb32),
+      ciaaPOSIX_MEM_DMA },
+   { CIAA_HEAP_SHARED_ADDR, CIAA_HEAP_SHARED_SIZE,
+      ciaaPOSIX_MEM_DMA | ciaaPOSIX_MEM_SHARED },
+};
+#elif (x86 == ARCH)
+/** \brief ciaa memory buffer simulating the DMA capable RAM */
+static uint64_t ciaaPOSIX_bufferDma[CIAA_HEAP_DMA_SIZE / sizeof(uint64_t)];
+
+/** \brief ciaa memory buffer simulating the RAM shared between cores */
+static uint64_t ciaaPOSIX_bufferShared[CIAA_HEAP_SHARED_SIZE / sizeof(uint64_t)];
+
+/** \brief heap regions ordered by preference
+ **
+ ** Plain arrays with the attributes of the regions of the lpc4337.
+ **/
+static const ciaaPOSIX_regionType ciaaPOSIX_regions[CIAA_HEAP_REGIONS] =
+{
+   { ciaaPOSIX_buffer, sizeof(ciaaPOSIX_buffer),
+      ciaaPOSIX_MEM_FAST | ciaaPOSIX_MEM_DMA },
+   { ciaaPOSIX_bufferDma, sizeof(ciaaPOSIX_bufferDma),
+      ciaaPOSIX_MEM_DMA },
+   { ciaaPOSIX_bufferShared, sizeof(ciaaPOSIX_bufferShared),
+      ciaaPOSIX_MEM_DMA | ciaaPOSIX_MEM_SHARED },
+};
+#else
+/** \brief heap regions, the main buffer fulfills all the hints */
+static const ciaaPOSIX_regionType ciaaPOSIX_regions[CIAA_HEAP_REGIONS] =
+{
+   { ciaaPOSIX_buffer, sizeof(ciaaPOSIX_buffer),
+      ciaaPOSIX_MEM_FAST | ciaaPOSIX_MEM_DMA | ciaaPOSIX_MEM_SHARED },
+};
+#endif
 
 /** \brief ciaa POSIX sempahore */
 sem_t ciaaPOSIX_stdlib_sem;
 
+/** \brief statistics of the allocator, the free blocks are counted when the
+ ** statistics are read */
+static ciaaPOSIX_stdlib_statsType ciaaPOSIX_stats;
+
+#if (0 < ciaaPOSIX_stdlib_TRACESIZE)
+/** \brief trace records */
+static ciaaPOSIX_stdlib_traceType ciaaPOSIX_traceBuf[ciaaPOSIX_stdlib_TRACESIZE];
+
+/** \brief count of records written to the trace */
+static uint32_t ciaaPOSIX_traceHead;
+
+/** \brief count of records read from the trace */
+static uint32_t ciaaPOSIX_traceTail;
+#endif
+
+/* slabs of each size class */
+CIAA_POSIX_SLABDECLARE(8, CIAA_POSIX_SLAB8_COUNT)
+CIAA_POSIX_SLABDECLARE(16, CIAA_POSIX_SLAB16_COUNT)
+CIAA_POSIX_SLABDECLARE(32, CIAA_POSIX_SLAB32_COUNT)
+CIAA_POSIX_SLABDECLARE(64, CIAA_POSIX_SLAB64_COUNT)
+CIAA_POSIX_SLABDECLARE(128, CIAA_POSIX_SLAB128_COUNT)
+CIAA_POSIX_SLABDECLARE(256, CIAA_POSIX_SLAB256_COUNT)
+
+/** \brief slabs ordered by size class */
+static ciaaLibs_poolBufType * const ciaaPOSIX_slabs[CIAA_POSIX_SLAB_CLASSES] =
+{
+   &ciaaPOSIX_slab8,
+   &ciaaPOSIX_slab16,
+   &ciaaPOSIX_slab32,
+   &ciaaPOSIX_slab64,
+   &ciaaPOSIX_slab128,
+   &ciaaPOSIX_slab256,
+};
+
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
 
-static void ciaaPOSIX_chunk_partition(ciaaPOSIX_chunk_header *chunk_header, uint32_t size)
+static void ciaaPOSIX_heap_mapping(size_t size, uint32_t *fl, uint32_t *sl)
 {
-   // if there is at least one byte after the partition
-   if (chunk_header->size > size + sizeof(ciaaPOSIX_chunk_header)) {
-      ciaaPOSIX_chunk_header *next_chunk_header = (ciaaPOSIX_chunk_header *)(((char *)chunk_header) + size + sizeof(ciaaPOSIX_chunk_header));
-#if (cortexM0 == ARCH)
-       /* Cortex-M0 doesn't support unaligned memory access */
-       /* Align chunk to 32-bits address */
-       next_chunk_header = (ciaaPOSIX_chunk_header *)(((int)next_chunk_header+3) & ~3);
+   if (size < CIAA_HEAP_SMALL_BLOCK)
+   {
+      /* small blocks are linearly distributed in the first level 0 */
+      *fl = 0;
+      *sl = (uint32_t)(size >> CIAA_HEAP_ALIGN_LOG2);
+   }
+   else
+   {
+      /* the first level is the most significant bit and the second level
+       * the following CIAA_HEAP_SL_LOG2 bits */
+      *fl = 31 - ciaaLibs_clz(size);
+      *sl = (uint32_t)(size >> (*fl - CIAA_HEAP_SL_LOG2)) ^ CIAA_HEAP_SL_COUNT;
+      *fl -= CIAA_HEAP_FL_SHIFT - 1;
+   }
+}
+
+static void ciaaPOSIX_heap_insert(ciaaPOSIX_heapType *heap,
+      ciaaPOSIX_heapBlockType *block)
+{
+   uint32_t fl;
+   uint32_t sl;
+   ciaaPOSIX_heapBlockType *head;
+
+   ciaaPOSIX_heap_mapping(CIAA_HEAP_BLOCKSIZE(block), &fl, &sl);
+   head = heap->blocks[fl][sl];
+
+   /* insert the block at the beginning of the list */
+   block->nextFree = head;
+   block->prevFree = NULL;
+   if (NULL != head)
+   {
+      head->prevFree = block;
+   }
+   heap->blocks[fl][sl] = block;
+
+   heap->flBitmap |= (uint32_t)1 << fl;
+   heap->slBitmap[fl] |= (uint32_t)1 << sl;
+}
+
+static void ciaaPOSIX_heap_remove(ciaaPOSIX_heapType *heap,
+      ciaaPOSIX_heapBlockType *block)
+{
+   uint32_t fl;
+   uint32_t sl;
+
+   ciaaPOSIX_heap_mapping(CIAA_HEAP_BLOCKSIZE(block), &fl, &sl);
+
+   if (NULL != block->nextFree)
+   {
+      block->nextFree->prevFree = block->prevFree;
+   }
+   if (NULL != block->prevFree)
+   {
+      block->prevFree->nextFree = block->nextFree;
+   }
+   else
+   {
+      /* the block is the head of the list */
+      heap->blocks[fl][sl] = block->nextFree;
+      if (NULL == block->nextFree)
+      {
+         heap->slBitmap[fl] &= ~((uint32_t)1 << sl);
+         if (0 == heap->slBitmap[fl])
+         {
+            heap->flBitmap &= ~((uint32_t)1 << fl);
+         }
+      }
+   }
+}
+
+static ciaaPOSIX_heapBlockType *ciaaPOSIX_heap_linkNext(
+      ciaaPOSIX_heapBlockType *block)
+{
+   ciaaPOSIX_heapBlockType *next = CIAA_HEAP_NEXT(block);
+
+   next->prevPhys = block;
+
+   return next;
+}
+
+static void ciaaPOSIX_heap_init(ciaaPOSIX_heapType *heap, void *mem,
+      size_t size)
+{
+   uintptr_t start = ((uintptr_t)mem + CIAA_HEAP_ALIGN - 1) &
+      ~(CIAA_HEAP_ALIGN - 1);
+   ciaaPOSIX_heapBlockType *block;
+   ciaaPOSIX_heapBlockType *next;
+   size_t blockSize;
+   uint32_t i;
+   uint32_t j;
+
+   /* all free lists are empty */
+   heap->flBitmap = 0;
+   for(i = 0; i < CIAA_HEAP_FL_COUNT; i++)
+   {
+      heap->slBitmap[i] = 0;
+      for(j = 0; j < CIAA_HEAP_SL_COUNT; j++)
+      {
+         heap->blocks[i][j] = NULL;
+      }
+   }
+
+   /* keep room for the size of the block and of the sentinel block */
+   if (size > ((start - (uintptr_t)mem) + (2 * CIAA_HEAP_OVERHEAD) +
+            CIAA_HEAP_BLOCK_MIN))
+   {
+      blockSize = (size - (start - (uintptr_t)mem) - (2 * CIAA_HEAP_OVERHEAD)) &
+         ~(CIAA_HEAP_ALIGN - 1);
+      if (blockSize >= CIAA_HEAP_BLOCK_MAX)
+      {
+         blockSize = CIAA_HEAP_BLOCK_MAX - CIAA_HEAP_ALIGN;
+      }
+
+      /* the previous physical block link of the first block is outside of
+       * the region, it is never used as there is no previous block */
+      block = (ciaaPOSIX_heapBlockType *)(start - CIAA_HEAP_OVERHEAD);
+      block->size = blockSize | CIAA_HEAP_BLOCK_FREE;
+      ciaaPOSIX_heap_insert(heap, block);
+
+      /* used sentinel block of size 0 at the end of the region, a block is
+       * never merged with it */
+      next = ciaaPOSIX_heap_linkNext(block);
+      next->size = CIAA_HEAP_BLOCK_PREVFREE;
+   }
+}
+
+static size_t ciaaPOSIX_heap_adjust(size_t size)
+{
+   /* align the requested size and keep room for the free list links */
+   size = (size + CIAA_HEAP_ALIGN - 1) & ~(CIAA_HEAP_ALIGN - 1);
+   if (size < CIAA_HEAP_BLOCK_MIN)
+   {
+      size = CIAA_HEAP_BLOCK_MIN;
+   }
+
+   return size;
+}
+
+static ciaaPOSIX_heapBlockType *ciaaPOSIX_heap_locate(
+      ciaaPOSIX_heapType *heap, size_t size)
+{
+   ciaaPOSIX_heapBlockType *block = NULL;
+   size_t search;
+   uint32_t fl;
+   uint32_t sl;
+   uint32_t slMap = 0;
+   uint32_t flMap;
+
+   /* round up to the next list, any block of it is big enough */
+   search = size;
+   if (search >= CIAA_HEAP_SMALL_BLOCK)
+   {
+      search += ((size_t)1 << ((31 - ciaaLibs_clz(search)) -
+               CIAA_HEAP_SL_LOG2)) - 1;
+   }
+   ciaaPOSIX_heap_mapping(search, &fl, &sl);
+
+   if (fl < CIAA_HEAP_FL_COUNT)
+   {
+      /* look for a list of the same first level, if not available take
+       * the smallest list of a bigger first level */
+      slMap = heap->slBitmap[fl] & (0xffffffffu << sl);
+      if (0 == slMap)
+      {
+         flMap = heap->flBitmap & (0xffffffffu << (fl + 1));
+         if (0 != flMap)
+         {
+            fl = ciaaLibs_ctz(flMap);
+            slMap = heap->slBitmap[fl];
+         }
+      }
+   }
+
+   if (0 != slMap)
+   {
+      sl = ciaaLibs_ctz(slMap);
+      block = heap->blocks[fl][sl];
+      ciaaPOSIX_heap_remove(heap, block);
+   }
+
+   return block;
+}
+
+static void ciaaPOSIX_heap_trim(ciaaPOSIX_heapType *heap,
+      ciaaPOSIX_heapBlockType *block, size_t size)
+{
+   ciaaPOSIX_heapBlockType *remaining;
+
+   /* return the end of the block to the heap if it is big enough */
+   if (CIAA_HEAP_BLOCKSIZE(block) >= (size + sizeof(ciaaPOSIX_heapBlockType)))
+   {
+      remaining = (ciaaPOSIX_heapBlockType *)((uint8_t *)CIAA_HEAP_TOPTR(block) +
+            size - CIAA_HEAP_OVERHEAD);
+      remaining->size = (CIAA_HEAP_BLOCKSIZE(block) - size - CIAA_HEAP_OVERHEAD) |
+         CIAA_HEAP_BLOCK_FREE;
+      block->size = size |
+         (block->size & (CIAA_HEAP_BLOCK_FREE | CIAA_HEAP_BLOCK_PREVFREE));
+      ciaaPOSIX_heap_linkNext(remaining)->size |= CIAA_HEAP_BLOCK_PREVFREE;
+      ciaaPOSIX_heap_insert(heap, remaining);
+   }
+   else
+   {
+      CIAA_HEAP_NEXT(block)->size &= ~CIAA_HEAP_BLOCK_PREVFREE;
+   }
+}
+
+static void *ciaaPOSIX_heap_malloc(ciaaPOSIX_heapType *heap, size_t size)
+{
+   void *result = NULL;
+   ciaaPOSIX_heapBlockType *block;
+
+   if (size < CIAA_HEAP_BLOCK_MAX)
+   {
+      size = ciaaPOSIX_heap_adjust(size);
+
+      /* enter critical section */
+      ciaaPOSIX_sem_wait(&ciaaPOSIX_stdlib_sem);
+
+      block = ciaaPOSIX_heap_locate(heap, size);
+      if (NULL != block)
+      {
+         ciaaPOSIX_heap_trim(heap, block, size);
+
+         /* mark the block as used */
+         block->size &= ~CIAA_HEAP_BLOCK_FREE;
+         result = CIAA_HEAP_TOPTR(block);
+      }
+
+      /* exit critical section */
+      ciaaPOSIX_sem_post(&ciaaPOSIX_stdlib_sem);
+   }
+
+   return result;
+}
+
+static void *ciaaPOSIX_heap_memalign(ciaaPOSIX_heapType *heap,
+      size_t alignment, size_t size)
+{
+   void *result = NULL;
+   ciaaPOSIX_heapBlockType *block;
+   ciaaPOSIX_heapBlockType *aligned;
+   uintptr_t start;
+   uintptr_t offset;
+
+   if (alignment <= CIAA_HEAP_ALIGN)
+   {
+      /* all blocks are aligned to a word */
+      result = ciaaPOSIX_heap_malloc(heap, size);
+   }
+   else if ((size < CIAA_HEAP_BLOCK_MAX) && (alignment < CIAA_HEAP_BLOCK_MAX))
+   {
+      size = ciaaPOSIX_heap_adjust(size);
+
+      /* enter critical section */
+      ciaaPOSIX_sem_wait(&ciaaPOSIX_stdlib_sem);
+
+      /* keep room for a free block before the aligned memory */
+      block = ciaaPOSIX_heap_locate(heap,
+            size + alignment + sizeof(ciaaPOSIX_heapBlockType));
+      if (NULL != block)
+      {
+         start = (uintptr_t)CIAA_HEAP_TOPTR(block);
+         offset = ((start + alignment - 1) & ~(alignment - 1)) - start;
+         if ((0 != offset) && (offset < sizeof(ciaaPOSIX_heapBlockType)))
+         {
+            offset = ((start + sizeof(ciaaPOSIX_heapBlockType) + alignment - 1) &
+                  ~(alignment - 1)) - start;
+         }
+
+         /* return the memory before the aligned memory to the heap */
+         if (0 != offset)
+         {
+            aligned = CIAA_HEAP_FROMPTR(start + offset);
+            aligned->size = CIAA_HEAP_BLOCKSIZE(block) - offset;
+            block->size = (offset - CIAA_HEAP_OVERHEAD) |
+               (block->size & (CIAA_HEAP_BLOCK_FREE | CIAA_HEAP_BLOCK_PREVFREE));
+            ciaaPOSIX_heap_linkNext(block)->size |= CIAA_HEAP_BLOCK_PREVFREE;
+            ciaaPOSIX_heap_insert(heap, block);
+            block = aligned;
+         }
+
+         ciaaPOSIX_heap_trim(heap, block, size);
+
+         /* mark the block as used */
+         block->size &= ~CIAA_HEAP_BLOCK_FREE;
+         result = CIAA_HEAP_TOPTR(block);
+      }
+
+      /* exit critical section */
+      ciaaPOSIX_sem_post(&ciaaPOSIX_stdlib_sem);
+   }
+
+   return result;
+}
+
+static bool ciaaPOSIX_heap_resize(ciaaPOSIX_heapType *heap, void *ptr,
+      size_t size)
+{
+   bool result = false;
+   ciaaPOSIX_heapBlockType *block = CIAA_HEAP_FROMPTR(ptr);
+   ciaaPOSIX_heapBlockType *next;
+
+   if (size < CIAA_HEAP_BLOCK_MAX)
+   {
+      size = ciaaPOSIX_heap_adjust(size);
+
+      /* enter critical section */
+      ciaaPOSIX_sem_wait(&ciaaPOSIX_stdlib_sem);
+
+      if (0 == (block->size & CIAA_HEAP_BLOCK_FREE))
+      {
+         /* grow the block with the next block if it is free and the merged
+          * block is big enough, otherwise the block is kept unchanged */
+         next = CIAA_HEAP_NEXT(block);
+         if ((0 != (next->size & CIAA_HEAP_BLOCK_FREE)) &&
+               ((CIAA_HEAP_BLOCKSIZE(block) + CIAA_HEAP_BLOCKSIZE(next) +
+                 CIAA_HEAP_OVERHEAD) >= size))
+         {
+            ciaaPOSIX_heap_remove(heap, next);
+            block->size += CIAA_HEAP_BLOCKSIZE(next) + CIAA_HEAP_OVERHEAD;
+            CIAA_HEAP_NEXT(block)->size &= ~CIAA_HEAP_BLOCK_PREVFREE;
+         }
+
+         if (CIAA_HEAP_BLOCKSIZE(block) >= size)
+         {
+            ciaaPOSIX_heap_trim(heap, block, size);
+            result = true;
+         }
+      }
+
+      /* exit critical section */
+      ciaaPOSIX_sem_post(&ciaaPOSIX_stdlib_sem);
+   }
+
+   return result;
+}
+
+static bool ciaaPOSIX_heap_free(ciaaPOSIX_heapType *heap, void *ptr)
+{
+   bool result = false;
+   ciaaPOSIX_heapBlockType *block;
+   ciaaPOSIX_heapBlockType *next;
+
+   if (NULL != ptr)
+   {
+      block = CIAA_HEAP_FROMPTR(ptr);
+
+      /* enter critical section */
+      ciaaPOSIX_sem_wait(&ciaaPOSIX_stdlib_sem);
+
+      /* a block already free is ignored */
+      if (0 == (block->size & CIAA_HEAP_BLOCK_FREE))
+      {
+         /* merge with the previous block, the header of the absorbed block
+          * is marked as free so freeing it again is ignored */
+         if (0 != (block->size & CIAA_HEAP_BLOCK_PREVFREE))
+         {
+            ciaaPOSIX_heap_remove(heap, block->prevPhys);
+            block->prevPhys->size += CIAA_HEAP_BLOCKSIZE(block) +
+               CIAA_HEAP_OVERHEAD;
+            block->size |= CIAA_HEAP_BLOCK_FREE;
+            block = block->prevPhys;
+         }
+
+         /* merge with the next block */
+         next = CIAA_HEAP_NEXT(block);
+         if (0 != (next->size & CIAA_HEAP_BLOCK_FREE))
+         {
+            ciaaPOSIX_heap_remove(heap, next);
+            block->size += CIAA_HEAP_BLOCKSIZE(next) + CIAA_HEAP_OVERHEAD;
+         }
+
+         /* mark the block as free */
+         block->size |= CIAA_HEAP_BLOCK_FREE;
+         next = ciaaPOSIX_heap_linkNext(block);
+         next->size |= CIAA_HEAP_BLOCK_PREVFREE;
+         ciaaPOSIX_heap_insert(heap, block);
+         result = true;
+      }
+
+      /* exit critical section */
+      ciaaPOSIX_sem_post(&ciaaPOSIX_stdlib_sem);
+   }
+
+   return result;
+}
+
+static uint32_t ciaaPOSIX_slab_find(void *ptr)
+{
+   uint32_t result = CIAA_POSIX_SLAB_CLASSES;
+   uint32_t i;
+
+   for(i = 0; (i < CIAA_POSIX_SLAB_CLASSES) && (CIAA_POSIX_SLAB_CLASSES == result); i++)
+   {
+      if (((uint8_t *)ptr >= ciaaPOSIX_slabs[i]->buf) &&
+            ((uint8_t *)ptr < (ciaaPOSIX_slabs[i]->buf +
+               (ciaaPOSIX_slabs[i]->poolSize * ciaaPOSIX_slabs[i]->elementSize))))
+      {
+         result = i;
+      }
+   }
+
+   return result;
+}
+
+static uint32_t ciaaPOSIX_region_find(void *ptr)
+{
+   uint32_t result = CIAA_HEAP_REGIONS;
+   uint32_t i;
+
+   for(i = 0; (i < CIAA_HEAP_REGIONS) && (CIAA_HEAP_REGIONS == result); i++)
+   {
+      if (((uintptr_t)ptr >= (uintptr_t)ciaaPOSIX_regions[i].mem) &&
+            ((uintptr_t)ptr < ((uintptr_t)ciaaPOSIX_regions[i].mem +
+               ciaaPOSIX_regions[i].size)))
+      {
+         result = i;
+      }
+   }
+
+   return result;
+}
+
+static void *ciaaPOSIX_allocate(size_t alignment, size_t size, uint32_t hint)
+{
+   void *result = NULL;
+   uint32_t slab = 0;
+   uint32_t i;
+   uint32_t cycles = CIAA_POSIX_CYCLES();
+   size_t allocated = 0;
+
+   /* the slabs are in the main RAM as the first region, their elements
+    * are aligned to a word */
+   if ((size <= CIAA_POSIX_SLAB_MAX_SIZE) && (alignment <= CIAA_HEAP_ALIGN) &&
+         (hint == (hint & ciaaPOSIX_regions[0].attributes)))
+   {
+      /* size class of the smallest power of two not smaller than size */
+      if (size > CIAA_POSIX_SLAB_MIN_SIZE)
+      {
+         slab = (32 - ciaaLibs_clz(size - 1)) -
+            (32 - ciaaLibs_clz(CIAA_POSIX_SLAB_MIN_SIZE - 1));
+      }
+
+      /* the slabs are lock free, no critical section is needed */
+      result = ciaaLibs_poolBufLock(ciaaPOSIX_slabs[slab]);
+      allocated = ciaaPOSIX_slabs[slab]->elementSize;
+   }
+
+   /* big requests and requests of a full size class use the heap of the
+    * first region fulfilling the hint with enough memory */
+   for(i = 0; (i < CIAA_HEAP_REGIONS) && (NULL == result); i++)
+   {
+      if (hint == (hint & ciaaPOSIX_regions[i].attributes))
+      {
+         result = ciaaPOSIX_heap_memalign(&ciaaPOSIX_heaps[i], alignment, size);
+         if (NULL != result)
+         {
+            allocated = CIAA_HEAP_BLOCKSIZE(CIAA_HEAP_FROMPTR(result)) +
+               CIAA_HEAP_OVERHEAD;
+         }
+      }
+   }
+
+   /* bin of the latency, the first bin counts the allocations faster than
+    * 2^CIAA_POSIX_LATENCY_LOG2 cycles and each bin doubles the limit */
+   cycles = CIAA_POSIX_CYCLES() - cycles;
+   i = 0;
+   if (cycles >= ((uint32_t)1 << CIAA_POSIX_LATENCY_LOG2))
+   {
+      i = (32 - ciaaLibs_clz(cycles)) - CIAA_POSIX_LATENCY_LOG2;
+      if (i >= ciaaPOSIX_stdlib_LATENCYBINS)
+      {
+         i = ciaaPOSIX_stdlib_LATENCYBINS - 1;
+      }
+   }
+   ciaaLibs_atomicAdd(&ciaaPOSIX_stats.latency[i], 1);
+
+   if (NULL != result)
+   {
+      ciaaPOSIX_stats_used(allocated);
+   }
+   else
+   {
+      ciaaLibs_atomicAdd(&ciaaPOSIX_stats.failures, 1);
+   }
+
+   return result;
+}
+
+static size_t ciaaPOSIX_allocatedSize(void *ptr)
+{
+   size_t result = 0;
+   uint32_t i;
+
+   i = ciaaPOSIX_slab_find(ptr);
+   if (CIAA_POSIX_SLAB_CLASSES != i)
+   {
+      result = ciaaPOSIX_slabs[i]->elementSize;
+   }
+   else if (CIAA_HEAP_REGIONS != ciaaPOSIX_region_find(ptr))
+   {
+      result = CIAA_HEAP_BLOCKSIZE(CIAA_HEAP_FROMPTR(ptr)) + CIAA_HEAP_OVERHEAD;
+   }
+   else
+   {
+      /* the pointer has not been allocated by ciaaPOSIX_allocate */
+   }
+
+   return result;
+}
+
+static void ciaaPOSIX_release(void *ptr)
+{
+   uint32_t i;
+   bool freed = false;
+   size_t size = ciaaPOSIX_allocatedSize(ptr);
+
+   /* each slab checks that the pointer is one of its elements */
+   for(i = 0; (i < CIAA_POSIX_SLAB_CLASSES) && (false == freed); i++)
+   {
+      freed = (1 == ciaaLibs_poolBufFree(ciaaPOSIX_slabs[i], ptr));
+   }
+
+   /* look for the region of the pointer, other pointers are ignored */
+   if (false == freed)
+   {
+      i = ciaaPOSIX_region_find(ptr);
+      if (CIAA_HEAP_REGIONS != i)
+      {
+         freed = ciaaPOSIX_heap_free(&ciaaPOSIX_heaps[i], ptr);
+      }
+   }
+
+   if (true == freed)
+   {
+      ciaaPOSIX_stats_used((size_t)0 - size);
+   }
+}
+
+static void ciaaPOSIX_stats_used(size_t size)
+{
+   size_t used = ciaaLibs_atomicAdd(&ciaaPOSIX_stats.used, size);
+   size_t peak = ciaaLibs_atomicLoadAcquire(&ciaaPOSIX_stats.peak);
+
+   /* a freed size never increases the peak */
+   while ((used > peak) &&
+         (false == ciaaLibs_atomicCas(&ciaaPOSIX_stats.peak, &peak, used)))
+   {
+      /* peak has been updated with the current value, try again */
+   }
+}
+
+static void ciaaPOSIX_trace(uintptr_t callsite, void *ptr, size_t size)
+{
+#if (0 < ciaaPOSIX_stdlib_TRACESIZE)
+   ciaaPOSIX_stdlib_traceType *record;
+
+   /* enter critical section, also the slab allocations are serialized */
+   ciaaPOSIX_sem_wait(&ciaaPOSIX_stdlib_sem);
+
+   /* the records are dropped if the trace is full */
+   if ((ciaaPOSIX_traceHead - ciaaPOSIX_traceTail) < ciaaPOSIX_stdlib_TRACESIZE)
+   {
+      record = &ciaaPOSIX_traceBuf[ciaaPOSIX_traceHead % ciaaPOSIX_stdlib_TRACESIZE];
+      record->callsite = callsite;
+      record->ptr = (uintptr_t)ptr;
+      record->size = (uint32_t)size;
+      ciaaPOSIX_traceHead++;
+   }
+   else
+   {
+      ciaaPOSIX_stats.traceDropped++;
+   }
+
+   /* exit critical section */
+   ciaaPOSIX_sem_post(&ciaaPOSIX_stdlib_sem);
+#else
+   /* the trace is disabled */
+   (void)callsite;
+   (void)ptr;
+   (void)size;
 #endif
-       next_chunk_header->next = chunk_header->next;
-       chunk_header->next = next_chunk_header;
-       next_chunk_header->size = chunk_header->size - size - sizeof(ciaaPOSIX_chunk_header);
-       next_chunk_header->is_available = CIAA_POSIX_STDLIB_AVAILABLE;
-       chunk_header->size = size;
-  }
-  chunk_header->is_available = CIAA_POSIX_STDLIB_USED;
 }
 
 /*==================[external functions definition]==========================*/
 
 void ciaaPOSIX_stdlib_init(void)
 {
-   int ciaaPOSIX_heap_available_size = CIAA_HEAP_MEM_SIZE - sizeof(ciaaPOSIX_chunk_header);
-   first_chunk_header = (ciaaPOSIX_chunk_header*)&ciaaPOSIX_buffer;
-   first_chunk_header->next = NULL;
-   first_chunk_header->size = ciaaPOSIX_heap_available_size;
-   first_chunk_header->is_available = CIAA_POSIX_STDLIB_AVAILABLE;
+   static const ciaaPOSIX_stdlib_statsType zeroStats = { 0 };
+   uint32_t i;
+
+#if ((cortexM4 == ARCH) && (lpc43xx == CPUTYPE))
+   /* enable the cycle counter used to measure the allocation latency */
+   CIAA_POSIX_DEMCR |= (uint32_t)1 << 24;
+   CIAA_POSIX_DWT_CTRL |= 1;
+#endif
+   ciaaPOSIX_stats = zeroStats;
+#if (0 < ciaaPOSIX_stdlib_TRACESIZE)
+   ciaaPOSIX_traceHead = 0;
+   ciaaPOSIX_traceTail = 0;
+#endif
+
+   /* each region is managed by its own heap */
+   for(i = 0; i < CIAA_HEAP_REGIONS; i++)
+   {
+      ciaaPOSIX_heap_init(&ciaaPOSIX_heaps[i], ciaaPOSIX_regions[i].mem,
+            ciaaPOSIX_regions[i].size);
+   }
+
    /* init sempahore */
    ciaaPOSIX_sem_init(&ciaaPOSIX_stdlib_sem);
+
+   /* indicate that all slab elements are free */
+   for(i = 0; i < CIAA_POSIX_SLAB_CLASSES; i++)
+   {
+      ciaaLibs_poolBufInit(ciaaPOSIX_slabs[i], ciaaPOSIX_slabs[i]->buf,
+            ciaaPOSIX_slabs[i]->statusPtr, ciaaPOSIX_slabs[i]->summaryPtr,
+            ciaaPOSIX_slabs[i]->poolSize, ciaaPOSIX_slabs[i]->elementSize);
+   }
 }
 
 void *ciaaPOSIX_malloc(size_t size)
 {
-   char *result = NULL;
-   ciaaPOSIX_chunk_header *chunk_header = first_chunk_header;
+   void *result = ciaaPOSIX_allocate(CIAA_HEAP_ALIGN, size, ciaaPOSIX_MEM_ANY);
 
-   /* enter critical section */
-   ciaaPOSIX_sem_wait(&ciaaPOSIX_stdlib_sem);
-   while(chunk_header)
+   ciaaPOSIX_trace(CIAA_POSIX_CALLSITE(), result, size);
+
+   return result;
+}
+
+void *ciaaPOSIX_malloc_hint(size_t size, uint32_t hint)
+{
+   void *result = ciaaPOSIX_allocate(CIAA_HEAP_ALIGN, size, hint);
+
+   ciaaPOSIX_trace(CIAA_POSIX_CALLSITE(), result, size);
+
+   return result;
+}
+
+void *ciaaPOSIX_memalign(size_t alignment, size_t size)
+{
+   void *result = NULL;
+
+   /* the alignment shall be a power of two */
+   if ((0 != alignment) && (0 == (alignment & (alignment - 1))))
+   {
+      result = ciaaPOSIX_allocate(alignment, size, ciaaPOSIX_MEM_ANY);
+   }
+
+   ciaaPOSIX_trace(CIAA_POSIX_CALLSITE(), result, size);
+
+   return result;
+}
+
+void *ciaaPOSIX_calloc(size_t nmemb, size_t size)
+{
+   void *result = NULL;
+
+   /* the total size shall not overflow */
+   if ((0 == size) || (nmemb <= (((size_t)-1) / size)))
    {
-      if(chunk_header->is_available && chunk_header->size >= size)
+      result = ciaaPOSIX_allocate(CIAA_HEAP_ALIGN, nmemb * size,
+            ciaaPOSIX_MEM_ANY);
+      if (NULL != result)
       {
-         ciaaPOSIX_chunk_partition(chunk_header, size);
-         result  = ((char *)chunk_header)+sizeof(ciaaPOSIX_chunk_header);
-         break;
+         ciaaPOSIX_memset(result, 0, nmemb * size);
       }
-      chunk_header = chunk_header->next;
    }
-   /* exit critical section */
-   ciaaPOSIX_sem_post(&ciaaPOSIX_stdlib_sem);
+
+   ciaaPOSIX_trace(CIAA_POSIX_CALLSITE(), result, nmemb * size);
+
+   return result;
+}
+
+void *ciaaPOSIX_realloc(void *ptr, size_t size)
+{
+   void *result = NULL;
+   size_t oldSize = 0;
+   uint32_t hint = ciaaPOSIX_MEM_ANY;
+   uint32_t slab;
+   uint32_t region;
+   bool resized;
+
+   if (NULL == ptr)
+   {
+      result = ciaaPOSIX_allocate(CIAA_HEAP_ALIGN, size, ciaaPOSIX_MEM_ANY);
+   }
+   else if (0 == size)
+   {
+      ciaaPOSIX_release(ptr);
+   }
+   else
+   {
+      slab = ciaaPOSIX_slab_find(ptr);
+      region = ciaaPOSIX_region_find(ptr);
+      if (CIAA_POSIX_SLAB_CLASSES != slab)
+      {
+         /* a slab element is kept if the new size fits in it */
+         oldSize = ciaaPOSIX_slabs[slab]->elementSize;
+         hint = ciaaPOSIX_regions[0].attributes;
+         if (size <= oldSize)
+         {
+            result = ptr;
+         }
+      }
+      else if (CIAA_HEAP_REGIONS != region)
+      {
+         oldSize = CIAA_HEAP_BLOCKSIZE(CIAA_HEAP_FROMPTR(ptr));
+         hint = ciaaPOSIX_regions[region].attributes;
+         resized = ciaaPOSIX_heap_resize(&ciaaPOSIX_heaps[region], ptr, size);
+
+         /* account any change of the block, release subtracts its current
+          * size if the memory is moved afterwards */
+         ciaaPOSIX_stats_used(CIAA_HEAP_BLOCKSIZE(CIAA_HEAP_FROMPTR(ptr)) -
+               oldSize);
+         if (true == resized)
+         {
+            result = ptr;
+         }
+      }
+      else
+      {
+         /* the pointer has not been allocated by ciaaPOSIX_malloc */
+      }
+
+      /* move the memory to a region with the same attributes */
+      if ((NULL == result) && (0 != oldSize))
+      {
+         result = ciaaPOSIX_allocate(CIAA_HEAP_ALIGN, size, hint);
+         if (NULL != result)
+         {
+            ciaaPOSIX_memcpy(result, ptr, (size < oldSize) ? size : oldSize);
+            ciaaPOSIX_release(ptr);
+         }
+      }
+   }
+
+   /* traced as free of the old memory and allocation of the new one */
+   if ((NULL != ptr) && ((0 == size) || (NULL != result)))
+   {
+      ciaaPOSIX_trace(CIAA_POSIX_CALLSITE(), ptr, ciaaPOSIX_stdlib_TRACEFREE);
+   }
+   if (0 != size)
+   {
+      ciaaPOSIX_trace(CIAA_POSIX_CALLSITE(), result, size);
+   }
+
    return result;
 }
 
 void ciaaPOSIX_free(void *ptr)
 {
-   ciaaPOSIX_chunk_header *chunk_to_free = (ciaaPOSIX_chunk_header*)(((char *) ptr) - sizeof(ciaaPOSIX_chunk_header));
-   ciaaPOSIX_chunk_header *chunk_header = first_chunk_header;
+   ciaaPOSIX_release(ptr);
+
+   ciaaPOSIX_trace(CIAA_POSIX_CALLSITE(), ptr, ciaaPOSIX_stdlib_TRACEFREE);
+}
+
+void ciaaPOSIX_stdlib_getStats(ciaaPOSIX_stdlib_statsType *stats)
+{
+   ciaaPOSIX_heapBlockType *block;
+   uint32_t region;
+   uint32_t fl;
+   uint32_t sl;
+
+   *stats = ciaaPOSIX_stats;
+   stats->freeBlocks = 0;
+   stats->largestFree = 0;
+
+   /* each allocation is counted in a bin of the latency histogram */
+   stats->allocations = 0;
+   for(fl = 0; fl < ciaaPOSIX_stdlib_LATENCYBINS; fl++)
+   {
+      stats->allocations += stats->latency[fl];
+   }
 
    /* enter critical section */
    ciaaPOSIX_sem_wait(&ciaaPOSIX_stdlib_sem);
 
-   while (chunk_header)
+   /* walk the free lists of all the heaps */
+   for(region = 0; region < CIAA_HEAP_REGIONS; region++)
    {
-      if (chunk_header == chunk_to_free)
+      for(fl = 0; fl < CIAA_HEAP_FL_COUNT; fl++)
       {
-         chunk_header->is_available = CIAA_POSIX_STDLIB_AVAILABLE;
-         break;
+         for(sl = 0; sl < CIAA_HEAP_SL_COUNT; sl++)
+         {
+            for(block = ciaaPOSIX_heaps[region].blocks[fl][sl]; NULL != block;
+                  block = block->nextFree)
+            {
+               stats->freeBlocks++;
+               if (CIAA_HEAP_BLOCKSIZE(block) > stats->largestFree)
+               {
+                  stats->largestFree = CIAA_HEAP_BLOCKSIZE(block);
+               }
+            }
+         }
       }
-      chunk_header = chunk_header->next;
    }
 
-   /* small defragmentator */
-   chunk_header = first_chunk_header;
-   while (chunk_header) {
-      if (chunk_header->is_available) {
-         while (chunk_header->next!=NULL && chunk_header->next->is_available) {
-            chunk_header->size += chunk_header->next->size + sizeof(ciaaPOSIX_chunk_header);
-            chunk_header->next = chunk_header->next->next;
-         }
-      }
-      chunk_header = chunk_header->next;
+   /* exit critical section */
+   ciaaPOSIX_sem_post(&ciaaPOSIX_stdlib_sem);
+}
+
+size_t ciaaPOSIX_stdlib_readTrace(ciaaPOSIX_stdlib_traceType *records,
+      size_t count)
+{
+   size_t result = 0;
+
+#if (0 < ciaaPOSIX_stdlib_TRACESIZE)
+   /* enter critical section */
+   ciaaPOSIX_sem_wait(&ciaaPOSIX_stdlib_sem);
+
+   while ((result < count) && (ciaaPOSIX_traceTail != ciaaPOSIX_traceHead))
+   {
+      records[result] =
+         ciaaPOSIX_traceBuf[ciaaPOSIX_traceTail % ciaaPOSIX_stdlib_TRACESIZE];
+      ciaaPOSIX_traceTail++;
+      result++;
    }
 
    /* exit critical section */
    ciaaPOSIX_sem_post(&ciaaPOSIX_stdlib_sem);
+#else
+   /* the trace is disabled */
+   (void)records;
+   (void)count;
+#endif
+
+   return result;
 }
 
 /** @} doxygen end group definition */
@@ -48,18 +48,273 @@
 #include "ciaaPOSIX_stdlib.h"
 #include "ciaaPOSIX_stdint.h"
 #include "ciaaPOSIX_stddef.h"
+#include "ciaaLibs_Maths.h"
 
 /*==================[macros and definitions]=================================*/
+/** \brief size of the words used to access the memory */
+#define CIAA_POSIX_WORD_SIZE  (sizeof(ciaaPOSIX_wordType))
+
+/** \brief mask of the address bits inside of a word */
+#define CIAA_POSIX_WORD_MASK  ((uintptr_t)CIAA_POSIX_WORD_SIZE - 1)
+
+/** \brief shorter blocks are accessed byte per byte, the alignment of the
+ ** head and the tail costs more than the words save */
+#define CIAA_POSIX_WORD_MIN   (4 * CIAA_POSIX_WORD_SIZE)
+
+#if (defined(__BYTE_ORDER__) && (__ORDER_BIG_ENDIAN__ == __BYTE_ORDER__))
+/** \brief word of an unaligned source built from 2 aligned words */
+#define CIAA_POSIX_MERGE(w0, w1, shift)                              \
+   (((w0) << (shift)) | ((w1) >> ((8 * CIAA_POSIX_WORD_SIZE) - (shift))))
+#else
+/** \brief word of an unaligned source built from 2 aligned words */
+#define CIAA_POSIX_MERGE(w0, w1, shift)                              \
+   (((w0) >> (shift)) | ((w1) << ((8 * CIAA_POSIX_WORD_SIZE) - (shift))))
+#endif
 
 /*==================[internal data declaration]==============================*/
+/** \brief word used to access the memory, it may alias any other type */
+typedef uint32_t __attribute__((__may_alias__)) ciaaPOSIX_wordType;
 
 /*==================[internal functions declaration]=========================*/
+/** \brief copy memory from the first byte to the last one
+ **
+ ** The destination is aligned to a word and the memory is copied with
+ ** words. If the source has other alignment its words are read aligned and
+ ** merged, so unaligned accesses are never performed.
+ **
+ ** \param[out] d destination pointer
+ ** \param[in] s source pointer
+ ** \param[in] n count of bytes to be copied
+ **/
+static void ciaaPOSIX_copyForward(uint8_t * d, uint8_t const * s, size_t n);
+
+/** \brief copy memory from the last byte to the first one
+ **
+ ** Words are copied only if the source and the destination have the same
+ ** alignment.
+ **
+ ** \param[out] d destination pointer
+ ** \param[in] s source pointer
+ ** \param[in] n count of bytes to be copied
+ **/
+static void ciaaPOSIX_copyBackward(uint8_t * d, uint8_t const * s, size_t n);
+
+/** \brief count the equal bytes at the beginning of two strings
+ **
+ ** The strings are compared word per word if they have the same alignment,
+ ** the returned count may be smaller than the real count of equal bytes.
+ **
+ ** \param[in] s1 first string
+ ** \param[in] s2 second string
+ ** \param[in] n maximal count of bytes to be compared
+ ** \return count of equal bytes before the first null or difference
+ **/
+static size_t ciaaPOSIX_equalWords(char const * s1, char const * s2, size_t n);
 
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static void ciaaPOSIX_copyForward(uint8_t * d, uint8_t const * s, size_t n)
+{
+   ciaaPOSIX_wordType * dw;
+   ciaaPOSIX_wordType const * sw;
+   ciaaPOSIX_wordType w0;
+   ciaaPOSIX_wordType w1;
+   ciaaPOSIX_wordType w2;
+   ciaaPOSIX_wordType w3;
+   uint32_t shift;
+   size_t words;
+
+   if (CIAA_POSIX_WORD_MIN <= n)
+   {
+      /* copy the head until the destination is aligned */
+      while(0 != ((uintptr_t)d & CIAA_POSIX_WORD_MASK))
+      {
+         *d = *s;
+         d++;
+         s++;
+         n--;
+      }
+
+      dw = (ciaaPOSIX_wordType *)d;
+      words = n / CIAA_POSIX_WORD_SIZE;
+      if (0 == ((uintptr_t)s & CIAA_POSIX_WORD_MASK))
+      {
+         sw = (ciaaPOSIX_wordType const *)s;
+
+         /* copy 4 words at once, the loads and the stores are grouped to be
+          * compiled as LDM and STM */
+         while(4 <= words)
+         {
+            w0 = sw[0];
+            w1 = sw[1];
+            w2 = sw[2];
+            w3 = sw[3];
+            dw[0] = w0;
+            dw[1] = w1;
+            dw[2] = w2;
+            dw[3] = w3;
+            sw += 4;
+            dw += 4;
+            words -= 4;
+         }
+         while(0 < words)
+         {
+            *dw = *sw;
+            dw++;
+            sw++;
+            words--;
+         }
+      }
+      else
+      {
+         /* read aligned words of the source, an aligned word never crosses
+          * the end of the memory even if it has bytes out of the source */
+         shift = 8 * ((uintptr_t)s & CIAA_POSIX_WORD_MASK);
+         sw = (ciaaPOSIX_wordType const *)((uintptr_t)s & ~CIAA_POSIX_WORD_MASK);
+         w0 = *sw;
+         while(4 <= words)
+         {
+            w1 = sw[1];
+            dw[0] = CIAA_POSIX_MERGE(w0, w1, shift);
+            w2 = sw[2];
+            dw[1] = CIAA_POSIX_MERGE(w1, w2, shift);
+            w3 = sw[3];
+            dw[2] = CIAA_POSIX_MERGE(w2, w3, shift);
+            w0 = sw[4];
+            dw[3] = CIAA_POSIX_MERGE(w3, w0, shift);
+            sw += 4;
+            dw += 4;
+            words -= 4;
+         }
+         while(0 < words)
+         {
+            sw++;
+            w1 = *sw;
+            *dw = CIAA_POSIX_MERGE(w0, w1, shift);
+            w0 = w1;
+            dw++;
+            words--;
+         }
+      }
+
+      s += (uint8_t *)dw - d;
+      n -= (uint8_t *)dw - d;
+      d = (uint8_t *)dw;
+   }
+
+   /* copy the tail */
+   while(0 < n)
+   {
+      *d = *s;
+      d++;
+      s++;
+      n--;
+   }
+}
+
+static void ciaaPOSIX_copyBackward(uint8_t * d, uint8_t const * s, size_t n)
+{
+   ciaaPOSIX_wordType * dw;
+   ciaaPOSIX_wordType const * sw;
+   ciaaPOSIX_wordType w0;
+   ciaaPOSIX_wordType w1;
+   ciaaPOSIX_wordType w2;
+   ciaaPOSIX_wordType w3;
+
+   d += n;
+   s += n;
+
+   if ((CIAA_POSIX_WORD_MIN <= n) &&
+         (((uintptr_t)d & CIAA_POSIX_WORD_MASK) == ((uintptr_t)s & CIAA_POSIX_WORD_MASK)))
+   {
+      /* copy the tail until both ends are aligned */
+      while(0 != ((uintptr_t)d & CIAA_POSIX_WORD_MASK))
+      {
+         d--;
+         s--;
+         *d = *s;
+         n--;
+      }
+
+      dw = (ciaaPOSIX_wordType *)d;
+      sw = (ciaaPOSIX_wordType const *)s;
+
+      /* the 4 words are read before writing them, so an overlapping
+       * destination does not modify them */
+      while((4 * CIAA_POSIX_WORD_SIZE) <= n)
+      {
+         dw -= 4;
+         sw -= 4;
+         w3 = sw[3];
+         w2 = sw[2];
+         w1 = sw[1];
+         w0 = sw[0];
+         dw[3] = w3;
+         dw[2] = w2;
+         dw[1] = w1;
+         dw[0] = w0;
+         n -= 4 * CIAA_POSIX_WORD_SIZE;
+      }
+      while(CIAA_POSIX_WORD_SIZE <= n)
+      {
+         dw--;
+         sw--;
+         *dw = *sw;
+         n -= CIAA_POSIX_WORD_SIZE;
+      }
+
+      d = (uint8_t *)dw;
+      s = (uint8_t const *)sw;
+   }
+
+   /* copy the head */
+   while(0 < n)
+   {
+      d--;
+      s--;
+      *d = *s;
+      n--;
+   }
+}
+
+static size_t ciaaPOSIX_equalWords(char const * s1, char const * s2, size_t n)
+{
+   size_t result = 0;
+   ciaaPOSIX_wordType const * w1;
+   ciaaPOSIX_wordType const * w2;
+
+   if (((uintptr_t)s1 & CIAA_POSIX_WORD_MASK) == ((uintptr_t)s2 & CIAA_POSIX_WORD_MASK))
+   {
+      /* compare the head until both strings are aligned */
+      while((0 != ((uintptr_t)s1 & CIAA_POSIX_WORD_MASK)) && (result < n) &&
+            (*s1 == *s2) && (0 != *s1))
+      {
+         s1++;
+         s2++;
+         result++;
+      }
+
+      if (0 == ((uintptr_t)s1 & CIAA_POSIX_WORD_MASK))
+      {
+         /* an aligned word never crosses the end of the memory even if it
+          * has bytes after the null */
+         w1 = (ciaaPOSIX_wordType const *)s1;
+         w2 = (ciaaPOSIX_wordType const *)s2;
+         while(((n - result) >= CIAA_POSIX_WORD_SIZE) && (*w1 == *w2) &&
+               (0 == ciaaLibs_hasZeroByte(*w1)))
+         {
+            w1++;
+            w2++;
+            result += CIAA_POSIX_WORD_SIZE;
+         }
+      }
+   }
+
+   return result;
+}
 
 /*==================[external functions definition]==========================*/
 extern char * ciaaPOSIX_strcpy(char * s1, char const * s2)
@@ -75,47 +330,54 @@ extern char * ciaaPOSIX_strcpy(char * s1, char const * s2)
 }
 
 extern size_t ciaaPOSIX_strlen(char const * s) {
-   uint32_t length = 0;
+   char const * start = s;
+   ciaaPOSIX_wordType const * w;
 
-   /* search for the first null within the string */
-   while(0 != *s)
+   /* search for the first null until the pointer is aligned */
+   while((0 != ((uintptr_t)s & CIAA_POSIX_WORD_MASK)) && (0 != *s))
    {
-      /* if not found, increment the position */
       s++;
-      /* and increment the lenght counter */
-      length++;
    }
 
-   return length;
-}
-
-extern char * ciaaPOSIX_strcat(char * dest, char const * src)
-{
-   char *ret = dest;
-   size_t length = ciaaPOSIX_strlen(dest);
-
-   /* increment size of initial string */
-   dest += length;
-
-   while(0 != *src)
+   if (0 == ((uintptr_t)s & CIAA_POSIX_WORD_MASK))
    {
-      /* copy one char */
-      *dest = *src;
+      /* search for the first word with a null, an aligned word never
+       * crosses the end of the memory even if it has bytes after the null */
+      w = (ciaaPOSIX_wordType const *)s;
+      while(0 == ciaaLibs_hasZeroByte(*w))
+      {
+         w++;
+      }
 
-      /* increment pointers */
-      dest++;
-      src++;
+      /* search for the null within the word */
+      s = (char const *)w;
+      while(0 != *s)
+      {
+         s++;
+      }
    }
 
-   /* add null termination */
-   *dest = 0;
+   return (size_t)(s - start);
+}
 
-   return ret;
+extern char * ciaaPOSIX_strcat(char * dest, char const * src)
+{
+   /* copy the string with its null termination after the initial string */
+   ciaaPOSIX_memcpy(dest + ciaaPOSIX_strlen(dest), src,
+         ciaaPOSIX_strlen(src) + 1);
+
+   return dest;
 }
 
 extern int8_t ciaaPOSIX_strncmp(char const * s1, char const * s2, size_t n)
 {
    int8_t ret = 0;
+   size_t equal = ciaaPOSIX_equalWords(s1, s2, n);
+
+   /* skip the equal words */
+   s1 += equal;
+   s2 += equal;
+   n -= equal;
 
    while( (0 != *s1) && (0 != *s2) && (0 == ret) && (0 < n) )
    {
@@ -167,6 +429,11 @@ extern int8_t ciaaPOSIX_strncmp(char const * s1, char const * s2, size_t n)
 extern int8_t ciaaPOSIX_strcmp(char const * s1, char const * s2)
 {
    int8_t ret = 0;
+   size_t equal = ciaaPOSIX_equalWords(s1, s2, (size_t)-1);
+
+   /* skip the equal words */
+   s1 += equal;
+   s2 += equal;
 
    while( (0 != *s1) && (0 != *s2) && (0 == ret) )
    {
@@ -214,13 +481,22 @@ extern int8_t ciaaPOSIX_strcmp(char const * s1, char const * s2)
 
 extern void * ciaaPOSIX_memcpy(void * s1, void const * s2, size_t n)
 {
-   while(0 < n)
-   {
-      /* decrement counter */
-      n--;
+   ciaaPOSIX_copyForward((uint8_t *)s1, (uint8_t const *)s2, n);
 
-      /* copy 1 byte */
-      ((uint8_t*)s1)[n] = ((uint8_t*)s2)[n];
+   return s1;
+}
+
+extern void * ciaaPOSIX_memmove(void * s1, void const * s2, size_t n)
+{
+   /* copy from the end only if the destination overlaps the end of the
+    * source */
+   if (((uintptr_t)s1 > (uintptr_t)s2) && ((uintptr_t)s1 < ((uintptr_t)s2 + n)))
+   {
+      ciaaPOSIX_copyBackward((uint8_t *)s1, (uint8_t const *)s2, n);
+   }
+   else
+   {
+      ciaaPOSIX_copyForward((uint8_t *)s1, (uint8_t const *)s2, n);
    }
 
    return s1;
@@ -228,13 +504,50 @@ extern void * ciaaPOSIX_memcpy(void * s1, void const * s2, size_t n)
 
 extern void * ciaaPOSIX_memset(void * s, int c, size_t n)
 {
+   uint8_t * d = (uint8_t *)s;
+   ciaaPOSIX_wordType * dw;
+   ciaaPOSIX_wordType w;
+
+   if (CIAA_POSIX_WORD_MIN <= n)
+   {
+      /* set the head until the pointer is aligned */
+      while(0 != ((uintptr_t)d & CIAA_POSIX_WORD_MASK))
+      {
+         *d = (uint8_t)c;
+         d++;
+         n--;
+      }
+
+      /* the byte repeated in each byte of the word */
+      w = (ciaaPOSIX_wordType)(uint8_t)c * (ciaaPOSIX_wordType)0x01010101u;
+      dw = (ciaaPOSIX_wordType *)d;
+
+      /* set 4 words at once to be compiled as STM */
+      while((4 * CIAA_POSIX_WORD_SIZE) <= n)
+      {
+         dw[0] = w;
+         dw[1] = w;
+         dw[2] = w;
+         dw[3] = w;
+         dw += 4;
+         n -= 4 * CIAA_POSIX_WORD_SIZE;
+      }
+      while(CIAA_POSIX_WORD_SIZE <= n)
+      {
+         *dw = w;
+         dw++;
+         n -= CIAA_POSIX_WORD_SIZE;
+      }
+
+      d = (uint8_t *)dw;
+   }
+
+   /* set the tail */
    while(0 < n)
    {
-      /* decement counter */
+      *d = (uint8_t)c;
+      d++;
       n--;
-
-      /* set 1 byte */
-      ((uint8_t*)s)[n] = (uint8_t)c;
    }
 
    return s;
@@ -243,30 +556,143 @@ extern void * ciaaPOSIX_memset(void * s, int c, size_t n)
 extern int32_t ciaaPOSIX_memcmp(const void * s1, const void * s2, size_t n)
 {
    int32_t ret = 0;
+   uint8_t const * p1 = (uint8_t const *)s1;
+   uint8_t const * p2 = (uint8_t const *)s2;
+   ciaaPOSIX_wordType const * w1;
+   ciaaPOSIX_wordType const * w2;
+
+   if ((CIAA_POSIX_WORD_MIN <= n) &&
+         (((uintptr_t)p1 & CIAA_POSIX_WORD_MASK) == ((uintptr_t)p2 & CIAA_POSIX_WORD_MASK)))
+   {
+      /* compare the head until both pointers are aligned */
+      while((0 != ((uintptr_t)p1 & CIAA_POSIX_WORD_MASK)) && (*p1 == *p2))
+      {
+         p1++;
+         p2++;
+         n--;
+      }
+
+      /* skip the equal words, the different word is compared byte per
+       * byte */
+      w1 = (ciaaPOSIX_wordType const *)p1;
+      w2 = (ciaaPOSIX_wordType const *)p2;
+      while((CIAA_POSIX_WORD_SIZE <= n) && (*w1 == *w2))
+      {
+         w1++;
+         w2++;
+         n -= CIAA_POSIX_WORD_SIZE;
+      }
+      p1 = (uint8_t const *)w1;
+      p2 = (uint8_t const *)w2;
+   }
 
    while((0 < n) && (0 == ret))
    {
       /* decrement counter */
       n--;
 
-      if (*(uint8_t*)s1 > *(uint8_t*)s2)
+      if (*p1 > *p2)
       {
          /* s1 is grater */
          ret = 1;
       }
-      else if (*(uint8_t*)s1 < *(uint8_t*)s2)
+      else if (*p1 < *p2)
       {
          /* s2 is grater */
          ret = -1;
       }
 
       /* increment pointer */
-      s1++;
-      s2++;
+      p1++;
+      p2++;
    }
    return ret;
 }
 
+extern void * ciaaPOSIX_memchr(void const * s, int c, size_t n)
+{
+   void * ret = NULL;
+   uint8_t const * p = (uint8_t const *)s;
+   ciaaPOSIX_wordType const * w;
+   ciaaPOSIX_wordType pattern;
+
+   /* search the head until the pointer is aligned */
+   while((0 != ((uintptr_t)p & CIAA_POSIX_WORD_MASK)) && (0 < n) &&
+         ((uint8_t)c != *p))
+   {
+      p++;
+      n--;
+   }
+
+   if (0 == ((uintptr_t)p & CIAA_POSIX_WORD_MASK))
+   {
+      /* a word with the byte has a 0 byte after the xor with the pattern */
+      pattern = ciaaLibs_byteToWord(c);
+      w = (ciaaPOSIX_wordType const *)p;
+      while((CIAA_POSIX_WORD_SIZE <= n) && (0 == ciaaLibs_hasZeroByte(*w ^ pattern)))
+      {
+         w++;
+         n -= CIAA_POSIX_WORD_SIZE;
+      }
+      p = (uint8_t const *)w;
+   }
+
+   /* search the byte within the word and the tail */
+   while((0 < n) && ((uint8_t)c != *p))
+   {
+      p++;
+      n--;
+   }
+
+   if (0 < n)
+   {
+      ret = (void *)p;
+   }
+
+   return ret;
+}
+
+extern char * ciaaPOSIX_strchr(char const * s, int c)
+{
+   char * ret = NULL;
+   ciaaPOSIX_wordType const * w;
+   ciaaPOSIX_wordType pattern;
+
+   /* search the head until the pointer is aligned */
+   while((0 != ((uintptr_t)s & CIAA_POSIX_WORD_MASK)) && ((char)c != *s) &&
+         (0 != *s))
+   {
+      s++;
+   }
+
+   if (0 == ((uintptr_t)s & CIAA_POSIX_WORD_MASK))
+   {
+      /* search for the first word with the char or the null, an aligned
+       * word never crosses the end of the memory */
+      pattern = ciaaLibs_byteToWord(c);
+      w = (ciaaPOSIX_wordType const *)s;
+      while((0 == ciaaLibs_hasZeroByte(*w)) && (0 == ciaaLibs_hasZeroByte(*w ^ pattern)))
+      {
+         w++;
+      }
+      s = (char const *)w;
+   }
+
+   /* search within the word */
+   while(((char)c != *s) && (0 != *s))
+   {
+      s++;
+   }
+
+   /* the null termination is found if c is 0 */
+   if ((char)c == *s)
+   {
+      ret = (char *)s;
+   }
+
+   return ret;
+}
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /*==================[end of file]============================================*/
@@ -64,9 +64,23 @@ typedef struct {
    void * fct;
 } ciaaSerialDevices_blockerType;
 
+typedef struct {
+   TaskType taskID;
+   int16_t events;
+} ciaaSerialDevices_pollerType;
+
+typedef struct {
+   ciaaPOSIX_aiocbType * head;
+   ciaaPOSIX_aiocbType * tail;
+} ciaaSerialDevices_aioQueueType;
+
 typedef struct {
    ciaaDevices_deviceType const * device;
    ciaaSerialDevices_blockerType blocked;
+   ciaaSerialDevices_pollerType poll;
+   ciaaSerialDevices_aioQueueType rxAio;
+   ciaaSerialDevices_aioQueueType txAio;
+   ciaaPOSIX_timeoutType timeout;
    ciaaLibs_CircBufType rxBuf;
    ciaaLibs_CircBufType txBuf;
    uint8_t flags;
@@ -93,12 +107,189 @@ ciaaSerialDevices_devicesType ciaaSerialDevices;
 char const * const ciaaSerialDevices_prefix = "/dev/serial";
 
 /*==================[internal functions declaration]=========================*/
+/** \brief wake the task polling a serial device
+ **
+ ** \param[in] serialDevice serial device
+ ** \param[in] event event which got ready
+ **
+ ** \remarks This function is called from ISR context
+ **/
+static void ciaaSerialDevices_pollWakeUp(ciaaSerialDevices_deviceType * serialDevice, int16_t event);
+
+/** \brief complete an asynchronous request
+ **
+ ** Stores the result and notifies the completion with the callback and the
+ ** event of the control block. The control block shall already be removed
+ ** from its queue, the callback may submit a new request.
+ **
+ ** \param[in] aiocb control block to be completed
+ ** \param[in] result result of the request
+ **/
+static void ciaaSerialDevices_aioComplete(ciaaPOSIX_aiocbType * aiocb, ssize_t result);
+
+/** \brief append an asynchronous request to a queue
+ **
+ ** \param[in] queue queue of requests
+ ** \param[in] aiocb control block to be appended
+ **/
+static void ciaaSerialDevices_aioEnqueue(ciaaSerialDevices_aioQueueType * queue, ciaaPOSIX_aiocbType * aiocb);
+
+/** \brief remove the first asynchronous request of a queue
+ **
+ ** \param[in] queue queue of requests, shall not be empty
+ ** \return the removed control block
+ **/
+static ciaaPOSIX_aiocbType * ciaaSerialDevices_aioDequeue(ciaaSerialDevices_aioQueueType * queue);
+
+/** \brief complete the pending asynchronous reads with the received data
+ **
+ ** \param[in] serialDevice serial device
+ **
+ ** \remarks This function is called with the rx interrupt disabled or from
+ **          ISR context
+ **/
+static void ciaaSerialDevices_aioRead(ciaaSerialDevices_deviceType * serialDevice);
+
+/** \brief store the data of the pending asynchronous writes in the tx buffer
+ **
+ ** \param[in] serialDevice serial device
+ **
+ ** \remarks This function is called with the tx interrupt disabled or from
+ **          ISR context
+ **/
+static void ciaaSerialDevices_aioWrite(ciaaSerialDevices_deviceType * serialDevice);
+
+/** \brief cancel all the asynchronous requests of a queue
+ **
+ ** \param[in] queue queue of requests
+ **/
+static void ciaaSerialDevices_aioCancel(ciaaSerialDevices_aioQueueType * queue);
 
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+static void ciaaSerialDevices_pollWakeUp(ciaaSerialDevices_deviceType * serialDevice, int16_t event)
+{
+   TaskType taskID = serialDevice->poll.taskID;
+
+   /* if a task is polling this event */
+   if ( (255 != taskID) && (0 != (serialDevice->poll.events & event)) )
+   {
+      /* the task is woken only once */
+      serialDevice->poll.taskID = 255;
+
+#ifdef POSIXE
+      /* set task event */
+      SetEvent(taskID, POSIXE);
+#endif
+   }
+}
+
+static void ciaaSerialDevices_aioComplete(ciaaPOSIX_aiocbType * aiocb, ssize_t result)
+{
+   aiocb->result = result;
+
+   if (NULL != aiocb->callback)
+   {
+      aiocb->callback(aiocb);
+   }
+
+   if (0 != aiocb->event)
+   {
+      SetEvent((TaskType)aiocb->task, (EventMaskType)aiocb->event);
+   }
+}
+
+static void ciaaSerialDevices_aioEnqueue(ciaaSerialDevices_aioQueueType * queue, ciaaPOSIX_aiocbType * aiocb)
+{
+   aiocb->next = NULL;
+
+   if (NULL == queue->head)
+   {
+      queue->head = aiocb;
+   }
+   else
+   {
+      queue->tail->next = aiocb;
+   }
+   queue->tail = aiocb;
+}
+
+static ciaaPOSIX_aiocbType * ciaaSerialDevices_aioDequeue(ciaaSerialDevices_aioQueueType * queue)
+{
+   ciaaPOSIX_aiocbType * aiocb = queue->head;
+
+   queue->head = aiocb->next;
+   aiocb->next = NULL;
+
+   return aiocb;
+}
+
+static void ciaaSerialDevices_aioRead(ciaaSerialDevices_deviceType * serialDevice)
+{
+   ciaaPOSIX_aiocbType * aiocb;
+   ssize_t read;
+
+   /* each pending read gets the data available when it is served */
+   while ( (NULL != serialDevice->rxAio.head) &&
+         !ciaaLibs_circBufEmpty(&serialDevice->rxBuf) )
+   {
+      aiocb = ciaaSerialDevices_aioDequeue(&serialDevice->rxAio);
+
+      read = ciaaLibs_circBufGet(&serialDevice->rxBuf,
+            aiocb->buf,
+            aiocb->nbytes);
+
+      ciaaSerialDevices_aioComplete(aiocb, read);
+   }
+}
+
+static void ciaaSerialDevices_aioWrite(ciaaSerialDevices_deviceType * serialDevice)
+{
+   ciaaLibs_CircBufType * cbuf = &serialDevice->txBuf;
+   ciaaPOSIX_aiocbType * aiocb = serialDevice->txAio.head;
+   uint32_t head;
+   uint32_t space;
+
+   while (NULL != aiocb)
+   {
+      /* read head and space */
+      head = ciaaLibs_circBufHead(cbuf);
+      space = ciaaLibs_circBufSpace(cbuf, head);
+
+      /* store as many bytes of the first pending write as possible */
+      aiocb->count += ciaaLibs_circBufPut(cbuf,
+            aiocb->buf + aiocb->count,
+            ciaaLibs_min(aiocb->nbytes - aiocb->count, space));
+
+      /* the write is completed when all its bytes are in the tx buffer */
+      if (aiocb->count == aiocb->nbytes)
+      {
+         aiocb = ciaaSerialDevices_aioDequeue(&serialDevice->txAio);
+         ciaaSerialDevices_aioComplete(aiocb, aiocb->nbytes);
+
+         aiocb = serialDevice->txAio.head;
+      }
+      else
+      {
+         /* no space left, continue in the next tx confirmation */
+         aiocb = NULL;
+      }
+   }
+}
+
+static void ciaaSerialDevices_aioCancel(ciaaSerialDevices_aioQueueType * queue)
+{
+   ciaaPOSIX_aiocbType * aiocb;
+
+   while (NULL != queue->head)
+   {
+      aiocb = ciaaSerialDevices_aioDequeue(queue);
+      ciaaSerialDevices_aioComplete(aiocb, -1);
+   }
+}
 
 /*==================[external functions definition]==========================*/
 extern void ciaaSerialDevices_init(void)
@@ -114,6 +305,10 @@ extern void ciaaSerialDevices_init(void)
       /* set invalid task as default */
       ciaaSerialDevices.devstr[loopi].blocked.taskID = 255; /* TODO */
       ciaaSerialDevices.devstr[loopi].blocked.fct = NULL;
+      ciaaSerialDevices.devstr[loopi].poll.taskID = 255;
+      ciaaSerialDevices.devstr[loopi].rxAio.head = NULL;
+      ciaaSerialDevices.devstr[loopi].txAio.head = NULL;
+      ciaaSerialDevices.devstr[loopi].timeout.ticks = 0;
    }
 }
 
@@ -159,6 +354,9 @@ extern void ciaaSerialDevices_addDriver(ciaaDevices_deviceType * driver)
       newDevice->ioctl = ciaaSerialDevices_ioctl;
       newDevice->read = ciaaSerialDevices_read;
       newDevice->write = ciaaSerialDevices_write;
+      newDevice->readv = NULL;
+      newDevice->writev = ciaaSerialDevices_writev;
+      newDevice->poll = ciaaSerialDevices_poll;
 
       /* store layers information information */
       newDevice->layer = (void *) &ciaaSerialDevices.devstr[position];
@@ -229,14 +427,14 @@ extern int32_t ciaaSerialDevices_ioctl(ciaaDevices_deviceType const * const devi
    {
       case ciaaPOSIX_IOCTL_GET_RX_COUNT:
          cbuf = &serialDevice->rxBuf;
-         tail = cbuf->tail;
+         tail = ciaaLibs_circBufTail(cbuf);
          *(uint32_t *)param = ciaaLibs_circBufCount(cbuf, tail);
          ret = 0;
          break;
 
       case ciaaPOSIX_IOCTL_GET_TX_SPACE:
          cbuf = &serialDevice->txBuf;
-         head = cbuf->head;
+         head = ciaaLibs_circBufHead(cbuf);
          *(uint32_t *)param = ciaaLibs_circBufSpace(cbuf, head);
          ret = 0;
          break;
@@ -244,6 +442,85 @@ extern int32_t ciaaSerialDevices_ioctl(ciaaDevices_deviceType const * const devi
       case ciaaPOSIX_IOCTL_RXINDICATION:
          break;
 
+      case ciaaPOSIX_IOCTL_AIO_READ:
+         /* TODO improve this: https://github.com/ciaa/Firmware/issues/88 */
+         serialDevice->device->ioctl(device->loLayer, ciaaPOSIX_IOCTL_SET_ENABLE_RX_INTERRUPT, (void*)false);
+
+         if (NULL == param)
+         {
+            ciaaSerialDevices_aioCancel(&serialDevice->rxAio);
+            ret = 0;
+         }
+         else if (serialDevice->blocked.fct == (void*) ciaaSerialDevices_read)
+         {
+            /* a task is blocked reading the rx buffer */
+            ciaaPOSIX_errno = EBUSY;
+            ret = -1;
+         }
+         else
+         {
+            ((ciaaPOSIX_aiocbType *)param)->result = ciaaPOSIX_AIO_INPROGRESS;
+            ciaaSerialDevices_aioEnqueue(&serialDevice->rxAio,
+                  (ciaaPOSIX_aiocbType *)param);
+
+            /* complete the request if data has already been received */
+            ciaaSerialDevices_aioRead(serialDevice);
+            ret = 0;
+         }
+
+         /* TODO improve this: https://github.com/ciaa/Firmware/issues/88 */
+         serialDevice->device->ioctl(device->loLayer, ciaaPOSIX_IOCTL_SET_ENABLE_RX_INTERRUPT, (void*)true);
+         break;
+
+      case ciaaPOSIX_IOCTL_AIO_WRITE:
+         /* TODO improve this: https://github.com/ciaa/Firmware/issues/88 */
+         serialDevice->device->ioctl(device->loLayer, ciaaPOSIX_IOCTL_SET_ENABLE_TX_INTERRUPT, (void*)false);
+
+         if (NULL == param)
+         {
+            ciaaSerialDevices_aioCancel(&serialDevice->txAio);
+            ret = 0;
+         }
+         else if (serialDevice->blocked.fct == (void*) ciaaSerialDevices_write)
+         {
+            /* a task is blocked writing the tx buffer */
+            ciaaPOSIX_errno = EBUSY;
+            ret = -1;
+         }
+         else
+         {
+            ((ciaaPOSIX_aiocbType *)param)->result = ciaaPOSIX_AIO_INPROGRESS;
+            ((ciaaPOSIX_aiocbType *)param)->count = 0;
+            ciaaSerialDevices_aioEnqueue(&serialDevice->txAio,
+                  (ciaaPOSIX_aiocbType *)param);
+
+            /* store as much data as possible in the tx buffer */
+            ciaaSerialDevices_aioWrite(serialDevice);
+            ret = 0;
+         }
+
+         /* TODO improve this: https://github.com/ciaa/Firmware/issues/88 */
+         serialDevice->device->ioctl(device->loLayer, ciaaPOSIX_IOCTL_SET_ENABLE_TX_INTERRUPT, (void*)true);
+
+         /* starts the transmission if not already ongoing */
+         serialDevice->device->ioctl(
+               device->loLayer,
+               ciaaPOSIX_IOCTL_STARTTX,
+               NULL);
+         break;
+
+      case ciaaPOSIX_IOCTL_SET_TIMEOUT:
+         if (NULL == param)
+         {
+            serialDevice->timeout.ticks = 0;
+         }
+         else
+         {
+            serialDevice->timeout = *(ciaaPOSIX_timeoutType *)param;
+         }
+         ret = 0;
+         break;
+
       case ciaaPOSIX_IOCTL_SET_NONBLOCK_MODE:
          if((bool)(intptr_t)param == false)
          {
@@ -271,9 +548,17 @@ extern ssize_t ciaaSerialDevices_read(ciaaDevices_deviceType const * const devic
    ciaaSerialDevices_deviceType * serialDevice =
       (ciaaSerialDevices_deviceType*) device->layer;
    int32_t ret = 0;
+   StatusType status = E_OK;
 
+   /* the pending asynchronous reads are served from the rx buffer in the
+    * receive indication, a read now would be a second consumer */
+   if (NULL != serialDevice->rxAio.head)
+   {
+      ciaaPOSIX_errno = EBUSY;
+      ret = -1;
+   }
    /* if the rx buffer is not empty */
-   if (!ciaaLibs_circBufEmpty(&serialDevice->rxBuf))
+   else if (!ciaaLibs_circBufEmpty(&serialDevice->rxBuf))
    {
       /* try to read nbyte from rxBuf and store it to the user buffer */
       ret = ciaaLibs_circBufGet(&serialDevice->rxBuf,
@@ -305,17 +590,50 @@ extern ssize_t ciaaSerialDevices_read(ciaaDevices_deviceType const * const devic
 
          /* if no data wait for it */
 #ifdef POSIXE
-         WaitEvent(POSIXE);
-         ClearEvent(POSIXE);
+         if (0 == serialDevice->timeout.ticks)
+         {
+            WaitEvent(POSIXE);
+            ClearEvent(POSIXE);
+         }
+         else
+         {
+            /* the alarm wakes the task if no data is received in time, if
+             * the alarm can not be set the data is not awaited */
+            status = SetRelAlarm((AlarmType)serialDevice->timeout.alarm,
+                  (TickType)serialDevice->timeout.ticks, 0);
+            if (E_OK == status)
+            {
+               WaitEvent(POSIXE);
+               ClearEvent(POSIXE);
+            }
+
+            /* the task is not longer waiting for data */
+            /* TODO improve this: https://github.com/ciaa/Firmware/issues/88 */
+            serialDevice->device->ioctl(device->loLayer, ciaaPOSIX_IOCTL_SET_ENABLE_RX_INTERRUPT, (void*)false);
+            serialDevice->blocked.taskID = 255;
+            serialDevice->blocked.fct = NULL;
+            serialDevice->device->ioctl(device->loLayer, ciaaPOSIX_IOCTL_SET_ENABLE_RX_INTERRUPT, (void*)true);
+
+            if (E_OK == status)
+            {
+               /* the alarm may have expired after the data has been received */
+               CancelAlarm((AlarmType)serialDevice->timeout.alarm);
+            }
+            ClearEvent(POSIXE);
+         }
 #endif
 
-         /* after the wait is not needed to check if data is avaibale on the
-          * buffer. The event will be set first after adding some data into it */
-
          /* try to read nbyte from rxBuf and store it to the user buffer */
          ret = ciaaLibs_circBufGet(&serialDevice->rxBuf,
                buf,
                nbyte);
+
+         /* the buffer is only empty if the timeout expired */
+         if ( (0 == ret) && (0 != serialDevice->timeout.ticks) )
+         {
+            ciaaPOSIX_errno = (E_OK == status) ? ETIMEDOUT : EBUSY;
+            ret = -1;
+         }
       }
    }
    return ret;
@@ -332,47 +650,175 @@ extern ssize_t ciaaSerialDevices_write(ciaaDevices_deviceType const * const devi
    int32_t head;
    uint32_t space;
 
-   do
+   /* the pending asynchronous writes are stored in the tx buffer in the
+    * transmit confirmation, a write now would be a second producer */
+   if (NULL != serialDevice->txAio.head)
    {
-      /* read head and space */
-      head = cbuf->head;
-      space = ciaaLibs_circBufSpace(cbuf, head);
+      ciaaPOSIX_errno = EBUSY;
+      total = -1;
+   }
+   else
+   {
+      do
+      {
+         /* read head and space */
+         head = ciaaLibs_circBufHead(cbuf);
+         space = ciaaLibs_circBufSpace(cbuf, head);
+
+         /* put bytes in the queue */
+         ret = ciaaLibs_circBufPut(cbuf, buf, ciaaLibs_min(nbyte-total, space));
+         /* update total of written bytes */
+         total += ret;
+
+         /* starts the transmission if not already ongoing */
+         serialDevice->device->ioctl(
+               device->loLayer,
+               ciaaPOSIX_IOCTL_STARTTX,
+               NULL);
+
+         /* if not all bytes could be stored in the buffer */
+         if (total < nbyte)
+         {
+            /* increment buffer */
+            buf += ret;
 
-      /* put bytes in the queue */
-      ret = ciaaLibs_circBufPut(cbuf, buf, ciaaLibs_min(nbyte-total, space));
-      /* update total of written bytes */
-      total += ret;
+            /* set the task to sleep until some data have been send */
 
-      /* starts the transmission if not already ongoing */
-      serialDevice->device->ioctl(
-            device->loLayer,
-            ciaaPOSIX_IOCTL_STARTTX,
-            NULL);
+            /* TODO improve this: https://github.com/ciaa/Firmware/issues/88 */
+            serialDevice->device->ioctl(device->loLayer, ciaaPOSIX_IOCTL_SET_ENABLE_TX_INTERRUPT, (void*)false);
+            /* get task id and function for waking up the task later */
+            GetTaskID(&serialDevice->blocked.taskID);
+            serialDevice->blocked.fct = (void*) ciaaSerialDevices_write;
+
+            /* TODO improve this: https://github.com/ciaa/Firmware/issues/88 */
+            serialDevice->device->ioctl(device->loLayer, ciaaPOSIX_IOCTL_SET_ENABLE_TX_INTERRUPT, (void*)true);
+            /* wait to write all data or for the txConfirmation */
+#ifdef POSIXE
+            WaitEvent(POSIXE);
+            ClearEvent(POSIXE);
+#endif
+         }
+      }
+      while (total < nbyte);
+   }
+
+   return total;
+}
+
+extern int16_t ciaaSerialDevices_poll(ciaaDevices_deviceType const * const device, int16_t const events, bool const notify)
+{
+   /* get serial device */
+   ciaaSerialDevices_deviceType * serialDevice =
+      (ciaaSerialDevices_deviceType*) device->layer;
+   int16_t ret = 0;
 
-      /* if not all bytes could be stored in the buffer */
-      if (total < nbyte)
+   if (notify)
+   {
+      /* register before checking the buffers, an event occurring
+       * afterwards wakes the task */
+      serialDevice->poll.events = events;
+      GetTaskID(&serialDevice->poll.taskID);
+   }
+   else
+   {
+      serialDevice->poll.taskID = 255;
+   }
+
+   if ( (0 != (events & ciaaPOSIX_POLLIN)) &&
+         !ciaaLibs_circBufEmpty(&serialDevice->rxBuf) )
+   {
+      ret |= ciaaPOSIX_POLLIN;
+   }
+
+   if ( (0 != (events & ciaaPOSIX_POLLOUT)) &&
+         !ciaaLibs_circBufFull(&serialDevice->txBuf) )
+   {
+      ret |= ciaaPOSIX_POLLOUT;
+   }
+
+   /* the task does not wait if an event is ready */
+   if (0 != ret)
+   {
+      serialDevice->poll.taskID = 255;
+   }
+
+   return ret;
+}
+
+extern ssize_t ciaaSerialDevices_writev(ciaaDevices_deviceType const * const device, ciaaPOSIX_iovecType const * const iov, int32_t const iovcnt)
+{
+   /* get serial device */
+   ciaaSerialDevices_deviceType * serialDevice =
+      (ciaaSerialDevices_deviceType*) device->layer;
+   int32_t ret = 0;
+   int32_t total = 0;
+   ciaaLibs_CircBufType * cbuf = &serialDevice->txBuf;
+   int32_t head;
+   uint32_t space;
+   int32_t vec = 0;
+   size_t stored = 0;
+
+   /* the pending asynchronous writes are stored in the tx buffer in the
+    * transmit confirmation, a write now would be a second producer */
+   if (NULL != serialDevice->txAio.head)
+   {
+      ciaaPOSIX_errno = EBUSY;
+      total = -1;
+   }
+   else
+   {
+      do
       {
-         /* increment buffer */
-         buf += ret;
+         /* read head and space */
+         head = ciaaLibs_circBufHead(cbuf);
+         space = ciaaLibs_circBufSpace(cbuf, head);
 
-         /* set the task to sleep until some data have been send */
+         /* put as many buffers as possible in the queue */
+         while((vec < iovcnt) && (0 < space))
+         {
+            ret = ciaaLibs_circBufPut(cbuf,
+                  (uint8_t const *)iov[vec].iov_base + stored,
+                  ciaaLibs_min(iov[vec].iov_len - stored, space));
+            space -= ret;
+            stored += ret;
+            total += ret;
+
+            /* continue with the next buffer if this one is complete */
+            if (stored == iov[vec].iov_len)
+            {
+               vec++;
+               stored = 0;
+            }
+         }
 
-         /* TODO improve this: https://github.com/ciaa/Firmware/issues/88 */
-         serialDevice->device->ioctl(device->loLayer, ciaaPOSIX_IOCTL_SET_ENABLE_TX_INTERRUPT, (void*)false);
-         /* get task id and function for waking up the task later */
-         GetTaskID(&serialDevice->blocked.taskID);
-         serialDevice->blocked.fct = (void*) ciaaSerialDevices_write;
+         /* starts the transmission if not already ongoing */
+         serialDevice->device->ioctl(
+               device->loLayer,
+               ciaaPOSIX_IOCTL_STARTTX,
+               NULL);
 
-         /* TODO improve this: https://github.com/ciaa/Firmware/issues/88 */
-         serialDevice->device->ioctl(device->loLayer, ciaaPOSIX_IOCTL_SET_ENABLE_TX_INTERRUPT, (void*)true);
-         /* wait to write all data or for the txConfirmation */
+         /* if not all bytes could be stored in the buffer */
+         if (vec < iovcnt)
+         {
+            /* set the task to sleep until some data have been send */
+
+            /* TODO improve this: https://github.com/ciaa/Firmware/issues/88 */
+            serialDevice->device->ioctl(device->loLayer, ciaaPOSIX_IOCTL_SET_ENABLE_TX_INTERRUPT, (void*)false);
+            /* get task id and function for waking up the task later */
+            GetTaskID(&serialDevice->blocked.taskID);
+            serialDevice->blocked.fct = (void*) ciaaSerialDevices_write;
+
+            /* TODO improve this: https://github.com/ciaa/Firmware/issues/88 */
+            serialDevice->device->ioctl(device->loLayer, ciaaPOSIX_IOCTL_SET_ENABLE_TX_INTERRUPT, (void*)true);
+            /* wait to write all data or for the txConfirmation */
 #ifdef POSIXE
-         WaitEvent(POSIXE);
-         ClearEvent(POSIXE);
+            WaitEvent(POSIXE);
+            ClearEvent(POSIXE);
 #endif
+         }
       }
+      while (vec < iovcnt);
    }
-   while (total < nbyte);
 
    return total;
 }
@@ -384,36 +830,39 @@ extern void ciaaSerialDevices_txConfirmation(ciaaDevices_deviceType const * cons
       (ciaaSerialDevices_deviceType*) device->layer;
    uint32_t write = 0;
    ciaaLibs_CircBufType * cbuf = &serialDevice->txBuf;
-   uint32_t tail = cbuf->tail;
-   uint32_t rawCount = ciaaLibs_circBufRawCount(cbuf, tail);
-   uint32_t count = ciaaLibs_circBufCount(cbuf, tail);
+   ciaaLibs_CircBufSpanType span;
+   uint32_t count;
    TaskType taskID = serialDevice->blocked.taskID;
 
+   /* fill the space released by the last confirmation with the pending
+    * asynchronous writes */
+   ciaaSerialDevices_aioWrite(serialDevice);
+
+   count = ciaaLibs_circBufReadReserve(cbuf, &span, cbuf->size);
+
    /* if some data have to be transmitted */
    if (count > 0)
    {
-      /* write data to the driver */
-      write = serialDevice->device->write(device->loLayer, ciaaLibs_circBufReadPos(cbuf), rawCount);
-
-      /* update buffer */
-      ciaaLibs_circBufUpdateHead(cbuf, write);
+      /* write data to the driver directly from the buffer */
+      write = serialDevice->device->write(device->loLayer, span.buf[0], span.nbytes[0]);
 
       /* if all bytes were written and more data is available */
-      if ( (write == rawCount) && (count > rawCount ) )
+      if ( (write == span.nbytes[0]) && (0 < span.nbytes[1]) )
       {
-         /* re calculate rawCount */
-         rawCount = ciaaLibs_circBufRawCount(cbuf, tail);
+         /* write more bytes from the begin of the buffer */
+         write += serialDevice->device->write(device->loLayer,
+               span.buf[1], span.nbytes[1]);
+      }
 
-         /* write more bytes */
-         write = serialDevice->device->write(device->loLayer,
-               ciaaLibs_circBufReadPos(cbuf), rawCount);
+      /* release the transmitted bytes */
+      ciaaLibs_circBufReadRelease(cbuf, write);
 
-         if (write > 0)
-         {
-            /* update buffer */
-            ciaaLibs_circBufUpdateHead(cbuf, write);
-         }
+      /* the released space may be awaited */
+      if (0 < write)
+      {
+         ciaaSerialDevices_pollWakeUp(serialDevice, ciaaPOSIX_POLLOUT);
       }
+
       /* if task is blocked and waiting for reception of this device */
       if ( (255 != taskID) &&
             (serialDevice->blocked.fct ==
@@ -439,25 +888,25 @@ extern void ciaaSerialDevices_rxIndication(ciaaDevices_deviceType const * const
    ciaaSerialDevices_deviceType * serialDevice =
       (ciaaSerialDevices_deviceType*) device->layer;
    ciaaLibs_CircBufType * cbuf = &serialDevice->rxBuf;
-   uint32_t head = cbuf->head;
-   uint32_t rawSpace = ciaaLibs_circBufRawSpace(cbuf, head);
-   uint32_t space = ciaaLibs_circBufSpace(cbuf, head);
+   ciaaLibs_CircBufSpanType span;
+   uint32_t space = ciaaLibs_circBufWriteReserve(cbuf, &span, cbuf->size);
    uint32_t read = 0;
    TaskType taskID = serialDevice->blocked.taskID;
 
-   read = serialDevice->device->read(device->loLayer, ciaaLibs_circBufWritePos(cbuf), rawSpace);
+   /* read directly into the buffer */
+   read = serialDevice->device->read(device->loLayer, span.buf[0], span.nbytes[0]);
 
-   /* if rawSpace is full but more space is avaialble */
-   if ((read == rawSpace) && (space > rawSpace))
+   /* if the first span is full but more space is avaialble */
+   if ((read == span.nbytes[0]) && (0 < span.nbytes[1]))
    {
       read += serialDevice->device->read(
             device->loLayer,
-            &cbuf->buf[0],
-            space - rawSpace);
+            span.buf[1],
+            span.nbytes[1]);
    }
    else
    {
-      if ((read == rawSpace) && (space <= rawSpace))
+      if ((read == span.nbytes[0]) && (read == space))
       {
          /* data may be lost because not place on the receive buffer */
          /* TODO */
@@ -469,8 +918,15 @@ extern void ciaaSerialDevices_rxIndication(ciaaDevices_deviceType const * const
       }
    }
 
-   /* update tail */
-   ciaaLibs_circBufUpdateTail(cbuf, read);
+   /* commit the received bytes */
+   ciaaLibs_circBufWriteCommit(cbuf, read);
+
+   /* the received data may be awaited */
+   if (0 < read)
+   {
+      ciaaSerialDevices_aioRead(serialDevice);
+      ciaaSerialDevices_pollWakeUp(serialDevice, ciaaPOSIX_POLLIN);
+   }
 
    /* if data has been read */
    if ( (0 < read) && (255 != taskID) &&
@@ -0,0 +1,327 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ * All rights reserved.
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** \brief Benchmark of the ciaa POSIX heap
+ **
+ ** Measures the latency of ciaaPOSIX_malloc and ciaaPOSIX_free and the
+ ** fragmentation of the heap on the ciaa_sim_ia32 target. A pseudo random
+ ** sequence of allocations and frees is performed keeping up to param
+ ** blocks allocated, one line per measurement is reported with comma
+ ** separated values:
+ **
+ ** benchmark,variant,param,ops,avg_ns,max_ns,failed,largest_block
+ **
+ ** - benchmark: name of the measured function
+ ** - variant: range of the requested sizes (slab, heap or mixed)
+ ** - param: maximal count of allocated blocks
+ ** - ops: count of measured calls
+ ** - avg_ns: average time of each call in ns
+ ** - max_ns: worst time of a call in ns
+ ** - failed: count of allocations which returned NULL
+ ** - largest_block: biggest allocation possible after the sequence
+ **
+ ** Each call is measured alone, so the times include the overhead of
+ ** reading the clock.
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup POSIX POSIX Implementation
+ ** @{ */
+/** \addtogroup Benchmarks Benchmarks
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "os.h"
+#include "ciaaPOSIX_stdio.h"
+#include "ciaaPOSIX_stdlib.h"
+#include "ciaak.h"
+#include "ciaaLibs_Maths.h"
+
+#if (x86 == ARCH)
+#include "time.h"
+#else
+#error the heap benchmark is only supported for ARCH x86
+#endif
+
+/*==================[macros and definitions]=================================*/
+/** \brief count of allocations and frees of each measurement */
+#define BENCH_OPS                (16 * 1024)
+
+/** \brief maximal count of allocated blocks */
+#define BENCH_MAXLIVE            (64)
+
+/** \brief upper limit of the largest block search */
+#define BENCH_MAXBLOCK           (64 * 1024)
+
+/** \brief count of elements of an array */
+#define BENCH_COUNT(array)       (sizeof(array) / sizeof((array)[0]))
+
+/*==================[internal data declaration]==============================*/
+/** \brief range of the requested sizes */
+typedef struct {
+   char const * name;            /** <= name of the variant */
+   size_t min;                   /** <= minimal requested size */
+   size_t max;                   /** <= maximal requested size */
+} bench_variantType;
+
+/** \brief latency statistics of a function */
+typedef struct {
+   uint32_t ops;                 /** <= count of calls */
+   uint64_t total;               /** <= sum of the times of all calls */
+   uint64_t max;                 /** <= worst time of a call */
+   uint32_t failed;              /** <= count of failed calls */
+} bench_statsType;
+
+/*==================[internal functions declaration]=========================*/
+/** \brief get current time
+ **
+ ** \return monotonic time in ns
+ **/
+static uint64_t bench_now(void);
+
+/** \brief pseudo random numbers
+ **
+ ** \return next pseudo random number
+ **/
+static uint32_t bench_rand(void);
+
+/** \brief add a measured call to the statistics
+ **
+ ** \param[inout] stats statistics to be updated
+ ** \param[in] ns time of the call
+ **/
+static void bench_add(bench_statsType * stats, uint64_t ns);
+
+/** \brief print the statistics of a function
+ **
+ ** \param[in] benchmark name of the measured function
+ ** \param[in] variant name of the variant
+ ** \param[in] param maximal count of allocated blocks
+ ** \param[in] stats statistics to be printed
+ ** \param[in] largest largest block after the sequence
+ **/
+static void bench_print(char const * benchmark, char const * variant,
+      uint32_t param, bench_statsType const * stats, size_t largest);
+
+/** \brief find the biggest possible allocation
+ **
+ ** \return size of the biggest block which can be allocated
+ **/
+static size_t bench_largest(void);
+
+/** \brief measure a random sequence of allocations and frees
+ **
+ ** \param[in] variant range of the requested sizes
+ ** \param[in] live maximal count of allocated blocks
+ **/
+static void bench_heap(bench_variantType const * variant, uint32_t live);
+
+/*==================[internal data definition]===============================*/
+/** \brief ranges of the requested sizes */
+static bench_variantType const bench_variants[] = {
+   { "slab",  8,   256 },
+   { "heap",  257, 1024 },
+   { "mixed", 8,   1024 },
+};
+
+/** \brief maximal counts of allocated blocks */
+static uint32_t const bench_lives[] = { 8, 16, 32, BENCH_MAXLIVE };
+
+/** \brief allocated blocks */
+static void * bench_blocks[BENCH_MAXLIVE];
+
+/** \brief state of the pseudo random generator */
+static uint32_t bench_random;
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static uint64_t bench_now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+
+   return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t bench_rand(void)
+{
+   bench_random = (bench_random * 1103515245u) + 12345u;
+
+   return bench_random >> 8;
+}
+
+static void bench_add(bench_statsType * stats, uint64_t ns)
+{
+   stats->ops++;
+   stats->total += ns;
+   stats->max = ciaaLibs_max(stats->max, ns);
+}
+
+static void bench_print(char const * benchmark, char const * variant,
+      uint32_t param, bench_statsType const * stats, size_t largest)
+{
+   ciaaPOSIX_printf("%s,%s,%u,%u,%.1f,%u,%u,%u\n", benchmark, variant, param,
+         stats->ops, (double)stats->total / (double)ciaaLibs_max(stats->ops, 1),
+         (uint32_t)stats->max, stats->failed, (uint32_t)largest);
+}
+
+static size_t bench_largest(void)
+{
+   size_t low = 0;
+   size_t high = BENCH_MAXBLOCK;
+   size_t size;
+   void * ptr;
+
+   /* binary search of the biggest size which can be allocated */
+   while(low < high)
+   {
+      size = (low + high + 1) / 2;
+      ptr = ciaaPOSIX_malloc(size);
+      if (NULL != ptr)
+      {
+         ciaaPOSIX_free(ptr);
+         low = size;
+      }
+      else
+      {
+         high = size - 1;
+      }
+   }
+
+   return low;
+}
+
+static void bench_heap(bench_variantType const * variant, uint32_t live)
+{
+   bench_statsType mallocStats = { 0, 0, 0, 0 };
+   bench_statsType freeStats = { 0, 0, 0, 0 };
+   uint32_t loopi;
+   uint32_t pos;
+   size_t size;
+   size_t largest;
+   uint64_t start;
+   uint64_t ns;
+
+   /* same sequence for all versions */
+   bench_random = 0x2016u;
+
+   for(loopi = 0; loopi < BENCH_OPS; loopi++)
+   {
+      pos = bench_rand() % live;
+      if (NULL == bench_blocks[pos])
+      {
+         size = variant->min + (bench_rand() % (variant->max - variant->min + 1));
+
+         start = bench_now();
+         bench_blocks[pos] = ciaaPOSIX_malloc(size);
+         ns = bench_now() - start;
+
+         bench_add(&mallocStats, ns);
+         if (NULL == bench_blocks[pos])
+         {
+            mallocStats.failed++;
+         }
+      }
+      else
+      {
+         start = bench_now();
+         ciaaPOSIX_free(bench_blocks[pos]);
+         ns = bench_now() - start;
+
+         bench_add(&freeStats, ns);
+         bench_blocks[pos] = NULL;
+      }
+   }
+
+   /* fragmentation with the blocks still allocated */
+   largest = bench_largest();
+
+   bench_print("ciaaPOSIX_malloc", variant->name, live, &mallocStats, largest);
+   bench_print("ciaaPOSIX_free", variant->name, live, &freeStats, largest);
+
+   for(pos = 0; pos < live; pos++)
+   {
+      ciaaPOSIX_free(bench_blocks[pos]);
+      bench_blocks[pos] = NULL;
+   }
+}
+
+/*==================[external functions definition]==========================*/
+int main(void)
+{
+   StartOS(AppMode1);
+   return 0;
+}
+
+void ErrorHook(void)
+{
+   ciaaPOSIX_printf("ErrorHook was called\n");
+   ciaaPOSIX_printf("Service: %d, P1: %d, P2: %d, P3: %d, RET: %d\n", OSErrorGetServiceId(), OSErrorGetParam1(), OSErrorGetParam2(), OSErrorGetParam3(), OSErrorGetRet());
+   ShutdownOS(0);
+}
+
+/*==================[tasks]==================================================*/
+TASK(InitTask)
+{
+   size_t loopi;
+   size_t loopj;
+
+   ciaak_start();
+
+   ciaaPOSIX_printf("benchmark,variant,param,ops,avg_ns,max_ns,failed,largest_block\n");
+
+   /* largest block of the empty heap */
+   ciaaPOSIX_printf("ciaaPOSIX_malloc,empty,0,0,0,0,0,%u\n",
+         (uint32_t)bench_largest());
+
+   for(loopi = 0; loopi < BENCH_COUNT(bench_variants); loopi++)
+   {
+      for(loopj = 0; loopj < BENCH_COUNT(bench_lives); loopj++)
+      {
+         bench_heap(&bench_variants[loopi], bench_lives[loopj]);
+      }
+   }
+
+   ShutdownOS(0);
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+
@@ -0,0 +1,275 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ * All rights reserved.
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+/** \brief Benchmark of the ciaa POSIX memory functions
+ **
+ ** Measures ciaaPOSIX_memcpy, ciaaPOSIX_memmove and ciaaPOSIX_memset on the
+ ** ciaa_sim_ia32 target against a byte per byte loop, as implemented
+ ** before the word copies, and against the functions of the host libc.
+ ** One line per measurement is reported with comma separated values:
+ **
+ ** benchmark,variant,size,alignment,ops,avg_ns,mb_s
+ **
+ ** - benchmark: name of the measured function
+ ** - variant: ciaa, bytewise or libc
+ ** - size: count of bytes of each call
+ ** - alignment: offset of the source from a word, the destination is
+ **   always aligned
+ ** - ops: count of measured calls
+ ** - avg_ns: average time of each call in ns
+ ** - mb_s: throughput in MB/s
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup POSIX POSIX Implementation
+ ** @{ */
+/** \addtogroup Benchmarks Benchmarks
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "os.h"
+#include "ciaaPOSIX_stdio.h"
+#include "ciaaPOSIX_string.h"
+#include "ciaak.h"
+
+#if (x86 == ARCH)
+#include "time.h"
+#include "string.h"
+#else
+#error the string benchmark is only supported for ARCH x86
+#endif
+
+/*==================[macros and definitions]=================================*/
+/** \brief count of bytes copied by each measurement */
+#define BENCH_BYTES              (16 * 1024 * 1024)
+
+/** \brief biggest size of a call */
+#define BENCH_MAXSIZE            (4096)
+
+/** \brief count of elements of an array */
+#define BENCH_COUNT(array)       (sizeof(array) / sizeof((array)[0]))
+
+/*==================[internal data declaration]==============================*/
+/** \brief copy function */
+typedef void * (*bench_copyType)(void * s1, void const * s2, size_t n);
+
+/** \brief set function */
+typedef void * (*bench_setType)(void * s, int c, size_t n);
+
+/** \brief measured implementations of a function */
+typedef struct {
+   char const * benchmark;       /** <= name of the measured function */
+   bench_copyType copy[3];       /** <= ciaa, bytewise and libc copies or
+                                        NULL for set functions */
+   bench_setType set[3];         /** <= ciaa, bytewise and libc sets or NULL
+                                        for copy functions */
+} bench_functionType;
+
+/*==================[internal functions declaration]=========================*/
+/** \brief get current time
+ **
+ ** \return monotonic time in ns
+ **/
+static uint64_t bench_now(void);
+
+/** \brief byte per byte copy, as ciaaPOSIX_memcpy before the word copies
+ **
+ ** \param[out] s1 destination pointer
+ ** \param[in] s2 source pointer
+ ** \param[in] n count of bytes to be copied
+ ** \return s1
+ **/
+static void * bench_bytewiseCopy(void * s1, void const * s2, size_t n);
+
+/** \brief byte per byte set, as ciaaPOSIX_memset before the word sets
+ **
+ ** \param[out] s pointer to the memory to be set
+ ** \param[in] c value to set the memory to
+ ** \param[in] n count of bytes to be set
+ ** \return s
+ **/
+static void * bench_bytewiseSet(void * s, int c, size_t n);
+
+/** \brief measure a function
+ **
+ ** \param[in] function function to be measured
+ ** \param[in] variant index of the implementation
+ ** \param[in] size count of bytes of each call
+ ** \param[in] alignment offset of the source from a word
+ **/
+static void bench_measure(bench_functionType const * function,
+      uint32_t variant, size_t size, uint32_t alignment);
+
+/*==================[internal data definition]===============================*/
+/** \brief names of the implementations */
+static char const * const bench_variants[] = { "ciaa", "bytewise", "libc" };
+
+/** \brief measured functions */
+static bench_functionType const bench_functions[] = {
+   { "memcpy",
+      { ciaaPOSIX_memcpy, bench_bytewiseCopy, memcpy }, { NULL, NULL, NULL } },
+   { "memmove",
+      { ciaaPOSIX_memmove, bench_bytewiseCopy, memmove }, { NULL, NULL, NULL } },
+   { "memset",
+      { NULL, NULL, NULL }, { ciaaPOSIX_memset, bench_bytewiseSet, memset } },
+};
+
+/** \brief sizes of the calls */
+static size_t const bench_sizes[] = { 16, 64, 256, 1024, BENCH_MAXSIZE };
+
+/** \brief offsets of the source from a word */
+static uint32_t const bench_alignments[] = { 0, 1 };
+
+/** \brief source memory, aligned to 8 bytes */
+static uint64_t bench_src[(BENCH_MAXSIZE / sizeof(uint64_t)) + 1];
+
+/** \brief destination memory, aligned to 8 bytes */
+static uint64_t bench_dst[(BENCH_MAXSIZE / sizeof(uint64_t)) + 1];
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+static uint64_t bench_now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+
+   return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+/* the compiler shall not replace the loops with calls to the libc */
+__attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+static void * bench_bytewiseCopy(void * s1, void const * s2, size_t n)
+{
+   while(0 < n)
+   {
+      n--;
+      ((uint8_t*)s1)[n] = ((uint8_t const *)s2)[n];
+   }
+
+   return s1;
+}
+
+__attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+static void * bench_bytewiseSet(void * s, int c, size_t n)
+{
+   while(0 < n)
+   {
+      n--;
+      ((uint8_t*)s)[n] = (uint8_t)c;
+   }
+
+   return s;
+}
+
+static void bench_measure(bench_functionType const * function,
+      uint32_t variant, size_t size, uint32_t alignment)
+{
+   uint8_t * src = (uint8_t *)bench_src + alignment;
+   uint8_t * dst = (uint8_t *)bench_dst;
+   uint32_t ops = BENCH_BYTES / size;
+   uint32_t loopi;
+   uint64_t start;
+   uint64_t ns;
+
+   start = bench_now();
+   for(loopi = 0; loopi < ops; loopi++)
+   {
+      if (NULL != function->copy[variant])
+      {
+         function->copy[variant](dst, src, size);
+      }
+      else
+      {
+         function->set[variant](dst, (int)loopi, size);
+      }
+   }
+   ns = bench_now() - start;
+
+   ciaaPOSIX_printf("%s,%s,%u,%u,%u,%.1f,%.1f\n", function->benchmark,
+         bench_variants[variant], (uint32_t)size, alignment, ops,
+         (double)ns / (double)ops, ((double)BENCH_BYTES * 1000.0) / (double)ns);
+}
+
+/*==================[external functions definition]==========================*/
+int main(void)
+{
+   StartOS(AppMode1);
+   return 0;
+}
+
+void ErrorHook(void)
+{
+   ciaaPOSIX_printf("ErrorHook was called\n");
+   ciaaPOSIX_printf("Service: %d, P1: %d, P2: %d, P3: %d, RET: %d\n", OSErrorGetServiceId(), OSErrorGetParam1(), OSErrorGetParam2(), OSErrorGetParam3(), OSErrorGetRet());
+   ShutdownOS(0);
+}
+
+/*==================[tasks]==================================================*/
+TASK(InitTask)
+{
+   size_t loopi;
+   size_t loopj;
+   size_t loopk;
+   uint32_t variant;
+
+   ciaak_start();
+
+   ciaaPOSIX_printf("benchmark,variant,size,alignment,ops,avg_ns,mb_s\n");
+
+   for(loopi = 0; loopi < BENCH_COUNT(bench_functions); loopi++)
+   {
+      for(loopj = 0; loopj < BENCH_COUNT(bench_sizes); loopj++)
+      {
+         for(loopk = 0; loopk < BENCH_COUNT(bench_alignments); loopk++)
+         {
+            for(variant = 0; variant < BENCH_COUNT(bench_variants); variant++)
+            {
+               bench_measure(&bench_functions[loopi], variant, bench_sizes[loopj],
+                     bench_alignments[loopk]);
+            }
+         }
+      }
+   }
+
+   ShutdownOS(0);
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
+
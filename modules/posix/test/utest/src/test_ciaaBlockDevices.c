@@ -45,23 +45,130 @@
 /*==================[inclusions]=============================================*/
 #include "unity.h"
 #include "string.h"
+#include "stdlib.h"
 #include "ciaaSerialDevices.h"
+#include "ciaaBlockDevices.h"
+#include "ciaaPOSIX_stdio.h"
+#include "ciaaPOSIX_errno.h"
 #include "test_ciaaBlockDevices.h"
+#include "mock_ciaaDevices.h"
+#include "mock_ciaaPOSIX_string.h"
+#include "mock_ciaak_main.h"
+#include "mock_os.h"
 
 /*==================[macros and definitions]=================================*/
+/** \brief alarm of the read timeout */
+#define TEST_ALARM            3
+
+/** \brief ticks of the read timeout */
+#define TEST_TICKS            100
 
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
+static ssize_t test_read(ciaaDevices_deviceType const * const device,
+      uint8_t * const buf, size_t const nbyte);
+
+static int32_t test_ioctl(ciaaDevices_deviceType const * const device,
+      int32_t const request, void * param);
 
 /*==================[internal data definition]===============================*/
+/** \brief driver of the tests, the read is always indicated later */
+static ciaaDevices_deviceType test_driver = {
+   "sd/0",        /* path */
+   NULL,          /* open */
+   NULL,          /* close */
+   test_read,     /* read */
+   NULL,          /* write */
+   test_ioctl,    /* ioctl */
+   NULL,          /* lseek */
+   NULL,          /* upLayer */
+   NULL,          /* layer */
+   NULL,          /* loLayer */
+   NULL,          /* readv */
+   NULL,          /* writev */
+   NULL           /* poll */
+};
+
+/** \brief block device created for the driver */
+static ciaaDevices_deviceType * test_device;
+
+/** \brief the read is indicated while the task waits */
+static bool test_indicate;
+
+/** \brief the driver supports cancelling a transfer */
+static bool test_cancelSupported;
+
+/** \brief count of transfers cancelled in the driver */
+static uint32_t test_cancelled;
+
+/** \brief count of waits of the task */
+static uint32_t test_waits;
 
 /*==================[external data definition]===============================*/
-uint16_t ciaaPOSIX_errno;
+int16_t ciaaPOSIX_errno;
 
 char const * const ciaaPOSIX_assert_msg = \
       "ASSERT Failed in %s:%d in expression %s\n";
 /*==================[internal functions definition]==========================*/
+static ssize_t test_read(ciaaDevices_deviceType const * const device,
+      uint8_t * const buf, size_t const nbyte)
+{
+   return 0;
+}
+
+static int32_t test_ioctl(ciaaDevices_deviceType const * const device,
+      int32_t const request, void * param)
+{
+   int32_t ret = -1;
+
+   if ( (ciaaPOSIX_IOCTL_BLOCK_CANCEL == request) && test_cancelSupported )
+   {
+      test_cancelled++;
+      ret = 0;
+   }
+
+   return ret;
+}
+
+static void * test_malloc(size_t size, int cmock_num_calls)
+{
+   return malloc(size);
+}
+
+static size_t test_strlen(char const * s, int cmock_num_calls)
+{
+   return strlen(s);
+}
+
+static char * test_strcat(char * dest, char const * src, int cmock_num_calls)
+{
+   return strcat(dest, src);
+}
+
+static void test_addDevice(ciaaDevices_deviceType * device, int cmock_num_calls)
+{
+   test_device = device;
+}
+
+static StatusType test_GetTaskID(TaskRefType TaskID, int cmock_num_calls)
+{
+   *TaskID = 1;
+
+   return E_OK;
+}
+
+static StatusType test_WaitEvent(EventMaskType Mask, int cmock_num_calls)
+{
+   test_waits++;
+
+   if (test_indicate)
+   {
+      ciaaBlockDevices_readIndication(test_device, 0);
+   }
+
+   return E_OK;
+}
 
 /*==================[external functions definition]==========================*/
 /** \brief set Up function
@@ -70,8 +177,25 @@ char const * const ciaaPOSIX_assert_msg = \
  **
  **/
 void setUp(void) {
+   ciaak_malloc_StubWithCallback(test_malloc);
+   ciaaPOSIX_strlen_StubWithCallback(test_strlen);
+   ciaaPOSIX_strcat_StubWithCallback(test_strcat);
+   ciaaDevices_addDevice_StubWithCallback(test_addDevice);
+   GetTaskID_StubWithCallback(test_GetTaskID);
+   WaitEvent_StubWithCallback(test_WaitEvent);
+   ClearEvent_IgnoreAndReturn(E_OK);
+   SetEvent_IgnoreAndReturn(E_OK);
+   SuspendAllInterrupts_Ignore();
+   ResumeAllInterrupts_Ignore();
+
+   test_indicate = false;
+   test_cancelSupported = true;
+   test_cancelled = 0;
+   test_waits = 0;
+
    /* perform the initialization of ciaa Devices */
    ciaaBlockDevices_init();
+   ciaaBlockDevices_addDriver(&test_driver);
 }
 
 /** \brief tear Down function
@@ -82,10 +206,117 @@ void setUp(void) {
 void tearDown(void) {
 }
 
-/** \brief test POSIX get device before adding one
+/** \brief test a blocking read without timeout
  **
  **/
-void testTODO(void) {
+void testReadWithoutTimeout(void) {
+   uint8_t buf[16];
+
+   test_indicate = true;
+
+   TEST_ASSERT_EQUAL_INT32(sizeof(buf),
+         ciaaBlockDevices_read(test_device, buf, sizeof(buf)));
+}
+
+/** \brief test a blocking read indicated before the timeout
+ **
+ **/
+void testReadBeforeTimeout(void) {
+   ciaaPOSIX_timeoutType timeout = { TEST_ALARM, TEST_TICKS };
+   uint8_t buf[16];
+
+   TEST_ASSERT_EQUAL_INT32(0, ciaaBlockDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_SET_TIMEOUT, &timeout));
+
+   test_indicate = true;
+   SetRelAlarm_ExpectAndReturn(TEST_ALARM, TEST_TICKS, 0, E_OK);
+   CancelAlarm_ExpectAndReturn(TEST_ALARM, E_OK);
+
+   TEST_ASSERT_EQUAL_INT32(sizeof(buf),
+         ciaaBlockDevices_read(test_device, buf, sizeof(buf)));
+}
+
+/** \brief test a blocking read which times out
+ **
+ **/
+void testReadTimeout(void) {
+   ciaaPOSIX_timeoutType timeout = { TEST_ALARM, TEST_TICKS };
+   uint8_t buf[16];
+
+   TEST_ASSERT_EQUAL_INT32(0, ciaaBlockDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_SET_TIMEOUT, &timeout));
+
+   SetRelAlarm_ExpectAndReturn(TEST_ALARM, TEST_TICKS, 0, E_OK);
+   CancelAlarm_ExpectAndReturn(TEST_ALARM, E_OS_NOFUNC);
+
+   ciaaPOSIX_errno = 0;
+   TEST_ASSERT_EQUAL_INT32(-1,
+         ciaaBlockDevices_read(test_device, buf, sizeof(buf)));
+   TEST_ASSERT_EQUAL_INT16(ETIMEDOUT, ciaaPOSIX_errno);
+
+   /* the probe of the timeout and the timed out read */
+   TEST_ASSERT_EQUAL_UINT32(2, test_cancelled);
+
+   /* a late indication of the timed out read is ignored */
+   ciaaBlockDevices_readIndication(test_device, 0);
+
+   /* the timeout is removed with NULL */
+   TEST_ASSERT_EQUAL_INT32(0, ciaaBlockDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_SET_TIMEOUT, NULL));
+   test_indicate = true;
+   TEST_ASSERT_EQUAL_INT32(sizeof(buf),
+         ciaaBlockDevices_read(test_device, buf, sizeof(buf)));
+}
+
+/** \brief test a blocking read whose alarm is already in use
+ **
+ **/
+void testReadAlarmInUse(void) {
+   ciaaPOSIX_timeoutType timeout = { TEST_ALARM, TEST_TICKS };
+   uint8_t buf[16];
+
+   TEST_ASSERT_EQUAL_INT32(0, ciaaBlockDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_SET_TIMEOUT, &timeout));
+
+   /* the read is not awaited and the alarm is not cancelled */
+   SetRelAlarm_ExpectAndReturn(TEST_ALARM, TEST_TICKS, 0, E_OS_STATE);
+
+   ciaaPOSIX_errno = 0;
+   TEST_ASSERT_EQUAL_INT32(-1,
+         ciaaBlockDevices_read(test_device, buf, sizeof(buf)));
+   TEST_ASSERT_EQUAL_INT16(EBUSY, ciaaPOSIX_errno);
+   TEST_ASSERT_EQUAL_UINT32(0, test_waits);
+   TEST_ASSERT_EQUAL_UINT32(2, test_cancelled);
+}
+
+/** \brief test that a timeout is rejected if the driver can not cancel
+ **
+ **/
+void testTimeoutWithoutCancel(void) {
+   ciaaPOSIX_timeoutType timeout = { TEST_ALARM, TEST_TICKS };
+   uint8_t buf[16];
+
+   test_cancelSupported = false;
+
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaBlockDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_SET_TIMEOUT, &timeout));
+
+   /* the read waits forever */
+   test_indicate = true;
+   TEST_ASSERT_EQUAL_INT32(sizeof(buf),
+         ciaaBlockDevices_read(test_device, buf, sizeof(buf)));
+}
+
+/** \brief test that the asynchronous requests are rejected
+ **
+ **/
+void testAioNotSupported(void) {
+   ciaaPOSIX_aiocbType aiocb;
+
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaBlockDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_AIO_READ, &aiocb));
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaBlockDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_AIO_WRITE, &aiocb));
 }
 
 /** @} doxygen end group definition */
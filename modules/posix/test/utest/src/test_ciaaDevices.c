@@ -46,16 +46,26 @@
 /*==================[inclusions]=============================================*/
 #include "unity.h"
 #include "string.h"
+#include "stdlib.h"
+#include "stdio.h"
 #include "ciaaDevices.h"
 #include "test_ciaaDevices.h"
+#include "mock_ciaak_main.h"
 
 /*==================[macros and definitions]=================================*/
+/** \brief count of devices added by the test of many devices */
+#define TEST_DEVICES          (4 * ciaaDevices_BUCKETS)
 
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
+/** \brief devices of the test of many devices */
+static ciaaDevices_deviceType test_devices[TEST_DEVICES];
+
+/** \brief paths of the devices of the test of many devices */
+static char test_paths[TEST_DEVICES][24];
 
 /*==================[external data definition]===============================*/
 ciaaDevices_deviceType const dev_uart0 = {
@@ -76,7 +86,27 @@ ciaaDevices_deviceType const dev_uart1 = {
    testIoctl1
 };
 
+ciaaDevices_deviceType const dev_uart10 = {
+   "/dev/serial/uart/10",
+   testOpen1,
+   testClose1,
+   testRead1,
+   testWrite1,
+   testIoctl1
+};
+
 /*==================[internal functions definition]==========================*/
+/** \brief malloc callback of the registry nodes */
+static void * test_malloc(size_t size, int cmock_num_calls)
+{
+   return malloc(size);
+}
+
+/** \brief strcmp callback of the path comparison */
+static int8_t test_strcmp(char const * s1, char const * s2, int cmock_num_calls)
+{
+   return (int8_t)strcmp(s1, s2);
+}
 
 /*==================[external functions definition]==========================*/
 int32_t testOpen0(uint8_t const * const path, uint8_t const oflag)
@@ -147,6 +177,9 @@ int32_t testSeek1(int32_t const fildes, int32_t offset, uint8_t whence)
 void setUp(void) {
    /* ignore calls to sem_init */
    ciaaPOSIX_sem_init_CMockIgnoreAndReturn(1);
+   /* the registry nodes are allocated from the host heap */
+   ciaak_malloc_StubWithCallback(test_malloc);
+   ciaaPOSIX_strcmp_StubWithCallback(test_strcmp);
    /* perform the initialization of ciaa Devices */
    ciaaDevices_init();
 }
@@ -188,8 +221,6 @@ void testGetAfterAddDevice(void) {
    ciaaDevices_addDevice(&dev_uart0);
 
    /* get uart 1 device */
-   ciaaPOSIX_strncmp_StubWithCallback(strncmp);
-   ciaaPOSIX_strlen_StubWithCallback(strlen);
    device1 = ciaaDevices_getDevice("/dev/serial/uart/0");
    device2 = ciaaDevices_getDevice("/dev/serial/uart/1");
 
@@ -206,7 +237,6 @@ void testGetAfterAddingMultipleDevices(void) {
    ciaaDevices_addDevice(&dev_uart1);
 
    /* get uart 1 device */
-   ciaaPOSIX_strcmp_StubWithCallback(strcmp);
    device1 = ciaaDevices_getDevice("/dev/serial/uart/0");
    device2 = ciaaDevices_getDevice("/dev/serial/uart/1");
 
@@ -214,6 +244,55 @@ void testGetAfterAddingMultipleDevices(void) {
    TEST_ASSERT_TRUE(&dev_uart1 == device2);
 }
 
+/** \brief test that a path is not found by a prefix of it
+ **
+ **/
+void testGetDeviceExactPath(void) {
+   /* add devices whose paths are prefix of each other */
+   ciaaDevices_addDevice(&dev_uart1);
+   ciaaDevices_addDevice(&dev_uart10);
+
+   TEST_ASSERT_TRUE(&dev_uart1 == ciaaDevices_getDevice("/dev/serial/uart/1"));
+   TEST_ASSERT_TRUE(&dev_uart10 == ciaaDevices_getDevice("/dev/serial/uart/10"));
+   TEST_ASSERT_TRUE(NULL == ciaaDevices_getDevice("/dev/serial/uart/100"));
+   TEST_ASSERT_TRUE(NULL == ciaaDevices_getDevice("/dev/serial/uart/"));
+   TEST_ASSERT_TRUE(NULL == ciaaDevices_getDevice("/dev/serial/uart/2"));
+}
+
+/** \brief test that a path can only be added once
+ **
+ **/
+void testAddDevicePathTwice(void) {
+   ciaaDevices_deviceType dev_copy = dev_uart0;
+
+   ciaaDevices_addDevice(&dev_uart0);
+   ciaaDevices_addDevice(&dev_copy);
+
+   /* the first added device is kept */
+   TEST_ASSERT_TRUE(&dev_uart0 == ciaaDevices_getDevice("/dev/serial/uart/0"));
+}
+
+/** \brief test more devices than buckets
+ **
+ **/
+void testGetAfterAddingManyDevices(void) {
+   uint32_t loopi;
+
+   for(loopi = 0; loopi < TEST_DEVICES; loopi++)
+   {
+      sprintf(test_paths[loopi], "/dev/dio/out/%u", loopi);
+      test_devices[loopi] = dev_uart0;
+      test_devices[loopi].path = test_paths[loopi];
+      ciaaDevices_addDevice(&test_devices[loopi]);
+   }
+
+   for(loopi = 0; loopi < TEST_DEVICES; loopi++)
+   {
+      TEST_ASSERT_TRUE(&test_devices[loopi] == ciaaDevices_getDevice(test_paths[loopi]));
+   }
+   TEST_ASSERT_TRUE(NULL == ciaaDevices_getDevice("/dev/serial/uart/0"));
+}
+
 
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -0,0 +1,599 @@
+/* Copyright 2016, ACSE & CADIEEL
+ *    ACSE   : http://www.sase.com.ar/asociacion-civil-sistemas-embebidos/ciaa/
+ *    CADIEEL: http://www.cadieel.org.ar
+ *
+ * This file is part of CIAA Firmware.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/** \brief This file implements the test of the POSIX stdio
+ **
+ **/
+
+/** \addtogroup CIAA_Firmware CIAA Firmware
+/** \addtogroup CIAA_Firmware CIAA Firmware
+ ** @{ */
+/** \addtogroup POSIX POSIX Implementation
+ ** @{ */
+/** \addtogroup ModuleTests Module Tests
+ ** @{ */
+
+/*==================[inclusions]=============================================*/
+#include "unity.h"
+#include "string.h"
+#include "ciaaPOSIX_stdio.h"
+#include "ciaaPOSIX_stdbool.h"
+#include "ciaaPOSIX_errno.h"
+#include "mock_ciaaDevices.h"
+#include "mock_ciaaPOSIX_string.h"
+#include "mock_os.h"
+
+/*==================[macros and definitions]=================================*/
+/** \brief task id returned by GetTaskID */
+#define TEST_TASK             3
+
+/** \brief size of the data buffer of the test device */
+#define TEST_DATA_SIZE        64
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static ciaaDevices_deviceType * test_open(char const * path,
+      ciaaDevices_deviceType * device, uint8_t const oflag);
+
+static int32_t test_close(ciaaDevices_deviceType const * const device);
+
+static ssize_t test_read(ciaaDevices_deviceType const * const device,
+      uint8_t * const buf, size_t const nbyte);
+
+static ssize_t test_write(ciaaDevices_deviceType const * const device,
+      uint8_t const * const buf, size_t const nbyte);
+
+static int32_t test_ioctl(ciaaDevices_deviceType const * const device,
+      int32_t const request, void * param);
+
+/*==================[internal data definition]===============================*/
+/** \brief device of the tests */
+static ciaaDevices_deviceType test_device = {
+   "/dev/serial/uart/0",
+   test_open,
+   test_close,
+   test_read,
+   test_write,
+   NULL,
+   NULL
+};
+
+/** \brief the open function of the device fails if true */
+static bool test_openFails;
+
+/** \brief count of calls to the close function of the device */
+static uint32_t test_closeCount;
+
+/** \brief data read and written by the device */
+static uint8_t test_data[TEST_DATA_SIZE];
+
+/** \brief count of bytes of test_data already read or written */
+static size_t test_dataPos;
+
+/** \brief count of bytes of test_data which can be read or written */
+static size_t test_dataEnd;
+
+/** \brief count of calls to the read and write functions of the device */
+static uint32_t test_rwCount;
+
+/** \brief ready events of the device */
+static int16_t test_ready;
+
+/** \brief the calling task is registered to be woken by the device */
+static bool test_registered;
+
+/** \brief ready events of the device after a call to WaitEvent */
+static int16_t test_readyAfterWait;
+
+/** \brief last request passed to the ioctl function of the device */
+static int32_t test_ioctlRequest;
+
+/** \brief last param passed to the ioctl function of the device */
+static void * test_ioctlParam;
+
+/*==================[external data definition]===============================*/
+int16_t ciaaPOSIX_errno;
+
+char const * const ciaaPOSIX_assert_msg = \
+      "ASSERT Failed in %s:%d in expression %s\n";
+
+/*==================[internal functions definition]==========================*/
+static ciaaDevices_deviceType * test_open(char const * path,
+      ciaaDevices_deviceType * device, uint8_t const oflag)
+{
+   return test_openFails ? NULL : device;
+}
+
+static int32_t test_ioctl(ciaaDevices_deviceType const * const device,
+      int32_t const request, void * param)
+{
+   test_ioctlRequest = request;
+   test_ioctlParam = param;
+
+   return 0;
+}
+
+static int32_t test_close(ciaaDevices_deviceType const * const device)
+{
+   test_closeCount++;
+
+   return 0;
+}
+
+static ssize_t test_read(ciaaDevices_deviceType const * const device,
+      uint8_t * const buf, size_t const nbyte)
+{
+   size_t count = nbyte;
+
+   if (count > (test_dataEnd - test_dataPos))
+   {
+      count = test_dataEnd - test_dataPos;
+   }
+   memcpy(buf, &test_data[test_dataPos], count);
+   test_dataPos += count;
+   test_rwCount++;
+
+   return (ssize_t)count;
+}
+
+static ssize_t test_write(ciaaDevices_deviceType const * const device,
+      uint8_t const * const buf, size_t const nbyte)
+{
+   size_t count = nbyte;
+
+   if (count > (test_dataEnd - test_dataPos))
+   {
+      count = test_dataEnd - test_dataPos;
+   }
+   memcpy(&test_data[test_dataPos], buf, count);
+   test_dataPos += count;
+   test_rwCount++;
+
+   return (ssize_t)count;
+}
+
+static ssize_t test_writev(ciaaDevices_deviceType const * const device,
+      ciaaPOSIX_iovecType const * const iov, int32_t const iovcnt)
+{
+   ssize_t ret = 0;
+   int32_t loopi;
+
+   for(loopi = 0; loopi < iovcnt; loopi++)
+   {
+      ret += test_write(device, iov[loopi].iov_base, iov[loopi].iov_len);
+   }
+
+   /* count the call only once */
+   test_rwCount -= (iovcnt - 1);
+
+   return ret;
+}
+
+static int16_t test_poll(ciaaDevices_deviceType const * const device,
+      int16_t const events, bool const notify)
+{
+   int16_t ret = events & test_ready;
+
+   test_registered = notify && (0 == ret);
+
+   return ret;
+}
+
+static StatusType test_WaitEvent(EventMaskType Mask, int cmock_num_calls)
+{
+   /* the task shall only wait if it is registered in the device */
+   TEST_ASSERT_TRUE(test_registered);
+   TEST_ASSERT_EQUAL_UINT32(POSIXE, Mask);
+
+   test_ready = test_readyAfterWait;
+
+   return E_OK;
+}
+
+static int8_t test_strncmp(char const * s1, char const * s2, size_t n,
+      int cmock_num_calls)
+{
+   return (int8_t)strncmp(s1, s2, n);
+}
+
+static size_t test_strlen(char const * s, int cmock_num_calls)
+{
+   return strlen(s);
+}
+
+static ciaaDevices_deviceType * test_getDevice(char const * const path,
+      int cmock_num_calls)
+{
+   return (0 == strcmp(path, test_device.path)) ? &test_device : NULL;
+}
+
+static StatusType test_GetTaskID(TaskRefType TaskID, int cmock_num_calls)
+{
+   *TaskID = TEST_TASK;
+
+   return E_OK;
+}
+
+/*==================[external functions definition]==========================*/
+/** \brief set Up function
+ **
+ ** This function is called before each test case is executed
+ **
+ **/
+void setUp(void) {
+   ciaaPOSIX_strncmp_StubWithCallback(test_strncmp);
+   ciaaPOSIX_strlen_StubWithCallback(test_strlen);
+   ciaaDevices_getDevice_StubWithCallback(test_getDevice);
+   GetTaskID_StubWithCallback(test_GetTaskID);
+
+   test_openFails = false;
+   test_closeCount = 0;
+   memset(test_data, 0, sizeof(test_data));
+   test_dataPos = 0;
+   test_dataEnd = TEST_DATA_SIZE;
+   test_rwCount = 0;
+   test_device.ioctl = test_ioctl;
+   test_device.writev = NULL;
+   test_device.poll = NULL;
+   test_ready = 0;
+   test_registered = false;
+   test_ioctlRequest = -1;
+   test_ioctlParam = NULL;
+
+   ciaaPOSIX_init();
+}
+
+/** \brief tear Down function
+ **
+ ** This function is called after each test case is executed
+ **
+ **/
+void tearDown(void) {
+}
+
+/** \brief test open of all file descriptors
+ **
+ ** the lowest free file descriptor is returned
+ **
+ **/
+void testOpenAllFileDescriptors(void) {
+   int32_t loopi;
+
+   for(loopi = 0; loopi < ciaaPOSIX_stdio_MAXFILDES; loopi++)
+   {
+      TEST_ASSERT_EQUAL_INT32(loopi,
+            ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+   }
+
+   /* all file descriptors are used */
+   TEST_ASSERT_EQUAL_INT32(-1,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+
+   /* a closed file descriptor is reused */
+   TEST_ASSERT_EQUAL_INT32(0, ciaaPOSIX_close(ciaaPOSIX_stdio_MAXFILDES - 1));
+   TEST_ASSERT_EQUAL_INT32(0, ciaaPOSIX_close(1));
+   TEST_ASSERT_EQUAL_INT32(1,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+   TEST_ASSERT_EQUAL_INT32(ciaaPOSIX_stdio_MAXFILDES - 1,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+   TEST_ASSERT_EQUAL_INT32(-1,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+
+   for(loopi = 0; loopi < ciaaPOSIX_stdio_MAXFILDES; loopi++)
+   {
+      TEST_ASSERT_EQUAL_INT32(0, ciaaPOSIX_close(loopi));
+   }
+   TEST_ASSERT_EQUAL_UINT32(ciaaPOSIX_stdio_MAXFILDES + 2, test_closeCount);
+}
+
+/** \brief test open of an invalid device
+ **
+ **/
+void testOpenInvalidDevice(void) {
+   TEST_ASSERT_EQUAL_INT32(-1,
+         ciaaPOSIX_open("/dev/serial/uart/23", ciaaPOSIX_O_RDWR));
+
+   /* no file descriptor has been used */
+   TEST_ASSERT_EQUAL_INT32(0,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+}
+
+/** \brief test the release of the file descriptor if open fails
+ **
+ **/
+void testOpenFailed(void) {
+   test_openFails = true;
+   TEST_ASSERT_EQUAL_INT32(-1,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+
+   test_openFails = false;
+   TEST_ASSERT_EQUAL_INT32(0,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+
+   /* the failed descriptor can not be used */
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_close(1));
+}
+
+/** \brief test the access to invalid file descriptors
+ **
+ **/
+void testInvalidFileDescriptors(void) {
+   uint8_t buf[4];
+
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_close(-1));
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_close(ciaaPOSIX_stdio_MAXFILDES));
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_close(0));
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_read(0, buf, sizeof(buf)));
+
+   TEST_ASSERT_EQUAL_INT32(0,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDONLY));
+   TEST_ASSERT_EQUAL_INT32(sizeof(buf), ciaaPOSIX_read(0, buf, sizeof(buf)));
+   TEST_ASSERT_EQUAL_INT32(0, ciaaPOSIX_close(0));
+
+   /* the file descriptor can not be closed twice */
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_close(0));
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_read(0, buf, sizeof(buf)));
+   TEST_ASSERT_EQUAL_UINT32(1, test_closeCount);
+}
+
+/** \brief test writev with a device without writev function
+ **
+ ** the buffers are written one after the other
+ **
+ **/
+void testWritevPerBuffer(void) {
+   char const head[] = "HEAD";
+   char const payload[] = "payload";
+   char const crc[] = "CRC";
+   ciaaPOSIX_iovecType iov[3] = {
+      { (void *)head, 4 },
+      { (void *)payload, 7 },
+      { (void *)crc, 3 }
+   };
+
+   TEST_ASSERT_EQUAL_INT32(0,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_writev(0, iov, 0));
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_writev(1, iov, 3));
+
+   TEST_ASSERT_EQUAL_INT32(14, ciaaPOSIX_writev(0, iov, 3));
+   TEST_ASSERT_EQUAL_MEMORY("HEADpayloadCRC", test_data, 14);
+   TEST_ASSERT_EQUAL_UINT32(3, test_rwCount);
+
+   /* the device accepts only 6 more bytes, the last buffer is not written */
+   test_rwCount = 0;
+   test_dataEnd = test_dataPos + 6;
+   TEST_ASSERT_EQUAL_INT32(6, ciaaPOSIX_writev(0, iov, 3));
+   TEST_ASSERT_EQUAL_MEMORY("HEADpa", &test_data[14], 6);
+   TEST_ASSERT_EQUAL_UINT32(2, test_rwCount);
+}
+
+/** \brief test writev with a device with writev function
+ **
+ **/
+void testWritevDevice(void) {
+   char const head[] = "HEAD";
+   char const payload[] = "payload";
+   ciaaPOSIX_iovecType iov[2] = {
+      { (void *)head, 4 },
+      { (void *)payload, 7 }
+   };
+
+   test_device.writev = test_writev;
+   TEST_ASSERT_EQUAL_INT32(0,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+
+   TEST_ASSERT_EQUAL_INT32(11, ciaaPOSIX_writev(0, iov, 2));
+   TEST_ASSERT_EQUAL_MEMORY("HEADpayload", test_data, 11);
+   TEST_ASSERT_EQUAL_UINT32(1, test_rwCount);
+}
+
+/** \brief test readv with a device without readv function
+ **
+ ** the buffers are filled one after the other
+ **
+ **/
+void testReadvPerBuffer(void) {
+   uint8_t head[4];
+   uint8_t payload[8];
+   uint8_t crc[2];
+   ciaaPOSIX_iovecType iov[3] = {
+      { head, sizeof(head) },
+      { payload, sizeof(payload) },
+      { crc, sizeof(crc) }
+   };
+
+   memcpy(test_data, "0123456789abcdefghij", 20);
+   TEST_ASSERT_EQUAL_INT32(0,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_readv(0, iov, 0));
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_readv(1, iov, 3));
+
+   TEST_ASSERT_EQUAL_INT32(14, ciaaPOSIX_readv(0, iov, 3));
+   TEST_ASSERT_EQUAL_MEMORY("0123", head, 4);
+   TEST_ASSERT_EQUAL_MEMORY("456789ab", payload, 8);
+   TEST_ASSERT_EQUAL_MEMORY("cd", crc, 2);
+
+   /* only 3 bytes are available, the last buffers are not read */
+   test_rwCount = 0;
+   test_dataEnd = test_dataPos + 3;
+   TEST_ASSERT_EQUAL_INT32(3, ciaaPOSIX_readv(0, iov, 3));
+   TEST_ASSERT_EQUAL_MEMORY("efg", head, 3);
+   TEST_ASSERT_EQUAL_UINT32(1, test_rwCount);
+}
+
+/** \brief test poll without waiting
+ **
+ **/
+void testPollNoWait(void) {
+   ciaaPOSIX_pollfdType fds[4];
+
+   TEST_ASSERT_EQUAL_INT32(0,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+   TEST_ASSERT_EQUAL_INT32(1,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_poll(NULL, 1, 0));
+
+   /* a device without poll function is always ready */
+   fds[0].fd = 0;
+   fds[0].events = ciaaPOSIX_POLLIN;
+   fds[1].fd = -1;
+   fds[1].events = ciaaPOSIX_POLLIN;
+   fds[2].fd = 2;
+   fds[2].events = ciaaPOSIX_POLLIN;
+   fds[3].fd = ciaaPOSIX_stdio_MAXFILDES;
+   fds[3].events = ciaaPOSIX_POLLOUT;
+   TEST_ASSERT_EQUAL_INT32(3, ciaaPOSIX_poll(fds, 4, 0));
+   TEST_ASSERT_EQUAL_INT16(ciaaPOSIX_POLLIN, fds[0].revents);
+   TEST_ASSERT_EQUAL_INT16(0, fds[1].revents);
+   TEST_ASSERT_EQUAL_INT16(ciaaPOSIX_POLLNVAL, fds[2].revents);
+   TEST_ASSERT_EQUAL_INT16(ciaaPOSIX_POLLNVAL, fds[3].revents);
+
+   /* only the requested events which are ready are returned */
+   test_device.poll = test_poll;
+   test_ready = ciaaPOSIX_POLLOUT;
+   fds[0].events = ciaaPOSIX_POLLIN;
+   fds[1].fd = 1;
+   fds[1].events = ciaaPOSIX_POLLIN | ciaaPOSIX_POLLOUT;
+   TEST_ASSERT_EQUAL_INT32(1, ciaaPOSIX_poll(fds, 2, 0));
+   TEST_ASSERT_EQUAL_INT16(0, fds[0].revents);
+   TEST_ASSERT_EQUAL_INT16(ciaaPOSIX_POLLOUT, fds[1].revents);
+   TEST_ASSERT_FALSE(test_registered);
+}
+
+/** \brief test poll waiting for an event
+ **
+ **/
+void testPollWait(void) {
+   ciaaPOSIX_pollfdType fds[2];
+
+   TEST_ASSERT_EQUAL_INT32(0,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+   TEST_ASSERT_EQUAL_INT32(1,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+
+   test_device.poll = test_poll;
+   test_readyAfterWait = ciaaPOSIX_POLLIN;
+   WaitEvent_StubWithCallback(test_WaitEvent);
+   ClearEvent_IgnoreAndReturn(E_OK);
+
+   fds[0].fd = 0;
+   fds[0].events = ciaaPOSIX_POLLOUT;
+   fds[1].fd = 1;
+   fds[1].events = ciaaPOSIX_POLLIN;
+   TEST_ASSERT_EQUAL_INT32(1, ciaaPOSIX_poll(fds, 2, -1));
+   TEST_ASSERT_EQUAL_INT16(0, fds[0].revents);
+   TEST_ASSERT_EQUAL_INT16(ciaaPOSIX_POLLIN, fds[1].revents);
+
+   /* the registration has been removed */
+   TEST_ASSERT_FALSE(test_registered);
+}
+
+/** \brief test poll with a timeout without the alarm POSIXA
+ **
+ **/
+void testPollTimeoutWithoutAlarm(void) {
+   ciaaPOSIX_pollfdType fds[1];
+
+   TEST_ASSERT_EQUAL_INT32(0,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+   fds[0].fd = 0;
+   fds[0].events = ciaaPOSIX_POLLIN;
+
+   ciaaPOSIX_errno = 0;
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_poll(fds, 1, 10));
+   TEST_ASSERT_EQUAL_INT16(EINVAL, ciaaPOSIX_errno);
+}
+
+/** \brief test that the asynchronous requests are passed to the device
+ **
+ **/
+void testAioRequests(void) {
+   ciaaPOSIX_aiocbType aiocb;
+
+   TEST_ASSERT_EQUAL_INT32(0,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+
+   TEST_ASSERT_EQUAL_INT32(0, ciaaPOSIX_aio_read(0, &aiocb));
+   TEST_ASSERT_EQUAL_INT32(ciaaPOSIX_IOCTL_AIO_READ, test_ioctlRequest);
+   TEST_ASSERT_EQUAL_PTR(&aiocb, test_ioctlParam);
+
+   TEST_ASSERT_EQUAL_INT32(0, ciaaPOSIX_aio_write(0, &aiocb));
+   TEST_ASSERT_EQUAL_INT32(ciaaPOSIX_IOCTL_AIO_WRITE, test_ioctlRequest);
+   TEST_ASSERT_EQUAL_PTR(&aiocb, test_ioctlParam);
+
+   /* cancelling is only possible with ioctl */
+   TEST_ASSERT_EQUAL_INT32(0,
+         ciaaPOSIX_ioctl(0, ciaaPOSIX_IOCTL_AIO_READ, NULL));
+   TEST_ASSERT_EQUAL_INT32(ciaaPOSIX_IOCTL_AIO_READ, test_ioctlRequest);
+   TEST_ASSERT_NULL(test_ioctlParam);
+}
+
+/** \brief test that the rx indication request does not reach the device
+ **
+ **/
+void testIoctlRxIndication(void) {
+   TEST_ASSERT_EQUAL_INT32(0,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+
+   TEST_ASSERT_EQUAL_INT32(-1,
+         ciaaPOSIX_ioctl(0, ciaaPOSIX_IOCTL_RXINDICATION, NULL));
+   TEST_ASSERT_EQUAL_INT32(-1, test_ioctlRequest);
+}
+
+/** \brief test asynchronous requests with invalid parameters
+ **
+ **/
+void testAioInvalid(void) {
+   ciaaPOSIX_aiocbType aiocb;
+
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_aio_read(0, &aiocb));
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_aio_write(0, &aiocb));
+
+   TEST_ASSERT_EQUAL_INT32(0,
+         ciaaPOSIX_open("/dev/serial/uart/0", ciaaPOSIX_O_RDWR));
+
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_aio_read(0, NULL));
+   TEST_ASSERT_EQUAL_INT32(-1, ciaaPOSIX_aio_write(0, NULL));
+   TEST_ASSERT_EQUAL_INT32(-1, test_ioctlRequest);
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
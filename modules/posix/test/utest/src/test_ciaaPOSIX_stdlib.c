@@ -45,18 +45,116 @@
 
 /*==================[inclusions]=============================================*/
 #include "unity.h"
+#include "ciaaPOSIX_stdlib.h"
+#include "mock_ciaaLibs_PoolBuf.h"
+#include "mock_ciaaPOSIX_string.h"
 
 /*==================[macros and definitions]=================================*/
+/** \brief count of allocations of the random heap test */
+#define TEST_HEAP_ALLOCS         64
+
+/** \brief count of operations of the random heap test */
+#define TEST_HEAP_OPS            4096
 
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
+static void * test_poolBufLock(ciaaLibs_poolBufType * pbuf, int cmock_num_calls);
+
+static size_t test_poolBufFree(ciaaLibs_poolBufType * pbuf, void * data,
+      int cmock_num_calls);
+
+static void * test_memcpy(void * s1, void const * s2, size_t n,
+      int cmock_num_calls);
+
+static void * test_memset(void * s, int c, size_t n, int cmock_num_calls);
 
 /*==================[internal data definition]===============================*/
+/** \brief element size of the slab of the last locked element */
+static size_t test_slabSize;
+
+/** \brief element returned by the slab stub, NULL if the slab is full */
+static void * test_slabElement;
+
+/** \brief count of elements returned to a slab */
+static uint32_t test_slabFreed;
+
+/** \brief memory of the slab elements */
+static uint64_t test_slabMem[32];
+
+/** \brief state of the pseudo random generator */
+static uint32_t test_random;
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/** \brief pseudo random numbers
+ **
+ ** \return next pseudo random number
+ **/
+static uint32_t test_rand(void)
+{
+   test_random = (test_random * 1103515245u) + 12345u;
+
+   return test_random >> 8;
+}
+
+/** \brief stub of ciaaLibs_poolBufLock
+ **
+ ** Stores the element size of the slab and returns test_slabElement.
+ **/
+static void * test_poolBufLock(ciaaLibs_poolBufType * pbuf, int cmock_num_calls)
+{
+   test_slabSize = pbuf->elementSize;
+
+   return test_slabElement;
+}
+
+/** \brief stub of ciaaLibs_poolBufFree
+ **
+ ** Only elements of test_slabMem are accepted by the slab of its element
+ ** size.
+ **/
+static size_t test_poolBufFree(ciaaLibs_poolBufType * pbuf, void * data,
+      int cmock_num_calls)
+{
+   size_t ret = 0;
+
+   if ((data == (void *)test_slabMem) && (pbuf->elementSize == test_slabSize))
+   {
+      test_slabFreed++;
+      ret = 1;
+   }
+
+   return ret;
+}
+
+/** \brief stub of ciaaPOSIX_memcpy */
+static void * test_memcpy(void * s1, void const * s2, size_t n,
+      int cmock_num_calls)
+{
+   size_t loopi;
+
+   for(loopi = 0; loopi < n; loopi++)
+   {
+      ((uint8_t *)s1)[loopi] = ((uint8_t const *)s2)[loopi];
+   }
+
+   return s1;
+}
+
+/** \brief stub of ciaaPOSIX_memset */
+static void * test_memset(void * s, int c, size_t n, int cmock_num_calls)
+{
+   size_t loopi;
+
+   for(loopi = 0; loopi < n; loopi++)
+   {
+      ((uint8_t *)s)[loopi] = (uint8_t)c;
+   }
+
+   return s;
+}
 
 /*==================[external functions definition]==========================*/
 /** \brief set Up function
@@ -70,6 +168,17 @@ void setUp(void) {
    ciaaPOSIX_sem_wait_CMockIgnoreAndReturn(1);
    ciaaPOSIX_sem_post_CMockIgnoreAndReturn(1);
 
+   /* slabs are full unless a test provides an element */
+   ciaaLibs_poolBufInit_IgnoreAndReturn(1);
+   ciaaLibs_poolBufLock_StubWithCallback(test_poolBufLock);
+   ciaaLibs_poolBufFree_StubWithCallback(test_poolBufFree);
+   test_slabSize = 0;
+   test_slabElement = NULL;
+   test_slabFreed = 0;
+
+   ciaaPOSIX_memcpy_StubWithCallback(test_memcpy);
+   ciaaPOSIX_memset_StubWithCallback(test_memset);
+
    /* perform the initialization of ciaa Devices */
    ciaaPOSIX_stdlib_init();
 }
@@ -116,6 +225,544 @@ void testGetMoreThanAvailable(void) {
    TEST_ASSERT_TRUE(NULL == ptr2);
 }
 
+/** \brief test POSIX malloc size classes
+ **
+ ** small requests are served from the slab of the power of two size class
+ **
+ **/
+void testMallocSizeClasses(void) {
+   size_t const sizes[][2] = {
+      {   0,   8 }, {   1,   8 }, {   8,   8 }, {   9,  16 }, {  16,  16 },
+      {  17,  32 }, {  33,  64 }, {  64,  64 }, { 100, 128 }, { 129, 256 },
+      { 256, 256 },
+   };
+   uint32_t loopi;
+
+   test_slabElement = test_slabMem;
+
+   for(loopi = 0; loopi < (sizeof(sizes) / sizeof(sizes[0])); loopi++)
+   {
+      test_slabSize = 0;
+      TEST_ASSERT_EQUAL_PTR(test_slabMem, ciaaPOSIX_malloc(sizes[loopi][0]));
+      TEST_ASSERT_EQUAL_INT(sizes[loopi][1], test_slabSize);
+   }
+
+   /* bigger requests are not served by the slabs */
+   test_slabSize = 0;
+   TEST_ASSERT_TRUE(test_slabMem != ciaaPOSIX_malloc(257));
+   TEST_ASSERT_EQUAL_INT(0, test_slabSize);
+}
+
+/** \brief test POSIX free
+ **
+ ** memory is returned to the slab or to the heap
+ **
+ **/
+void testFree(void) {
+   void * ptr1;
+   void * ptr2;
+
+   /* slab element */
+   test_slabElement = test_slabMem;
+   ptr1 = ciaaPOSIX_malloc(20);
+   TEST_ASSERT_EQUAL_PTR(test_slabMem, ptr1);
+   ciaaPOSIX_free(ptr1);
+   TEST_ASSERT_EQUAL_INT(1, test_slabFreed);
+
+   /* full slab, the memory is taken from the heap */
+   test_slabElement = NULL;
+   ptr1 = ciaaPOSIX_malloc(20);
+   TEST_ASSERT_TRUE(NULL != ptr1);
+   TEST_ASSERT_TRUE(test_slabMem != ptr1);
+
+   /* the heap memory is reused after free */
+   ciaaPOSIX_free(ptr1);
+   TEST_ASSERT_EQUAL_INT(1, test_slabFreed);
+   ptr2 = ciaaPOSIX_malloc(20);
+   TEST_ASSERT_EQUAL_PTR(ptr1, ptr2);
+}
+/** \brief test heap merging of free blocks
+ **
+ ** freed neighbour blocks are merged so a big block can be allocated again
+ **
+ **/
+void testHeapMerge(void) {
+   void * ptr[64];
+   uint32_t count;
+   uint32_t loopi;
+
+   /* fill the heap of the fast region with blocks */
+   for(count = 0; (count < 64) &&
+         (NULL != (ptr[count] = ciaaPOSIX_malloc_hint(300, ciaaPOSIX_MEM_FAST)));
+         count++)
+   {
+      /* the memory is aligned to a word */
+      TEST_ASSERT_EQUAL_INT(0, (uintptr_t)ptr[count] % sizeof(size_t));
+   }
+   TEST_ASSERT_TRUE(count > 20);
+   TEST_ASSERT_TRUE(count < 64);
+   TEST_ASSERT_TRUE(NULL == ciaaPOSIX_malloc_hint(1000, ciaaPOSIX_MEM_FAST));
+
+   /* free every second block, the free memory is fragmented */
+   for(loopi = 0; loopi < count; loopi += 2)
+   {
+      ciaaPOSIX_free(ptr[loopi]);
+   }
+   TEST_ASSERT_TRUE(NULL == ciaaPOSIX_malloc_hint(1000, ciaaPOSIX_MEM_FAST));
+
+   /* free the other blocks in reverse order, merging with both neighbours */
+   for(loopi = count; loopi > 0; loopi--)
+   {
+      if (0 != ((loopi - 1) & 1))
+      {
+         ciaaPOSIX_free(ptr[loopi - 1]);
+      }
+   }
+
+   /* the whole heap is one block again */
+   ptr[0] = ciaaPOSIX_malloc_hint(8000, ciaaPOSIX_MEM_FAST);
+   TEST_ASSERT_TRUE(NULL != ptr[0]);
+   ciaaPOSIX_free(ptr[0]);
+}
+
+/** \brief test heap double free
+ **
+ ** a block freed twice is not inserted twice in the free lists
+ **
+ **/
+void testHeapDoubleFree(void) {
+   ciaaPOSIX_stdlib_statsType stats;
+   ciaaPOSIX_stdlib_statsType freed;
+   ciaaPOSIX_stdlib_statsType merged;
+   void * ptr1;
+   void * ptr2;
+
+   ptr1 = ciaaPOSIX_malloc(500);
+   ciaaPOSIX_free(ptr1);
+   ciaaPOSIX_free(ptr1);
+   ciaaPOSIX_stdlib_getStats(&freed);
+
+   ptr1 = ciaaPOSIX_malloc(500);
+   ptr2 = ciaaPOSIX_malloc(500);
+   TEST_ASSERT_TRUE(NULL != ptr1);
+   TEST_ASSERT_TRUE(NULL != ptr2);
+   TEST_ASSERT_TRUE(ptr1 != ptr2);
+
+   /* a block merged with its free previous block is freed twice, the heap
+    * is one block as before the allocations */
+   ciaaPOSIX_stdlib_getStats(&stats);
+   ciaaPOSIX_free(ptr1);
+   ciaaPOSIX_free(ptr2);
+   ciaaPOSIX_free(ptr2);
+   ciaaPOSIX_stdlib_getStats(&merged);
+   TEST_ASSERT_EQUAL_INT(stats.freeBlocks, merged.freeBlocks);
+   TEST_ASSERT_EQUAL_INT(freed.largestFree, merged.largestFree);
+}
+
+/** \brief test heap with random allocations and frees
+ **
+ ** each allocated block is filled with a pattern which is checked before
+ ** freeing it, overlapping blocks are detected
+ **
+ **/
+void testHeapRandom(void) {
+   uint8_t * ptr[TEST_HEAP_ALLOCS] = { NULL };
+   size_t size[TEST_HEAP_ALLOCS];
+   uint32_t op;
+   uint32_t pos;
+   size_t loopi;
+
+   test_random = 0x12345678u;
+
+   for(op = 0; op < TEST_HEAP_OPS; op++)
+   {
+      pos = test_rand() % TEST_HEAP_ALLOCS;
+      if (NULL == ptr[pos])
+      {
+         size[pos] = test_rand() % 700;
+         ptr[pos] = ciaaPOSIX_malloc(size[pos]);
+         for(loopi = 0; (NULL != ptr[pos]) && (loopi < size[pos]); loopi++)
+         {
+            ptr[pos][loopi] = (uint8_t)(pos + loopi);
+         }
+      }
+      else
+      {
+         for(loopi = 0; loopi < size[pos]; loopi++)
+         {
+            TEST_ASSERT_EQUAL_UINT8((uint8_t)(pos + loopi), ptr[pos][loopi]);
+         }
+         ciaaPOSIX_free(ptr[pos]);
+         ptr[pos] = NULL;
+      }
+   }
+
+   for(pos = 0; pos < TEST_HEAP_ALLOCS; pos++)
+   {
+      ciaaPOSIX_free(ptr[pos]);
+   }
+
+   /* all blocks have been merged */
+   TEST_ASSERT_TRUE(NULL != ciaaPOSIX_malloc(8000));
+}
+
+/** \brief test POSIX malloc with several regions
+ **
+ ** the heap continues in the next region when a region is full
+ **
+ **/
+void testMallocRegions(void) {
+   void * ptr1;
+   void * ptr2;
+
+   ptr1 = ciaaPOSIX_malloc(9000);
+   ptr2 = ciaaPOSIX_malloc(6000);
+
+   TEST_ASSERT_TRUE(NULL != ptr1);
+   TEST_ASSERT_TRUE(NULL != ptr2);
+   TEST_ASSERT_TRUE(ptr1 != ptr2);
+
+   /* both regions are returned to their heap */
+   ciaaPOSIX_free(ptr1);
+   ciaaPOSIX_free(ptr2);
+   TEST_ASSERT_EQUAL_PTR(ptr1, ciaaPOSIX_malloc(9000));
+   TEST_ASSERT_EQUAL_PTR(ptr2, ciaaPOSIX_malloc(6000));
+}
+
+/** \brief test POSIX malloc with placement hints
+ **
+ ** the memory is taken only from the regions fulfilling the hint
+ **
+ **/
+void testMallocHint(void) {
+   void * ptr1;
+   void * ptr2;
+
+   test_slabElement = test_slabMem;
+
+   /* no region is fast and shared */
+   TEST_ASSERT_TRUE(NULL == ciaaPOSIX_malloc_hint(20,
+            ciaaPOSIX_MEM_FAST | ciaaPOSIX_MEM_SHARED));
+
+   /* fast requests are served by the slabs */
+   TEST_ASSERT_EQUAL_PTR(test_slabMem, ciaaPOSIX_malloc_hint(20,
+            ciaaPOSIX_MEM_FAST));
+   TEST_ASSERT_EQUAL_INT(32, test_slabSize);
+
+   /* the slabs are not shared */
+   test_slabSize = 0;
+   ptr1 = ciaaPOSIX_malloc_hint(20, ciaaPOSIX_MEM_SHARED);
+   TEST_ASSERT_TRUE(NULL != ptr1);
+   TEST_ASSERT_TRUE(test_slabMem != ptr1);
+   TEST_ASSERT_EQUAL_INT(0, test_slabSize);
+
+   /* a full fast region does not affect the shared region */
+   TEST_ASSERT_TRUE(NULL != ciaaPOSIX_malloc_hint(9000, ciaaPOSIX_MEM_FAST));
+   TEST_ASSERT_TRUE(NULL == ciaaPOSIX_malloc_hint(2000, ciaaPOSIX_MEM_FAST));
+   ptr2 = ciaaPOSIX_malloc_hint(2000, ciaaPOSIX_MEM_SHARED);
+   TEST_ASSERT_TRUE(NULL != ptr2);
+
+   /* shared memory is reused after free */
+   ciaaPOSIX_free(ptr2);
+   TEST_ASSERT_EQUAL_PTR(ptr2, ciaaPOSIX_malloc_hint(2000, ciaaPOSIX_MEM_SHARED));
+
+   /* pointers out of the regions are ignored */
+   ciaaPOSIX_free((void *)&ptr1);
+}
+
+/** \brief test POSIX memalign
+ **
+ ** the memory is aligned and the memory before it is returned to the heap
+ **
+ **/
+void testMemalign(void) {
+   size_t const alignments[] = { 4, 8, 16, 32, 64, 256, 1024 };
+   uint8_t * ptr[sizeof(alignments) / sizeof(alignments[0])];
+   uint32_t loopi;
+   uint32_t loopj;
+
+   for(loopi = 0; loopi < (sizeof(alignments) / sizeof(alignments[0])); loopi++)
+   {
+      ptr[loopi] = ciaaPOSIX_memalign(alignments[loopi], 100);
+      TEST_ASSERT_TRUE(NULL != ptr[loopi]);
+      TEST_ASSERT_EQUAL_INT(0, (uintptr_t)ptr[loopi] % alignments[loopi]);
+      for(loopj = 0; loopj < 100; loopj++)
+      {
+         ptr[loopi][loopj] = (uint8_t)loopi;
+      }
+   }
+
+   /* the blocks do not overlap */
+   for(loopi = 0; loopi < (sizeof(alignments) / sizeof(alignments[0])); loopi++)
+   {
+      for(loopj = 0; loopj < 100; loopj++)
+      {
+         TEST_ASSERT_EQUAL_UINT8((uint8_t)loopi, ptr[loopi][loopj]);
+      }
+      ciaaPOSIX_free(ptr[loopi]);
+   }
+
+   /* the alignment shall be a power of two */
+   TEST_ASSERT_TRUE(NULL == ciaaPOSIX_memalign(0, 100));
+   TEST_ASSERT_TRUE(NULL == ciaaPOSIX_memalign(24, 100));
+
+   /* all blocks have been merged */
+   TEST_ASSERT_TRUE(NULL != ciaaPOSIX_malloc_hint(8000, ciaaPOSIX_MEM_FAST));
+}
+
+/** \brief test POSIX calloc
+ **
+ ** the memory is set to 0
+ **
+ **/
+void testCalloc(void) {
+   uint8_t * ptr;
+   uint32_t loopi;
+
+   ptr = ciaaPOSIX_malloc(300);
+   for(loopi = 0; loopi < 300; loopi++)
+   {
+      ptr[loopi] = 0xAA;
+   }
+   ciaaPOSIX_free(ptr);
+
+   TEST_ASSERT_EQUAL_PTR(ptr, ciaaPOSIX_calloc(10, 30));
+   for(loopi = 0; loopi < 300; loopi++)
+   {
+      TEST_ASSERT_EQUAL_UINT8(0, ptr[loopi]);
+   }
+
+   /* the size of the array overflows */
+   TEST_ASSERT_TRUE(NULL == ciaaPOSIX_calloc(((size_t)-1) / 2, 3));
+}
+
+/** \brief test POSIX realloc
+ **
+ ** the memory grows in place if possible, otherwise it is moved
+ **
+ **/
+void testRealloc(void) {
+   uint8_t * ptr1;
+   uint8_t * ptr2;
+   uint32_t loopi;
+
+   ptr1 = ciaaPOSIX_malloc(300);
+   for(loopi = 0; loopi < 300; loopi++)
+   {
+      ptr1[loopi] = (uint8_t)loopi;
+   }
+
+   /* the next block is free, the memory grows in place */
+   TEST_ASSERT_EQUAL_PTR(ptr1, ciaaPOSIX_realloc(ptr1, 600));
+
+   /* the next block is used, the memory is moved */
+   ptr2 = ciaaPOSIX_malloc(300);
+   ptr2 = ciaaPOSIX_realloc(ptr1, 2000);
+   TEST_ASSERT_TRUE(NULL != ptr2);
+   TEST_ASSERT_TRUE(ptr1 != ptr2);
+   for(loopi = 0; loopi < 300; loopi++)
+   {
+      TEST_ASSERT_EQUAL_UINT8((uint8_t)loopi, ptr2[loopi]);
+   }
+
+   /* the old memory has been freed */
+   TEST_ASSERT_EQUAL_PTR(ptr1, ciaaPOSIX_malloc(300));
+
+   /* shrinking is done in place */
+   TEST_ASSERT_EQUAL_PTR(ptr2, ciaaPOSIX_realloc(ptr2, 100));
+
+   /* too big requests keep the memory */
+   TEST_ASSERT_TRUE(NULL == ciaaPOSIX_realloc(ptr2, 20000));
+   TEST_ASSERT_EQUAL_UINT8(99, ptr2[99]);
+
+   /* NULL pointers are allocated, size 0 frees the memory */
+   ptr1 = ciaaPOSIX_realloc(NULL, 500);
+   TEST_ASSERT_TRUE(NULL != ptr1);
+   TEST_ASSERT_TRUE(NULL == ciaaPOSIX_realloc(ptr1, 0));
+   TEST_ASSERT_EQUAL_PTR(ptr1, ciaaPOSIX_malloc(500));
+}
+
+/** \brief test POSIX realloc without room to grow in place
+ **
+ ** a free next block too small for the new size is kept free
+ **
+ **/
+void testReallocNextTooSmall(void) {
+   ciaaPOSIX_stdlib_statsType before;
+   ciaaPOSIX_stdlib_statsType after;
+   void * ptr1;
+   void * ptr2;
+
+   ptr1 = ciaaPOSIX_malloc(300);
+   ptr2 = ciaaPOSIX_malloc(300);
+   TEST_ASSERT_TRUE(NULL != ciaaPOSIX_malloc(300));
+   ciaaPOSIX_free(ptr2);
+
+   ciaaPOSIX_stdlib_getStats(&before);
+   TEST_ASSERT_TRUE(NULL == ciaaPOSIX_realloc(ptr1, 20000));
+   ciaaPOSIX_stdlib_getStats(&after);
+
+   TEST_ASSERT_EQUAL_INT(before.freeBlocks, after.freeBlocks);
+   TEST_ASSERT_EQUAL_INT(before.used, after.used);
+}
+
+/** \brief test heap with random aligned allocations and reallocations
+ **
+ ** the pattern of each block is kept while it is resized or moved
+ **
+ **/
+void testHeapRandomRealloc(void) {
+   uint8_t * ptr[TEST_HEAP_ALLOCS] = { NULL };
+   uint8_t * newPtr;
+   size_t size[TEST_HEAP_ALLOCS];
+   size_t newSize;
+   uint32_t op;
+   uint32_t pos;
+   size_t loopi;
+
+   test_random = 0x87654321u;
+
+   for(op = 0; op < TEST_HEAP_OPS; op++)
+   {
+      pos = test_rand() % TEST_HEAP_ALLOCS;
+      newSize = test_rand() % 700;
+      if (NULL == ptr[pos])
+      {
+         ptr[pos] = ciaaPOSIX_memalign((size_t)4 << (test_rand() % 6), newSize);
+         size[pos] = (NULL == ptr[pos]) ? 0 : newSize;
+      }
+      else
+      {
+         for(loopi = 0; loopi < size[pos]; loopi++)
+         {
+            TEST_ASSERT_EQUAL_UINT8((uint8_t)(pos + loopi), ptr[pos][loopi]);
+         }
+         newPtr = ciaaPOSIX_realloc(ptr[pos], newSize);
+         if (NULL != newPtr)
+         {
+            for(loopi = 0; loopi < ((newSize < size[pos]) ? newSize : size[pos]); loopi++)
+            {
+               TEST_ASSERT_EQUAL_UINT8((uint8_t)(pos + loopi), newPtr[loopi]);
+            }
+            ptr[pos] = newPtr;
+            size[pos] = newSize;
+         }
+         else if (0 == newSize)
+         {
+            ptr[pos] = NULL;
+         }
+         else
+         {
+            /* the memory is kept */
+         }
+      }
+      for(loopi = 0; (NULL != ptr[pos]) && (loopi < size[pos]); loopi++)
+      {
+         ptr[pos][loopi] = (uint8_t)(pos + loopi);
+      }
+   }
+
+   for(pos = 0; pos < TEST_HEAP_ALLOCS; pos++)
+   {
+      ciaaPOSIX_free(ptr[pos]);
+   }
+
+   /* all blocks have been merged */
+   TEST_ASSERT_TRUE(NULL != ciaaPOSIX_malloc_hint(8000, ciaaPOSIX_MEM_FAST));
+}
+
+/** \brief test heap statistics
+ **
+ ** the counters follow the allocations and the free blocks are counted
+ **
+ **/
+void testStats(void) {
+   ciaaPOSIX_stdlib_statsType stats;
+   void * ptr;
+   uint32_t loopi;
+   uint32_t latency = 0;
+   size_t used;
+
+   /* each region is a free block */
+   ciaaPOSIX_stdlib_getStats(&stats);
+   TEST_ASSERT_EQUAL_INT(0, stats.used);
+   TEST_ASSERT_EQUAL_INT(0, stats.allocations);
+   TEST_ASSERT_EQUAL_INT(3, stats.freeBlocks);
+   TEST_ASSERT_TRUE(stats.largestFree > 9000);
+
+   ptr = ciaaPOSIX_malloc(1000);
+   ciaaPOSIX_stdlib_getStats(&stats);
+   TEST_ASSERT_TRUE(stats.used >= 1000);
+   TEST_ASSERT_EQUAL_INT(stats.used, stats.peak);
+   TEST_ASSERT_EQUAL_INT(1, stats.allocations);
+   TEST_ASSERT_EQUAL_INT(3, stats.freeBlocks);
+   TEST_ASSERT_TRUE(stats.largestFree > 8000);
+   TEST_ASSERT_TRUE(stats.largestFree < 9000);
+
+   /* the peak is kept after free, a double free is not counted */
+   ciaaPOSIX_free(ptr);
+   ciaaPOSIX_free(ptr);
+   ciaaPOSIX_stdlib_getStats(&stats);
+   TEST_ASSERT_EQUAL_INT(0, stats.used);
+   TEST_ASSERT_TRUE(stats.peak >= 1000);
+   TEST_ASSERT_TRUE(stats.largestFree > 9000);
+
+   /* resizing in place and moving keep the count of used bytes */
+   ptr = ciaaPOSIX_malloc(1000);
+   ptr = ciaaPOSIX_realloc(ptr, 2000);
+   ptr = ciaaPOSIX_realloc(ptr, 500);
+   TEST_ASSERT_TRUE(NULL != ciaaPOSIX_malloc(1000));
+   ptr = ciaaPOSIX_realloc(ptr, 3000);
+   TEST_ASSERT_TRUE(NULL != ptr);
+   ciaaPOSIX_free(ptr);
+   ciaaPOSIX_stdlib_getStats(&stats);
+   used = stats.used;
+   TEST_ASSERT_TRUE(used >= 1000);
+   TEST_ASSERT_TRUE(used < 1100);
+
+   /* failed allocations */
+   TEST_ASSERT_TRUE(NULL == ciaaPOSIX_malloc(100000));
+   ciaaPOSIX_stdlib_getStats(&stats);
+   TEST_ASSERT_EQUAL_INT(1, stats.failures);
+   TEST_ASSERT_EQUAL_INT(5, stats.allocations);
+
+   /* each allocation is counted in the latency histogram */
+   for(loopi = 0; loopi < ciaaPOSIX_stdlib_LATENCYBINS; loopi++)
+   {
+      latency += stats.latency[loopi];
+   }
+   TEST_ASSERT_EQUAL_INT(5, latency);
+}
+
+/** \brief test heap trace
+ **
+ ** allocations and frees are recorded if the trace is enabled
+ **
+ **/
+void testTrace(void) {
+   ciaaPOSIX_stdlib_traceType records[4];
+   void * ptr;
+   size_t count;
+
+   ptr = ciaaPOSIX_malloc(1000);
+   ciaaPOSIX_free(ptr);
+
+   count = ciaaPOSIX_stdlib_readTrace(records, 4);
+   if (0 < ciaaPOSIX_stdlib_TRACESIZE)
+   {
+      TEST_ASSERT_EQUAL_INT(2, count);
+      TEST_ASSERT_EQUAL_PTR(ptr, (void *)records[0].ptr);
+      TEST_ASSERT_EQUAL_INT(1000, records[0].size);
+      TEST_ASSERT_EQUAL_PTR(ptr, (void *)records[1].ptr);
+      TEST_ASSERT_EQUAL_HEX32(ciaaPOSIX_stdlib_TRACEFREE, records[1].size);
+      TEST_ASSERT_TRUE(0 != records[0].callsite);
+      TEST_ASSERT_EQUAL_INT(0, ciaaPOSIX_stdlib_readTrace(records, 4));
+   }
+   else
+   {
+      TEST_ASSERT_EQUAL_INT(0, count);
+   }
+}
 
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
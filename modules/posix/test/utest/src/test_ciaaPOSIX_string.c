@@ -48,16 +48,60 @@
 #include "ciaaPOSIX_string.h"
 
 /*==================[macros and definitions]=================================*/
+/** \brief size of the buffers of the alignment tests */
+#define TEST_BUFFER_SIZE      96
+
+/** \brief count of alignments tested for each pointer */
+#define TEST_ALIGNMENTS       8
+
+/** \brief biggest length of the alignment tests */
+#define TEST_MAX_LENGTH       (TEST_BUFFER_SIZE - (2 * TEST_ALIGNMENTS))
 
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
 
 /*==================[internal data definition]===============================*/
+/** \brief source buffer of the alignment tests, aligned to 8 bytes */
+static uint64_t test_src[TEST_BUFFER_SIZE / sizeof(uint64_t)];
+
+/** \brief destination buffer of the alignment tests, aligned to 8 bytes */
+static uint64_t test_dst[TEST_BUFFER_SIZE / sizeof(uint64_t)];
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/** \brief fill a buffer with a pattern
+ **
+ ** \param[out] buf buffer to be filled
+ ** \param[in] seed first value of the pattern
+ **/
+static void test_fill(uint8_t * buf, uint8_t seed)
+{
+   uint32_t loopi;
+
+   for(loopi = 0; loopi < TEST_BUFFER_SIZE; loopi++)
+   {
+      buf[loopi] = (uint8_t)(seed + (loopi * 7));
+   }
+}
+
+/** \brief fill a buffer with a pattern without nulls
+ **
+ ** The chars of the pattern are different within the buffer.
+ **
+ ** \param[out] buf buffer to be filled
+ ** \param[in] seed first value of the pattern
+ **/
+static void test_fillString(char * buf, uint8_t seed)
+{
+   uint32_t loopi;
+
+   for(loopi = 0; loopi < TEST_BUFFER_SIZE; loopi++)
+   {
+      buf[loopi] = (char)(1 + ((seed + (loopi * 7)) % 255));
+   }
+}
 
 /*==================[external functions definition]==========================*/
 /** \brief set Up function
@@ -266,6 +310,340 @@ void test_ciaaPOSIX_memcmp(void) {
    ret = ciaaPOSIX_memcmp(str2, str1, 10);
    TEST_ASSERT_TRUE(0 < ret);
 }
+
+/** \brief test memcpy alignments
+ **
+ ** copy all lengths with all alignments of source and destination, the
+ ** bytes around the destination shall not be modified
+ **
+ **/
+void test_ciaaPOSIX_memcpyAlignment(void) {
+   uint8_t * src = (uint8_t *)test_src;
+   uint8_t * dst = (uint8_t *)test_dst;
+   uint8_t expected[TEST_BUFFER_SIZE];
+   uint32_t srcAlign;
+   uint32_t dstAlign;
+   uint32_t length;
+   uint32_t loopi;
+
+   test_fill(src, 1);
+   for(srcAlign = 0; srcAlign < TEST_ALIGNMENTS; srcAlign++)
+   {
+      for(dstAlign = 0; dstAlign < TEST_ALIGNMENTS; dstAlign++)
+      {
+         for(length = 0; length <= TEST_MAX_LENGTH; length++)
+         {
+            test_fill(dst, 100);
+            test_fill(expected, 100);
+            for(loopi = 0; loopi < length; loopi++)
+            {
+               expected[dstAlign + loopi] = src[srcAlign + loopi];
+            }
+
+            TEST_ASSERT_EQUAL_PTR(&dst[dstAlign],
+                  ciaaPOSIX_memcpy(&dst[dstAlign], &src[srcAlign], length));
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, dst, TEST_BUFFER_SIZE);
+         }
+      }
+   }
+}
+
+/** \brief test memset alignments
+ **
+ ** set all lengths with all alignments, the bytes around the memory shall
+ ** not be modified
+ **
+ **/
+void test_ciaaPOSIX_memsetAlignment(void) {
+   uint8_t * dst = (uint8_t *)test_dst;
+   uint8_t expected[TEST_BUFFER_SIZE];
+   uint32_t dstAlign;
+   uint32_t length;
+   uint32_t loopi;
+
+   for(dstAlign = 0; dstAlign < TEST_ALIGNMENTS; dstAlign++)
+   {
+      for(length = 0; length <= TEST_MAX_LENGTH; length++)
+      {
+         test_fill(dst, 100);
+         test_fill(expected, 100);
+         for(loopi = 0; loopi < length; loopi++)
+         {
+            expected[dstAlign + loopi] = 0xA5;
+         }
+
+         /* only the lowest byte of c is used */
+         TEST_ASSERT_EQUAL_PTR(&dst[dstAlign],
+               ciaaPOSIX_memset(&dst[dstAlign], 0x12A5, length));
+         TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, dst, TEST_BUFFER_SIZE);
+      }
+   }
+}
+
+/** \brief test memmove
+ **
+ ** move all lengths between overlapping positions of the same buffer in
+ ** both directions
+ **
+ **/
+void test_ciaaPOSIX_memmove(void) {
+   uint8_t * buf = (uint8_t *)test_dst;
+   uint8_t expected[TEST_BUFFER_SIZE];
+   uint8_t copy[TEST_BUFFER_SIZE];
+   uint32_t from;
+   uint32_t to;
+   uint32_t length;
+   uint32_t loopi;
+
+   for(from = 0; from < (2 * TEST_ALIGNMENTS); from++)
+   {
+      for(to = 0; to < (2 * TEST_ALIGNMENTS); to++)
+      {
+         for(length = 0; length <= TEST_MAX_LENGTH; length++)
+         {
+            test_fill(buf, 3);
+            test_fill(expected, 3);
+            test_fill(copy, 3);
+            for(loopi = 0; loopi < length; loopi++)
+            {
+               expected[to + loopi] = copy[from + loopi];
+            }
+
+            TEST_ASSERT_EQUAL_PTR(&buf[to],
+                  ciaaPOSIX_memmove(&buf[to], &buf[from], length));
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buf, TEST_BUFFER_SIZE);
+         }
+      }
+   }
+}
+
+/** \brief test strlen with all alignments and lengths
+ **
+ ** test the function ciaaPOSIX_strlen with chars after the null
+ **
+ **/
+void test_ciaaPOSIX_strlenAlignment(void) {
+   char * str = (char *)test_src;
+   uint32_t align;
+   uint32_t length;
+
+   for(align = 0; align < TEST_ALIGNMENTS; align++)
+   {
+      for(length = 0; length <= TEST_MAX_LENGTH; length++)
+      {
+         test_fillString(str, 1);
+         str[align + length] = 0;
+
+         TEST_ASSERT_EQUAL_UINT32(length, ciaaPOSIX_strlen(&str[align]));
+      }
+   }
+}
+
+/** \brief test strcmp and strncmp with all alignments and lengths
+ **
+ ** test the functions ciaaPOSIX_strcmp and ciaaPOSIX_strncmp with a
+ ** difference and with a shorter string at each position
+ **
+ **/
+void test_ciaaPOSIX_strcmpAlignment(void) {
+   char * buf1 = (char *)test_src;
+   char * buf2 = (char *)test_dst;
+   char * s1;
+   char * s2;
+   int8_t ret;
+   uint32_t align1;
+   uint32_t align2;
+   uint32_t length;
+   uint32_t pos;
+
+   for(align1 = 0; align1 < TEST_ALIGNMENTS; align1++)
+   {
+      for(align2 = 0; align2 < TEST_ALIGNMENTS; align2++)
+      {
+         s1 = &buf1[align1];
+         s2 = &buf2[align2];
+         for(length = 0; length <= TEST_MAX_LENGTH; length++)
+         {
+            /* equal strings with different chars after the null */
+            test_fillString(buf1, 1);
+            test_fillString(buf2, 50);
+            ciaaPOSIX_memcpy(s2, s1, length);
+            s1[length] = 0;
+            s2[length] = 0;
+
+            TEST_ASSERT_EQUAL_INT8(0, ciaaPOSIX_strcmp(s1, s2));
+            TEST_ASSERT_EQUAL_INT8(0, ciaaPOSIX_strncmp(s1, s2, length));
+            TEST_ASSERT_EQUAL_INT8(0, ciaaPOSIX_strncmp(s1, s2, length + 1));
+            TEST_ASSERT_EQUAL_INT8(0, ciaaPOSIX_strncmp(s1, s2, TEST_BUFFER_SIZE));
+
+            for(pos = 0; pos < length; pos++)
+            {
+               /* different char at pos */
+               s2[pos] = (char)((1 == s1[pos]) ? 3 : (s1[pos] ^ 1));
+               ret = (s1[pos] > s2[pos]) ? 1 : -1;
+               TEST_ASSERT_EQUAL_INT8(ret, ciaaPOSIX_strcmp(s1, s2));
+               TEST_ASSERT_EQUAL_INT8(-ret, ciaaPOSIX_strcmp(s2, s1));
+               TEST_ASSERT_EQUAL_INT8(0, ciaaPOSIX_strncmp(s1, s2, pos));
+               TEST_ASSERT_EQUAL_INT8(ret, ciaaPOSIX_strncmp(s1, s2, pos + 1));
+
+               /* s2 is shorter at pos */
+               s2[pos] = 0;
+               ret = (s1[pos] > 0) ? 1 : -1;
+               TEST_ASSERT_EQUAL_INT8(ret, ciaaPOSIX_strcmp(s1, s2));
+               TEST_ASSERT_EQUAL_INT8(-ret, ciaaPOSIX_strncmp(s2, s1, length));
+               s2[pos] = s1[pos];
+            }
+         }
+      }
+   }
+}
+
+/** \brief test strcat with all alignments and lengths
+ **
+ ** test the function ciaaPOSIX_strcat
+ **
+ **/
+void test_ciaaPOSIX_strcatAlignment(void) {
+   char * src = (char *)test_src;
+   char * dst = (char *)test_dst;
+   char expected[TEST_BUFFER_SIZE];
+   uint32_t srcAlign;
+   uint32_t dstLength;
+   uint32_t length;
+
+   for(srcAlign = 0; srcAlign < TEST_ALIGNMENTS; srcAlign++)
+   {
+      for(dstLength = 0; dstLength < (2 * TEST_ALIGNMENTS); dstLength++)
+      {
+         for(length = 0; length <= (TEST_MAX_LENGTH - TEST_ALIGNMENTS); length++)
+         {
+            test_fillString(src, 1);
+            src[srcAlign + length] = 0;
+            test_fillString(dst, 100);
+            dst[dstLength] = 0;
+            test_fillString(expected, 100);
+            ciaaPOSIX_memcpy(&expected[dstLength], &src[srcAlign], length + 1);
+
+            TEST_ASSERT_EQUAL_PTR(dst, ciaaPOSIX_strcat(dst, &src[srcAlign]));
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, dst, TEST_BUFFER_SIZE);
+         }
+      }
+   }
+}
+
+/** \brief test memcmp with all alignments and lengths
+ **
+ ** test the function ciaaPOSIX_memcmp with a difference at each position
+ **
+ **/
+void test_ciaaPOSIX_memcmpAlignment(void) {
+   uint8_t * buf1 = (uint8_t *)test_src;
+   uint8_t * buf2 = (uint8_t *)test_dst;
+   uint8_t * s1;
+   uint8_t * s2;
+   uint32_t align1;
+   uint32_t align2;
+   uint32_t length;
+   uint32_t pos;
+
+   for(align1 = 0; align1 < TEST_ALIGNMENTS; align1++)
+   {
+      for(align2 = 0; align2 < TEST_ALIGNMENTS; align2++)
+      {
+         s1 = &buf1[align1];
+         s2 = &buf2[align2];
+         for(length = 0; length <= TEST_MAX_LENGTH; length++)
+         {
+            /* equal memory with different bytes after the end */
+            test_fill(buf1, 1);
+            test_fill(buf2, 50);
+            ciaaPOSIX_memcpy(s2, s1, length);
+
+            TEST_ASSERT_EQUAL_INT32(0, ciaaPOSIX_memcmp(s1, s2, length));
+
+            for(pos = 0; pos < length; pos++)
+            {
+               /* the bytes are compared as unsigned */
+               s2[pos] = (uint8_t)(s1[pos] ^ 0x80);
+               TEST_ASSERT_EQUAL_INT32((s1[pos] > s2[pos]) ? 1 : -1,
+                     ciaaPOSIX_memcmp(s1, s2, length));
+               TEST_ASSERT_EQUAL_INT32((s2[pos] > s1[pos]) ? 1 : -1,
+                     ciaaPOSIX_memcmp(s2, s1, length));
+               TEST_ASSERT_EQUAL_INT32(0, ciaaPOSIX_memcmp(s1, s2, pos));
+               s2[pos] = s1[pos];
+            }
+         }
+      }
+   }
+}
+
+/** \brief test memchr with all alignments and lengths
+ **
+ ** test the function ciaaPOSIX_memchr with the byte at each position
+ **
+ **/
+void test_ciaaPOSIX_memchrAlignment(void) {
+   uint8_t * buf = (uint8_t *)test_src;
+   uint32_t align;
+   uint32_t length;
+   uint32_t pos;
+
+   /* the bytes of the pattern are different within the buffer */
+   test_fill(buf, 0);
+   for(align = 0; align < TEST_ALIGNMENTS; align++)
+   {
+      for(length = 0; length <= TEST_MAX_LENGTH; length++)
+      {
+         for(pos = 0; pos < length; pos++)
+         {
+            TEST_ASSERT_EQUAL_PTR(&buf[align + pos],
+                  ciaaPOSIX_memchr(&buf[align], buf[align + pos], length));
+         }
+
+         /* the byte after the end shall not be found */
+         TEST_ASSERT_NULL(ciaaPOSIX_memchr(&buf[align],
+                  buf[align + length], length));
+      }
+
+      /* the int is casted to uint8_t */
+      TEST_ASSERT_EQUAL_PTR(&buf[align + 3],
+            ciaaPOSIX_memchr(&buf[align], 0x100 + buf[align + 3], 8));
+   }
+}
+
+/** \brief test strchr with all alignments and lengths
+ **
+ ** test the function ciaaPOSIX_strchr with the char at each position
+ **
+ **/
+void test_ciaaPOSIX_strchrAlignment(void) {
+   char * str = (char *)test_src;
+   uint32_t align;
+   uint32_t length;
+   uint32_t pos;
+
+   for(align = 0; align < TEST_ALIGNMENTS; align++)
+   {
+      for(length = 0; length <= TEST_MAX_LENGTH; length++)
+      {
+         test_fillString(str, 1);
+         str[align + length] = 0;
+
+         for(pos = 0; pos < length; pos++)
+         {
+            TEST_ASSERT_EQUAL_PTR(&str[align + pos],
+                  ciaaPOSIX_strchr(&str[align], str[align + pos]));
+         }
+
+         /* the null termination is found and the chars after it not */
+         TEST_ASSERT_EQUAL_PTR(&str[align + length],
+               ciaaPOSIX_strchr(&str[align], 0));
+         TEST_ASSERT_NULL(ciaaPOSIX_strchr(&str[align],
+                  str[align + length + 1]));
+      }
+   }
+}
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
@@ -46,23 +46,262 @@
 /*==================[inclusions]=============================================*/
 #include "unity.h"
 #include "string.h"
+#include "stdlib.h"
 #include "ciaaSerialDevices.h"
+#include "ciaaPOSIX_stdio.h"
+#include "ciaaPOSIX_errno.h"
 #include "test_ciaaSerialDevices.h"
+#include "mock_ciaaDevices.h"
+#include "mock_ciaaPOSIX_string.h"
+#include "mock_ciaaLibs_CircBuf.h"
+#include "mock_ciaak_main.h"
+#include "mock_os.h"
 
 /*==================[macros and definitions]=================================*/
+/** \brief task notified by the asynchronous requests */
+#define TEST_TASK             2
+
+/** \brief event set by the asynchronous requests */
+#define TEST_EVENT            0x4U
+
+/** \brief alarm of the read timeout */
+#define TEST_ALARM            3
+
+/** \brief ticks of the read timeout */
+#define TEST_TICKS            100
 
 /*==================[internal data declaration]==============================*/
 
 /*==================[internal functions declaration]=========================*/
+static ssize_t test_read(ciaaDevices_deviceType const * const device,
+      uint8_t * const buf, size_t const nbyte);
+
+static ssize_t test_write(ciaaDevices_deviceType const * const device,
+      uint8_t const * const buf, size_t const nbyte);
+
+static int32_t test_ioctl(ciaaDevices_deviceType const * const device,
+      int32_t const request, void * param);
 
 /*==================[internal data definition]===============================*/
+/** \brief driver of the tests */
+static ciaaDevices_deviceType test_driver = {
+   "uart/0",      /* path */
+   NULL,          /* open */
+   NULL,          /* close */
+   test_read,     /* read */
+   test_write,    /* write */
+   test_ioctl,    /* ioctl */
+   NULL,          /* lseek */
+   NULL,          /* upLayer */
+   NULL,          /* layer */
+   NULL,          /* loLayer */
+   NULL,          /* readv */
+   NULL,          /* writev */
+   NULL           /* poll */
+};
+
+/** \brief serial device created for the driver */
+static ciaaDevices_deviceType * test_device;
+
+/** \brief data received by the driver */
+static uint8_t test_rxData[64];
+
+/** \brief count of bytes received by the driver */
+static size_t test_rxCount;
+
+/** \brief data transmitted by the driver */
+static uint8_t test_txData[512];
+
+/** \brief count of bytes transmitted by the driver */
+static size_t test_txCount;
+
+/** \brief control block passed to the last completion callback */
+static ciaaPOSIX_aiocbType * test_completed;
+
+/** \brief an asynchronous read is submitted while the task waits */
+static bool test_submit;
+
+/** \brief return value of the asynchronous read submitted while waiting */
+static int32_t test_submitRet;
+
+/** \brief count of waits of the task */
+static uint32_t test_waits;
 
 /*==================[external data definition]===============================*/
-uint16_t ciaaPOSIX_errno;
+int16_t ciaaPOSIX_errno;
 
 char const * const ciaaPOSIX_assert_msg = \
       "ASSERT Failed in %s:%d in expression %s\n";
 /*==================[internal functions definition]==========================*/
+static ssize_t test_read(ciaaDevices_deviceType const * const device,
+      uint8_t * const buf, size_t const nbyte)
+{
+   size_t count = (nbyte < test_rxCount) ? nbyte : test_rxCount;
+
+   memcpy(buf, test_rxData, count);
+   memmove(test_rxData, &test_rxData[count], test_rxCount - count);
+   test_rxCount -= count;
+
+   return count;
+}
+
+static ssize_t test_write(ciaaDevices_deviceType const * const device,
+      uint8_t const * const buf, size_t const nbyte)
+{
+   memcpy(&test_txData[test_txCount], buf, nbyte);
+   test_txCount += nbyte;
+
+   return nbyte;
+}
+
+static int32_t test_ioctl(ciaaDevices_deviceType const * const device,
+      int32_t const request, void * param)
+{
+   return 0;
+}
+
+static void test_callback(ciaaPOSIX_aiocbType * aiocb)
+{
+   test_completed = aiocb;
+}
+
+static void * test_malloc(size_t size, int cmock_num_calls)
+{
+   return malloc(size);
+}
+
+static size_t test_strlen(char const * s, int cmock_num_calls)
+{
+   return strlen(s);
+}
+
+static char * test_strcat(char * dest, char const * src, int cmock_num_calls)
+{
+   return strcat(dest, src);
+}
+
+static void test_addDevice(ciaaDevices_deviceType * device, int cmock_num_calls)
+{
+   test_device = device;
+}
+
+static int32_t test_circBufInit(ciaaLibs_CircBufType * cbuf, void * buf,
+      size_t nbytes, int cmock_num_calls)
+{
+   cbuf->size = nbytes - 1;
+   cbuf->head = 0;
+   cbuf->tail = 0;
+   cbuf->buf = buf;
+   cbuf->dropped = 0;
+   cbuf->mirrored = 0;
+
+   return 1;
+}
+
+static size_t test_circBufWriteReserve(ciaaLibs_CircBufType * cbuf,
+      ciaaLibs_CircBufSpanType * span, size_t nbytes, int cmock_num_calls)
+{
+   size_t space = ciaaLibs_circBufSpace(cbuf, cbuf->head);
+
+   nbytes = (nbytes < space) ? nbytes : space;
+   space = cbuf->size + 1 - cbuf->tail;
+
+   span->buf[0] = &cbuf->buf[cbuf->tail];
+   span->nbytes[0] = (nbytes < space) ? nbytes : space;
+   span->buf[1] = &cbuf->buf[0];
+   span->nbytes[1] = nbytes - span->nbytes[0];
+
+   return nbytes;
+}
+
+static size_t test_circBufReadReserve(ciaaLibs_CircBufType * cbuf,
+      ciaaLibs_CircBufSpanType * span, size_t nbytes, int cmock_num_calls)
+{
+   size_t count = ciaaLibs_circBufCount(cbuf, cbuf->tail);
+
+   nbytes = (nbytes < count) ? nbytes : count;
+   count = cbuf->size + 1 - cbuf->head;
+
+   span->buf[0] = &cbuf->buf[cbuf->head];
+   span->nbytes[0] = (nbytes < count) ? nbytes : count;
+   span->buf[1] = &cbuf->buf[0];
+   span->nbytes[1] = nbytes - span->nbytes[0];
+
+   return nbytes;
+}
+
+static size_t test_circBufPut(ciaaLibs_CircBufType * cbuf, void const * data,
+      size_t nbytes, int cmock_num_calls)
+{
+   ciaaLibs_CircBufSpanType span;
+   size_t ret = 0;
+
+   if (test_circBufWriteReserve(cbuf, &span, nbytes, 0) == nbytes)
+   {
+      memcpy(span.buf[0], data, span.nbytes[0]);
+      memcpy(span.buf[1], (uint8_t const *)data + span.nbytes[0],
+            span.nbytes[1]);
+      ciaaLibs_circBufWriteCommit(cbuf, nbytes);
+      ret = nbytes;
+   }
+
+   return ret;
+}
+
+static size_t test_circBufGet(ciaaLibs_CircBufType * cbuf, void * data,
+      size_t nbytes, int cmock_num_calls)
+{
+   ciaaLibs_CircBufSpanType span;
+
+   nbytes = test_circBufReadReserve(cbuf, &span, nbytes, 0);
+
+   memcpy(data, span.buf[0], span.nbytes[0]);
+   memcpy((uint8_t *)data + span.nbytes[0], span.buf[1], span.nbytes[1]);
+   ciaaLibs_circBufReadRelease(cbuf, nbytes);
+
+   return nbytes;
+}
+
+static StatusType test_GetTaskID(TaskRefType TaskID, int cmock_num_calls)
+{
+   *TaskID = 1;
+
+   return E_OK;
+}
+
+static StatusType test_WaitEvent(EventMaskType Mask, int cmock_num_calls)
+{
+   static ciaaPOSIX_aiocbType aiocb;
+
+   test_waits++;
+
+   if (test_submit)
+   {
+      test_submitRet = ciaaSerialDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_AIO_READ, &aiocb);
+   }
+
+   /* the data is received while the task waits */
+   ciaaSerialDevices_rxIndication(test_device, test_rxCount);
+
+   return E_OK;
+}
+
+/** \brief prepare a control block of the tests
+ **
+ ** \param[out] aiocb control block
+ ** \param[in] buf buffer of the request
+ ** \param[in] nbytes count of bytes of the request
+ **/
+static void test_aiocbInit(ciaaPOSIX_aiocbType * aiocb, uint8_t * buf,
+      size_t nbytes)
+{
+   aiocb->buf = buf;
+   aiocb->nbytes = nbytes;
+   aiocb->callback = test_callback;
+   aiocb->task = TEST_TASK;
+   aiocb->event = TEST_EVENT;
+}
 
 /*==================[external functions definition]==========================*/
 /** \brief set Up function
@@ -71,10 +310,28 @@ char const * const ciaaPOSIX_assert_msg = \
  **
  **/
 void setUp(void) {
-   /* ignore calls to sem_init */
-   ciaaPOSIX_sem_init_CMockIgnoreAndReturn(1);
+   ciaak_malloc_StubWithCallback(test_malloc);
+   ciaaPOSIX_strlen_StubWithCallback(test_strlen);
+   ciaaPOSIX_strcat_StubWithCallback(test_strcat);
+   ciaaDevices_addDevice_StubWithCallback(test_addDevice);
+   ciaaLibs_circBufInit_StubWithCallback(test_circBufInit);
+   ciaaLibs_circBufWriteReserve_StubWithCallback(test_circBufWriteReserve);
+   ciaaLibs_circBufReadReserve_StubWithCallback(test_circBufReadReserve);
+   ciaaLibs_circBufPut_StubWithCallback(test_circBufPut);
+   ciaaLibs_circBufGet_StubWithCallback(test_circBufGet);
+   GetTaskID_StubWithCallback(test_GetTaskID);
+   WaitEvent_StubWithCallback(test_WaitEvent);
+   ClearEvent_IgnoreAndReturn(E_OK);
+
+   test_rxCount = 0;
+   test_txCount = 0;
+   test_completed = NULL;
+   test_submit = false;
+   test_waits = 0;
+
    /* perform the initialization of ciaa Devices */
    ciaaSerialDevices_init();
+   ciaaSerialDevices_addDriver(&test_driver);
 }
 
 /** \brief tear Down function
@@ -85,10 +342,223 @@ void setUp(void) {
 void tearDown(void) {
 }
 
-/** \brief test POSIX get device before adding one
+/** \brief test an asynchronous read completed by the rx indication
+ **
+ **/
+void testAioReadRxIndication(void) {
+   ciaaPOSIX_aiocbType aiocb;
+   uint8_t buf[8];
+
+   test_aiocbInit(&aiocb, buf, sizeof(buf));
+   TEST_ASSERT_EQUAL_INT32(0, ciaaSerialDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_AIO_READ, &aiocb));
+   TEST_ASSERT_EQUAL_INT32(ciaaPOSIX_AIO_INPROGRESS, aiocb.result);
+   TEST_ASSERT_NULL(test_completed);
+
+   /* the data is received in the ISR */
+   memcpy(test_rxData, "hello", 5);
+   test_rxCount = 5;
+   SetEvent_ExpectAndReturn(TEST_TASK, TEST_EVENT, E_OK);
+   ciaaSerialDevices_rxIndication(test_device, 5);
+
+   TEST_ASSERT_EQUAL_INT32(5, aiocb.result);
+   TEST_ASSERT_TRUE(&aiocb == test_completed);
+   TEST_ASSERT_EQUAL_MEMORY("hello", buf, 5);
+}
+
+/** \brief test asynchronous writes completed by the tx confirmation
+ **
+ **/
+void testAioWriteTxConfirmation(void) {
+   ciaaPOSIX_aiocbType aiocb;
+   uint8_t data[266];
+   size_t loopi;
+
+   for (loopi = 0; loopi < sizeof(data); loopi++)
+   {
+      data[loopi] = (uint8_t)loopi;
+   }
+
+   /* leave space for 5 bytes in the tx buffer */
+   TEST_ASSERT_EQUAL_INT32(250,
+         ciaaSerialDevices_write(test_device, data, 250));
+
+   test_aiocbInit(&aiocb, &data[250], 16);
+   TEST_ASSERT_EQUAL_INT32(0, ciaaSerialDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_AIO_WRITE, &aiocb));
+   TEST_ASSERT_EQUAL_INT32(ciaaPOSIX_AIO_INPROGRESS, aiocb.result);
+
+   /* the first confirmation transmits the full tx buffer */
+   ciaaSerialDevices_txConfirmation(test_device, 0);
+   TEST_ASSERT_EQUAL_INT32(ciaaPOSIX_AIO_INPROGRESS, aiocb.result);
+   TEST_ASSERT_EQUAL_UINT32(255, test_txCount);
+
+   /* the next one stores the rest of the request */
+   SetEvent_ExpectAndReturn(TEST_TASK, TEST_EVENT, E_OK);
+   ciaaSerialDevices_txConfirmation(test_device, 255);
+   TEST_ASSERT_EQUAL_INT32(16, aiocb.result);
+   TEST_ASSERT_TRUE(&aiocb == test_completed);
+   TEST_ASSERT_EQUAL_UINT32(sizeof(data), test_txCount);
+   TEST_ASSERT_EQUAL_MEMORY(data, test_txData, sizeof(data));
+}
+
+/** \brief test cancelling the pending asynchronous reads
+ **
+ **/
+void testAioCancel(void) {
+   ciaaPOSIX_aiocbType aiocb;
+   uint8_t buf[8];
+
+   test_aiocbInit(&aiocb, buf, sizeof(buf));
+   TEST_ASSERT_EQUAL_INT32(0, ciaaSerialDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_AIO_READ, &aiocb));
+
+   SetEvent_ExpectAndReturn(TEST_TASK, TEST_EVENT, E_OK);
+   TEST_ASSERT_EQUAL_INT32(0, ciaaSerialDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_AIO_READ, NULL));
+   TEST_ASSERT_EQUAL_INT32(-1, aiocb.result);
+   TEST_ASSERT_TRUE(&aiocb == test_completed);
+
+   /* the data received afterwards stays in the rx buffer */
+   memcpy(test_rxData, "hi", 2);
+   test_rxCount = 2;
+   ciaaSerialDevices_rxIndication(test_device, 2);
+   TEST_ASSERT_EQUAL_INT32(2, ciaaSerialDevices_read(test_device, buf, sizeof(buf)));
+}
+
+/** \brief test that blocking reads and asynchronous reads exclude each other
  **
  **/
-void testTODO(void) {
+void testAioReadBusy(void) {
+   ciaaPOSIX_aiocbType aiocb;
+   uint8_t buf[8];
+
+   test_aiocbInit(&aiocb, buf, sizeof(buf));
+   aiocb.event = 0;
+   TEST_ASSERT_EQUAL_INT32(0, ciaaSerialDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_AIO_READ, &aiocb));
+
+   /* the rx buffer belongs to the pending asynchronous read */
+   ciaaPOSIX_errno = 0;
+   TEST_ASSERT_EQUAL_INT32(-1,
+         ciaaSerialDevices_read(test_device, buf, sizeof(buf)));
+   TEST_ASSERT_EQUAL_INT16(EBUSY, ciaaPOSIX_errno);
+
+   TEST_ASSERT_EQUAL_INT32(0, ciaaSerialDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_AIO_READ, NULL));
+
+   /* an asynchronous read is rejected while a task waits in read */
+   memcpy(test_rxData, "hi", 2);
+   test_rxCount = 2;
+   test_submit = true;
+   SetEvent_ExpectAndReturn(1, POSIXE, E_OK);
+   TEST_ASSERT_EQUAL_INT32(2,
+         ciaaSerialDevices_read(test_device, buf, sizeof(buf)));
+   TEST_ASSERT_EQUAL_INT32(-1, test_submitRet);
+   TEST_ASSERT_EQUAL_INT16(EBUSY, ciaaPOSIX_errno);
+}
+
+/** \brief test that blocking writes are rejected while asynchronous writes
+ **        are pending
+ **
+ **/
+void testAioWriteBusy(void) {
+   ciaaPOSIX_aiocbType aiocb;
+   ciaaPOSIX_iovecType iov[1];
+   uint8_t data[16] = { 0 };
+
+   /* fill the tx buffer, the asynchronous write stays pending */
+   test_aiocbInit(&aiocb, data, sizeof(data));
+   aiocb.event = 0;
+   TEST_ASSERT_EQUAL_INT32(255, ciaaSerialDevices_write(test_device,
+            test_txData, 255));
+   TEST_ASSERT_EQUAL_INT32(0, ciaaSerialDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_AIO_WRITE, &aiocb));
+
+   ciaaPOSIX_errno = 0;
+   TEST_ASSERT_EQUAL_INT32(-1,
+         ciaaSerialDevices_write(test_device, data, sizeof(data)));
+   TEST_ASSERT_EQUAL_INT16(EBUSY, ciaaPOSIX_errno);
+
+   iov[0].iov_base = data;
+   iov[0].iov_len = sizeof(data);
+   ciaaPOSIX_errno = 0;
+   TEST_ASSERT_EQUAL_INT32(-1,
+         ciaaSerialDevices_writev(test_device, iov, 1));
+   TEST_ASSERT_EQUAL_INT16(EBUSY, ciaaPOSIX_errno);
+
+   /* nothing but the first write has been stored */
+   ciaaSerialDevices_txConfirmation(test_device, 0);
+   TEST_ASSERT_EQUAL_UINT32(255, test_txCount);
+}
+
+/** \brief test a blocking read which times out
+ **
+ **/
+void testReadTimeout(void) {
+   ciaaPOSIX_timeoutType timeout = { TEST_ALARM, TEST_TICKS };
+   uint8_t buf[8];
+
+   TEST_ASSERT_EQUAL_INT32(0, ciaaSerialDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_SET_TIMEOUT, &timeout));
+
+   SetRelAlarm_ExpectAndReturn(TEST_ALARM, TEST_TICKS, 0, E_OK);
+   CancelAlarm_ExpectAndReturn(TEST_ALARM, E_OS_NOFUNC);
+
+   ciaaPOSIX_errno = 0;
+   TEST_ASSERT_EQUAL_INT32(-1,
+         ciaaSerialDevices_read(test_device, buf, sizeof(buf)));
+   TEST_ASSERT_EQUAL_INT16(ETIMEDOUT, ciaaPOSIX_errno);
+   TEST_ASSERT_EQUAL_UINT32(1, test_waits);
+
+   /* the data received later is kept for the next read */
+   memcpy(test_rxData, "hi", 2);
+   test_rxCount = 2;
+   ciaaSerialDevices_rxIndication(test_device, 2);
+   TEST_ASSERT_EQUAL_INT32(2,
+         ciaaSerialDevices_read(test_device, buf, sizeof(buf)));
+   TEST_ASSERT_EQUAL_MEMORY("hi", buf, 2);
+}
+
+/** \brief test a blocking read which receives data before the timeout
+ **
+ **/
+void testReadBeforeTimeout(void) {
+   ciaaPOSIX_timeoutType timeout = { TEST_ALARM, TEST_TICKS };
+   uint8_t buf[8];
+
+   TEST_ASSERT_EQUAL_INT32(0, ciaaSerialDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_SET_TIMEOUT, &timeout));
+
+   memcpy(test_rxData, "hello", 5);
+   test_rxCount = 5;
+   SetRelAlarm_ExpectAndReturn(TEST_ALARM, TEST_TICKS, 0, E_OK);
+   SetEvent_ExpectAndReturn(1, POSIXE, E_OK);
+   CancelAlarm_ExpectAndReturn(TEST_ALARM, E_OK);
+
+   TEST_ASSERT_EQUAL_INT32(5,
+         ciaaSerialDevices_read(test_device, buf, sizeof(buf)));
+   TEST_ASSERT_EQUAL_MEMORY("hello", buf, 5);
+}
+
+/** \brief test a blocking read whose alarm is already in use
+ **
+ **/
+void testReadAlarmInUse(void) {
+   ciaaPOSIX_timeoutType timeout = { TEST_ALARM, TEST_TICKS };
+   uint8_t buf[8];
+
+   TEST_ASSERT_EQUAL_INT32(0, ciaaSerialDevices_ioctl(test_device,
+            ciaaPOSIX_IOCTL_SET_TIMEOUT, &timeout));
+
+   /* the data is not awaited and the alarm is not cancelled */
+   SetRelAlarm_ExpectAndReturn(TEST_ALARM, TEST_TICKS, 0, E_OS_STATE);
+
+   ciaaPOSIX_errno = 0;
+   TEST_ASSERT_EQUAL_INT32(-1,
+         ciaaSerialDevices_read(test_device, buf, sizeof(buf)));
+   TEST_ASSERT_EQUAL_INT16(EBUSY, ciaaPOSIX_errno);
+   TEST_ASSERT_EQUAL_UINT32(0, test_waits);
 }
 
 /** @} doxygen end group definition */